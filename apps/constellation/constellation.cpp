@@ -31,6 +31,8 @@
 #include "ledger/tx_query_http_interface.hpp"
 #include "ledger/tx_status_http_interface.hpp"
 #include "logging_http_module.hpp"
+#include "miner/annealer_miner.hpp"
+#include "miner/basic_miner.hpp"
 #include "muddle/rpc/client.hpp"
 #include "muddle/rpc/server.hpp"
 #include "muddle_status_http_module.hpp"
@@ -72,6 +74,7 @@ namespace fetch {
 namespace {
 
 using BeaconServicePtr = std::shared_ptr<fetch::beacon::BeaconService>;
+using BlockPackerPtr   = std::unique_ptr<ledger::BlockPackerInterface>;
 using CertificatePtr   = Constellation::CertificatePtr;
 using Config           = Constellation::Config;
 using ConsensusPtr     = Constellation::ConsensusPtr;
@@ -149,11 +152,14 @@ ledger::ShardConfigs GenerateShardsConfig(Config &cfg, uint16_t start_port)
     shard.external_port     = start_port++;
     shard.external_network_id =
         muddle::NetworkId{(static_cast<uint32_t>(i) & 0xFFFFFFu) | (uint32_t{'L'} << 24u)};
-    shard.internal_name        = it->second.uri().GetTcpPeer().address();
-    shard.internal_identity    = std::make_shared<crypto::ECDSASigner>();
-    shard.internal_port        = start_port++;
-    shard.internal_network_id  = muddle::NetworkId{"ISRD"};
-    shard.verification_threads = cfg.verification_threads;
+    shard.internal_name            = it->second.uri().GetTcpPeer().address();
+    shard.internal_identity        = std::make_shared<crypto::ECDSASigner>();
+    shard.internal_port            = start_port++;
+    shard.internal_network_id      = muddle::NetworkId{"ISRD"};
+    shard.verification_threads     = cfg.verification_threads;
+    shard.state_snapshot_interval  = cfg.snapshot_interval;
+    shard.state_snapshot_retention = cfg.snapshot_retention;
+    shard.state_cache_size         = cfg.state_cache_size;
 
     auto const ext_identity = shard.external_identity->identity().identifier();
     auto const int_identity = shard.internal_identity->identity().identifier();
@@ -183,6 +189,24 @@ StakeManagerPtr CreateStakeManager(Constellation::Config const &cfg)
   return mgr;
 }
 
+BlockPackerPtr CreateBlockPacker(Constellation::Config const &cfg)
+{
+  BlockPackerPtr packer{};
+
+  switch (cfg.block_packer)
+  {
+  case Constellation::BlockPacker::ANNEALER:
+    packer = std::make_unique<miner::AnnealerMiner>(
+        cfg.log2_num_lanes, std::chrono::milliseconds{cfg.block_packer_budget_ms});
+    break;
+  case Constellation::BlockPacker::BASIC:
+    packer = std::make_unique<miner::BasicMiner>(cfg.log2_num_lanes);
+    break;
+  }
+
+  return packer;
+}
+
 ConsensusPtr CreateConsensus(Constellation::Config const &cfg, StakeManagerPtr stake,
                              BeaconServicePtr beacon, MainChain const &chain,
                              Identity const &identity)
@@ -278,12 +302,12 @@ Constellation::Constellation(CertificatePtr certificate, Config config)
         tx_status_cache_)}
   , chain_{cfg_.features.IsEnabled(FeatureFlags::MAIN_CHAIN_BLOOM_FILTER),
            ledger::MainChain::Mode::LOAD_PERSISTENT_DB}
-  , block_packer_{cfg_.log2_num_lanes}
+  , block_packer_{CreateBlockPacker(cfg_)}
   , block_coordinator_{chain_,
                        dag_,
                        *execution_manager_,
                        *storage_,
-                       block_packer_,
+                       *block_packer_,
                        *this,
                        certificate,
                        cfg_.num_lanes(),
@@ -292,12 +316,12 @@ Constellation::Constellation(CertificatePtr certificate, Config config)
                        consensus_}
   , main_chain_service_{std::make_shared<MainChainRpcService>(muddle_->GetEndpoint(), chain_,
                                                               trust_, cfg_.network_mode)}
-  , tx_processor_{dag_, *storage_, block_packer_, tx_status_cache_, cfg_.processor_threads}
+  , tx_processor_{dag_, *storage_, *block_packer_, tx_status_cache_, cfg_.processor_threads}
   , http_open_api_module_{std::make_shared<OpenAPIHttpModule>()}
   , http_{http_network_manager_}
   , http_modules_{http_open_api_module_,
                   std::make_shared<p2p::P2PHttpInterface>(
-                      cfg_.log2_num_lanes, chain_, block_packer_,
+                      cfg_.log2_num_lanes, chain_, *block_packer_,
                       p2p::P2PHttpInterface::WeakStateMachines{
                           main_chain_service_->GetWeakStateMachine(),
                           block_coordinator_.GetWeakStateMachine()}),
@@ -335,6 +359,11 @@ Constellation::Constellation(CertificatePtr certificate, Config config)
   dag_service_ = std::make_shared<ledger::DAGService>(muddle_->GetEndpoint(), dag_);
   reactor_.Attach(dag_service_->GetWeakRunnable());
 
+  execution_manager_->SetOptimisticExecution(
+      cfg_.features.IsEnabled(FeatureFlags::OPTIMISTIC_EXECUTION));
+  block_coordinator_.EnablePipelining(
+      cfg_.features.IsEnabled(FeatureFlags::PIPELINED_EXECUTION));
+
   if (cfg_.features.IsEnabled("synergetic"))
   {
     auto syn_miner = std::make_unique<NaiveSynergeticMiner>(dag_, *storage_, certificate);
@@ -21,6 +21,7 @@
 #include "core/reactor.hpp"
 #include "http/module.hpp"
 #include "http/server.hpp"
+#include "ledger/block_packer_interface.hpp"
 #include "ledger/block_sink_interface.hpp"
 #include "ledger/chain/block_coordinator.hpp"
 #include "ledger/chain/consensus/consensus_miner_interface.hpp"
@@ -39,7 +40,6 @@
 #include "ledger/storage_unit/storage_unit_client.hpp"
 #include "ledger/transaction_processor.hpp"
 #include "ledger/transaction_status_cache.hpp"
-#include "miner/basic_miner.hpp"
 #include "muddle/muddle_interface.hpp"
 #include "network/p2pservice/p2ptrust_bayrank.hpp"
 #include "open_api_http_module.hpp"
@@ -75,15 +75,26 @@ public:
   static constexpr uint32_t    DEFAULT_BLOCK_DIFFICULTY = 6;
   static constexpr char const *LOGGING_NAME             = "constellation";
 
+  enum class BlockPacker
+  {
+    BASIC,     ///< Greedy packing of the highest fee transactions
+    ANNEALER,  ///< Simulated annealing search within a time budget
+  };
+
   struct Config
   {
     Manifest     manifest{};
     uint32_t     log2_num_lanes{0};
     uint32_t     num_slices{0};
     uint32_t     num_executors{0};
+    BlockPacker  block_packer{BlockPacker::BASIC};
+    uint32_t     block_packer_budget_ms{0};
     std::string  db_prefix{};
     uint32_t     processor_threads{0};
     uint32_t     verification_threads{0};
+    uint64_t     snapshot_interval{0};
+    uint64_t     snapshot_retention{0};
+    uint64_t     state_cache_size{0};
     uint32_t     max_peers{0};
     uint32_t     transient_peers{0};
     uint32_t     block_interval_ms{0};
@@ -121,7 +132,7 @@ protected:
 private:
   using MuddlePtr              = muddle::MuddlePtr;
   using NetworkManager         = network::NetworkManager;
-  using BlockPackingAlgorithm  = miner::BasicMiner;
+  using BlockPackerPtr         = std::unique_ptr<ledger::BlockPackerInterface>;
   using BlockCoordinator       = ledger::BlockCoordinator;
   using MainChain              = ledger::MainChain;
   using MainChainRpcService    = ledger::MainChainRpcService;
@@ -203,9 +214,9 @@ private:
 
   /// @name Blockchain and Mining
   /// @[
-  MainChain             chain_;              ///< The main block chain component
-  BlockPackingAlgorithm block_packer_;       ///< The block packing / mining algorithm
-  BlockCoordinator      block_coordinator_;  ///< The block execution coordinator
+  MainChain        chain_;              ///< The main block chain component
+  BlockPackerPtr   block_packer_;       ///< The block packing / mining algorithm
+  BlockCoordinator block_coordinator_;  ///< The block execution coordinator
   /// @}
 
   /// @name Top Level Services
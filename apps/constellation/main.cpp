@@ -216,6 +216,11 @@ int main(int argc, char **argv)
     }
     else
     {
+      if (settings.async_logging.value())
+      {
+        fetch::SetLogMode(fetch::LogMode::ASYNCHRONOUS);
+      }
+
       FETCH_LOG_INFO(LOGGING_NAME, "Input Configuration:\n", settings);
 
       // create and load the main certificate for the bootstrapper
@@ -256,5 +261,8 @@ int main(int argc, char **argv)
     std::cerr << "Fatal Error: " << ex.what() << std::endl;
   }
 
+  // ensure all the queued log messages have been written before exiting
+  fetch::SetLogMode(fetch::LogMode::SYNCHRONOUS);
+
   return exit_code;
 }
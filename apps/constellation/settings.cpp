@@ -29,16 +29,18 @@
 namespace fetch {
 namespace {
 
-const uint32_t DEFAULT_NUM_LANES          = 1;
-const uint32_t DEFAULT_NUM_SLICES         = 500;
-const uint32_t DEFAULT_NUM_EXECUTORS      = DEFAULT_NUM_LANES;
-const uint16_t DEFAULT_PORT               = 8000;
-const uint32_t DEFAULT_BLOCK_INTERVAL     = 0;  // milliseconds - zero means no mining
-const uint32_t DEFAULT_COMMITTEE_SIZE     = 10;
-const uint32_t DEFAULT_STAKE_DELAY_PERIOD = 5;
-const uint32_t DEFAULT_AEON_PERIOD        = 100;
-const uint32_t DEFAULT_MAX_PEERS          = 3;
-const uint32_t DEFAULT_TRANSIENT_PEERS    = 1;
+const uint32_t DEFAULT_NUM_LANES           = 1;
+const uint32_t DEFAULT_NUM_SLICES          = 500;
+const uint32_t DEFAULT_NUM_EXECUTORS       = DEFAULT_NUM_LANES;
+const uint16_t DEFAULT_PORT                = 8000;
+const uint32_t DEFAULT_BLOCK_INTERVAL      = 0;  // milliseconds - zero means no mining
+const uint32_t DEFAULT_COMMITTEE_SIZE      = 10;
+const uint32_t DEFAULT_STAKE_DELAY_PERIOD  = 5;
+const uint32_t DEFAULT_AEON_PERIOD         = 100;
+const uint32_t DEFAULT_MAX_PEERS           = 3;
+const uint32_t DEFAULT_TRANSIENT_PEERS     = 1;
+const uint32_t DEFAULT_BLOCK_PACKER_BUDGET = 200;  // milliseconds
+const uint64_t DEFAULT_STATE_CACHE_MB      = 16;
 const uint32_t NUM_SYSTEM_THREADS = static_cast<uint32_t>(std::thread::hardware_concurrency());
 
 }  // namespace
@@ -54,6 +56,9 @@ Settings::Settings()
   , standalone            {*this, "standalone",              false,                        "Signal the network should run in standalone mode"}
   , private_network       {*this, "private-network",         false,                        "Signal the network should run as part of a private network"}
   , db_prefix             {*this, "db-prefix",               "node_storage",               "The prefix for filenames related to constellation databases"}
+  , snapshot_interval     {*this, "snapshot-interval",       0,                            "The number of blocks between lane state snapshots (0 to disable)"}
+  , snapshot_retention    {*this, "snapshot-retention",      0,                            "The number of lane state snapshots to retain, older state history is discarded (0 to retain all)"}
+  , state_cache_size      {*this, "state-cache-mb",          DEFAULT_STATE_CACHE_MB,       "The size of the page cache of each lane state file in megabytes (0 to access the files directly)"}
   , port                  {*this, "port",                    DEFAULT_PORT,                 "The starting port for ledger services"}
   , peers                 {*this, "peers",                   {},                           "The comma separated list of addresses to initially connect to"}
   , external              {*this, "external",                "127.0.0.1",                  "This node's global IP address or hostname"}
@@ -71,6 +76,8 @@ Settings::Settings()
   , num_processor_threads {*this, "processor-threads",       NUM_SYSTEM_THREADS,           "The number of processor threads"}
   , num_verifier_threads  {*this, "verifier-threads",        NUM_SYSTEM_THREADS,           "The number of verifier threads"}
   , num_executors         {*this, "executors",               DEFAULT_NUM_EXECUTORS,        "The number of transaction executors"}
+  , block_packer          {*this, "block-packer",            "basic",                      "The block packing algorithm to be used (basic or annealer)"}
+  , block_packer_budget   {*this, "block-packer-budget-ms",  DEFAULT_BLOCK_PACKER_BUDGET,  "The time budget for packing a block in milliseconds (annealer only)"}
   , load_genesis_file     {*this, "load-genesis-file",       false,                        "Specify the contents of the genesis block"}
   , genesis_file_location {*this, "genesis-file-location",   "",                           "Path to the genesis file (usually genesis_file.json)"}
   , experimental_features {*this, "experimental",            {},                           "The comma separated set of experimental features to enable"}
@@ -78,6 +85,7 @@ Settings::Settings()
   , max_committee_size    {*this, "max-committee-size",      DEFAULT_COMMITTEE_SIZE,       ""}
   , stake_delay_period    {*this, "stake-delay-period",      DEFAULT_STAKE_DELAY_PERIOD,   ""}
   , aeon_period           {*this, "aeon-period",             DEFAULT_AEON_PERIOD,          ""}
+  , async_logging         {*this, "async-logging",           false,                        "Write log messages from a background thread, dropping low priority messages when overloaded"}
 {}
 // clang-format on
 
@@ -156,6 +164,13 @@ bool Settings::Validate()
     valid = false;
   }
 
+  // block packer checks
+  if ((block_packer.value() != "basic") && (block_packer.value() != "annealer"))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "The block packer must be one of: basic, annealer");
+    valid = false;
+  }
+
   return valid;
 }
 
@@ -60,6 +60,9 @@ public:
   /// @name Shards
   /// @{
   settings::Setting<std::string> db_prefix;
+  settings::Setting<uint64_t>    snapshot_interval;
+  settings::Setting<uint64_t>    snapshot_retention;
+  settings::Setting<uint64_t>    state_cache_size;
   /// @}
 
   /// @name Networking / P2P Manifest
@@ -91,6 +94,12 @@ public:
   settings::Setting<uint32_t> num_executors;
   /// @}
 
+  /// @name Block Packing
+  /// @{
+  settings::Setting<std::string> block_packer;
+  settings::Setting<uint32_t>    block_packer_budget;
+  /// @}
+
   /// @name State File
   /// @{
   settings::Setting<bool>        load_genesis_file;
@@ -110,6 +119,11 @@ public:
   settings::Setting<uint64_t> aeon_period;
   /// @}
 
+  /// @name Logging
+  /// @{
+  settings::Setting<bool> async_logging;
+  /// @}
+
   // Operators
   Settings &operator=(Settings const &) = delete;
   Settings &operator=(Settings &&) = delete;
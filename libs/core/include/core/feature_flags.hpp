@@ -32,6 +32,8 @@ class FeatureFlags
 {
 public:
   constexpr static char const *MAIN_CHAIN_BLOOM_FILTER = "main_chain_bloom_filter";
+  constexpr static char const *OPTIMISTIC_EXECUTION    = "optimistic_execution";
+  constexpr static char const *PIPELINED_EXECUTION     = "pipelined_execution";
 
   using ConstByteArray = byte_array::ConstByteArray;
   using FlagSet        = std::unordered_set<ConstByteArray>;
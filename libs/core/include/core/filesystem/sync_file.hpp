@@ -0,0 +1,41 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+namespace fetch {
+namespace core {
+
+/**
+ * Ensure the contents of a file (or directory) which have been written have reached the disk
+ *
+ * @param filename The path of the file
+ * @return true if successful, otherwise false
+ */
+bool SyncFile(char const *filename);
+
+/**
+ * Ensure the entries of the directory containing a file have reached the disk, for example after
+ * the file has been created or renamed
+ *
+ * @param filename The path of the file
+ * @return true if successful, otherwise false
+ */
+bool SyncParentDirectory(char const *filename);
+
+}  // namespace core
+}  // namespace fetch
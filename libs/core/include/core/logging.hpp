@@ -17,6 +17,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include <cstdint>
 #include <ostream>
 #include <sstream>
 #include <string>
@@ -72,6 +73,17 @@ enum class LogLevel
   CRITICAL,
 };
 
+/**
+ * In the synchronous mode messages are written to the log sinks by the calling thread. In the
+ * asynchronous mode messages are placed into a bounded queue and written by a background thread.
+ * In both modes the messages are formatted by the calling thread.
+ */
+enum class LogMode
+{
+  SYNCHRONOUS,
+  ASYNCHRONOUS,
+};
+
 using LogLevelMap = std::unordered_map<std::string, LogLevel>;
 
 /// @name Log Library Functions
@@ -103,6 +115,27 @@ void Log(LogLevel level, char const *name, std::string &&message);
  */
 LogLevelMap GetLogLevelMap();
 
+/**
+ * Configure how log messages are written to the log sinks
+ *
+ * When switching back to the synchronous mode any queued messages are written first
+ *
+ * @param mode The mode to be used
+ */
+void SetLogMode(LogMode mode);
+
+/**
+ * Block until all the queued log messages have been written
+ */
+void FlushLogs();
+
+/**
+ * Get the number of messages that have been dropped because the asynchronous log queue was full
+ *
+ * @return The number of dropped messages
+ */
+uint64_t GetDroppedLogMessageCount();
+
 /// @}
 
 /// @name Helper Wrappers
@@ -0,0 +1,56 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/filesystem/sync_file.hpp"
+
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+
+namespace fetch {
+namespace core {
+
+bool SyncFile(char const *filename)
+{
+  int const fd = ::open(filename, O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+
+  bool const success = (::fsync(fd) == 0);
+  ::close(fd);
+
+  return success;
+}
+
+bool SyncParentDirectory(char const *filename)
+{
+  std::string const path{filename};
+
+  auto const separator = path.find_last_of('/');
+  if (separator == std::string::npos)
+  {
+    return SyncFile(".");
+  }
+
+  return SyncFile((separator == 0) ? "/" : path.substr(0, separator).c_str());
+}
+
+}  // namespace core
+}  // namespace fetch
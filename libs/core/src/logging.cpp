@@ -43,7 +43,17 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "core/fetch_backward.hpp"
 
@@ -59,6 +69,134 @@ backward::SignalHandling         sh([](std::string const &fatal_msg) {
 namespace fetch {
 namespace {
 
+/**
+ * Bounded, lock free, multiple producer / single consumer queue of log messages.
+ *
+ * Each slot carries a sequence number which signals if the slot is free to be written by the
+ * producer with the matching write index, or is ready to be read by the consumer. The messages are
+ * formatted by the caller, the queue only takes ownership of the formatted string, avoiding a copy.
+ */
+class LogQueue
+{
+public:
+  struct Entry
+  {
+    LogLevel    level{LogLevel::INFO};
+    std::string name;
+    std::string message;
+  };
+
+  // Construction / Destruction
+  explicit LogQueue(std::size_t capacity);
+  LogQueue(LogQueue const &) = delete;
+  LogQueue(LogQueue &&)      = delete;
+  ~LogQueue()                = default;
+
+  bool TryPush(LogLevel level, char const *name, std::string &&message);
+  bool TryPop(Entry &entry);
+
+  // Operators
+  LogQueue &operator=(LogQueue const &) = delete;
+  LogQueue &operator=(LogQueue &&) = delete;
+
+private:
+  struct Slot
+  {
+    std::atomic<std::size_t> sequence{0};
+    Entry                    entry;
+  };
+
+  using Slots = std::vector<Slot>;
+
+  std::size_t const        mask_;
+  Slots                    slots_;
+  std::atomic<std::size_t> write_index_{0};
+  std::size_t              read_index_{0};  ///< Only accessed by the consumer
+};
+
+LogQueue::LogQueue(std::size_t capacity)
+  : mask_{capacity - 1}
+  , slots_(capacity)
+{
+  assert((capacity & mask_) == 0);
+
+  for (std::size_t i = 0; i < capacity; ++i)
+  {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * Attempt to add a message to the queue
+ *
+ * @param level The level of the message
+ * @param name The name of the origin
+ * @param message The message
+ * @return true if successful, false if the queue was full
+ */
+bool LogQueue::TryPush(LogLevel level, char const *name, std::string &&message)
+{
+  std::size_t index = write_index_.load(std::memory_order_relaxed);
+
+  for (;;)
+  {
+    auto &slot = slots_[index & mask_];
+
+    std::size_t const sequence = slot.sequence.load(std::memory_order_acquire);
+    auto const        diff     = static_cast<std::ptrdiff_t>(sequence - index);
+
+    if (diff == 0)
+    {
+      // the slot is free, attempt to claim it
+      if (write_index_.compare_exchange_weak(index, index + 1, std::memory_order_relaxed))
+      {
+        slot.entry.level = level;
+        slot.entry.name.assign(name);
+        slot.entry.message = std::move(message);
+
+        slot.sequence.store(index + 1, std::memory_order_release);
+        return true;
+      }
+    }
+    else if (diff < 0)
+    {
+      // the queue is full
+      return false;
+    }
+    else
+    {
+      // another producer has claimed the slot
+      index = write_index_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+/**
+ * Attempt to remove a message from the queue. Must only be called by a single consumer at a time
+ *
+ * @param entry The entry to be populated
+ * @return true if successful, false if the queue was empty
+ */
+bool LogQueue::TryPop(Entry &entry)
+{
+  auto &slot = slots_[read_index_ & mask_];
+
+  std::size_t const sequence = slot.sequence.load(std::memory_order_acquire);
+  if (sequence != (read_index_ + 1))
+  {
+    return false;
+  }
+
+  entry.level = slot.entry.level;
+  entry.name.swap(slot.entry.name);
+  entry.message.swap(slot.entry.message);
+
+  slot.sequence.store(read_index_ + mask_ + 1, std::memory_order_release);
+  ++read_index_;
+
+  return true;
+}
+
 class LogRegistry
 {
 public:
@@ -66,11 +204,18 @@ public:
   LogRegistry();
   LogRegistry(LogRegistry const &) = delete;
   LogRegistry(LogRegistry &&)      = delete;
-  ~LogRegistry()                   = default;
+  ~LogRegistry();
 
   void Log(LogLevel level, char const *name, std::string &&message);
   void SetLevel(char const *name, LogLevel level);
   void SetGlobalLevel(LogLevel level);
+  void SetMode(LogMode mode);
+  void Flush();
+
+  uint64_t dropped_count() const
+  {
+    return dropped_count_;
+  }
 
   LogLevelMap GetLogLevelMap();
 
@@ -89,13 +234,30 @@ private:
   using Registry   = std::unordered_map<std::string, LoggerPtr>;
   using Mutex      = std::mutex;
   using CounterPtr = telemetry::CounterPtr;
+  using ThreadPtr  = std::unique_ptr<std::thread>;
+
+  static constexpr std::size_t QUEUE_CAPACITY = 1u << 14u;
 
   Logger &GetLogger(char const *name);
+  void    Write(LogLevel level, char const *name, std::string const &message);
+  void    Drain();
+  void    BackgroundWriter();
+  void    StopBackgroundWriter();
 
   Mutex                 lock_;
   Registry              registry_;
   std::atomic<LogLevel> global_level_{LogLevel::TRACE};
 
+  // Asynchronous mode
+  LogQueue                 queue_{QUEUE_CAPACITY};
+  Mutex                    consumer_lock_;  ///< Ensures a single consumer of the queue
+  Mutex                    mode_lock_;
+  std::condition_variable  mode_condition_;
+  std::atomic<bool>        async_{false};
+  std::atomic<std::size_t> active_producers_{0};  ///< Producers that may be pushing to the queue
+  std::atomic<uint64_t>    dropped_count_{0};
+  ThreadPtr                writer_thread_;
+
   // Telemetry
   CounterPtr log_messages_{telemetry::Registry::Instance().CreateCounter(
       "ledger_log_messages_total", "The number of log messages printed")};
@@ -111,6 +273,9 @@ private:
       "ledger_log_error_messages_total", "The number of error log messages printed")};
   CounterPtr log_critical_messages_{telemetry::Registry::Instance().CreateCounter(
       "ledger_log_critical_messages_total", "The number of critical log messages printed")};
+  CounterPtr log_dropped_messages_{telemetry::Registry::Instance().CreateCounter(
+      "ledger_log_dropped_messages_total",
+      "The number of log messages dropped because the log queue was full")};
 };
 
 constexpr LogLevel DEFAULT_LEVEL = LogLevel::INFO;
@@ -180,6 +345,11 @@ spdlog::level::level_enum ConvertFromLevel(LogLevel level)
 
 LogRegistry::LogRegistry() = default;
 
+LogRegistry::~LogRegistry()
+{
+  StopBackgroundWriter();
+}
+
 void LogRegistry::Log(LogLevel level, char const *name, std::string &&message)
 {
   if (level < global_level_)
@@ -187,6 +357,135 @@ void LogRegistry::Log(LogLevel level, char const *name, std::string &&message)
     return;
   }
 
+  if (async_)
+  {
+    // the producer is registered before the mode is checked again, which guarantees that the
+    // final drain when switching back to the synchronous mode will see the pushed message
+    ++active_producers_;
+    bool const pushed = async_ && queue_.TryPush(level, name, std::move(message));
+    --active_producers_;
+
+    if (pushed)
+    {
+      return;
+    }
+
+    // When the queue is full, errors are still written (synchronously) so that they are never
+    // lost, all other messages are dropped
+    if (async_ && (level < LogLevel::ERROR))
+    {
+      ++dropped_count_;
+      log_dropped_messages_->increment();
+      return;
+    }
+  }
+
+  Write(level, name, message);
+}
+
+/**
+ * Configure how the log messages are written to the sinks
+ *
+ * @param mode The mode to be used
+ */
+void LogRegistry::SetMode(LogMode mode)
+{
+  if (mode == LogMode::ASYNCHRONOUS)
+  {
+    FETCH_LOCK(mode_lock_);
+
+    if (!writer_thread_)
+    {
+      async_         = true;
+      writer_thread_ = std::make_unique<std::thread>([this]() { BackgroundWriter(); });
+    }
+  }
+  else
+  {
+    StopBackgroundWriter();
+  }
+}
+
+/**
+ * Write all the messages which are currently in the queue
+ */
+void LogRegistry::Flush()
+{
+  Drain();
+}
+
+/**
+ * Internal: Write all the messages in the queue to the sinks
+ */
+void LogRegistry::Drain()
+{
+  FETCH_LOCK(consumer_lock_);
+
+  LogQueue::Entry entry{};
+  while (queue_.TryPop(entry))
+  {
+    Write(entry.level, entry.name.c_str(), entry.message);
+  }
+}
+
+/**
+ * Internal: The main loop of the background writer thread
+ */
+void LogRegistry::BackgroundWriter()
+{
+  static constexpr std::chrono::milliseconds POLL_INTERVAL{5};
+
+  std::unique_lock<Mutex> lock{mode_lock_};
+  while (async_)
+  {
+    lock.unlock();
+    Drain();
+    lock.lock();
+
+    // producers do not signal the writer, it simply polls the queue
+    mode_condition_.wait_for(lock, POLL_INTERVAL);
+  }
+}
+
+/**
+ * Internal: Stop the background writer (if running) and write any remaining queued messages
+ */
+void LogRegistry::StopBackgroundWriter()
+{
+  ThreadPtr thread{};
+
+  {
+    FETCH_LOCK(mode_lock_);
+
+    async_ = false;
+    thread = std::move(writer_thread_);
+  }
+
+  if (thread)
+  {
+    mode_condition_.notify_all();
+    thread->join();
+  }
+
+  // wait for any producer which saw the asynchronous mode to finish pushing its message
+  while (active_producers_ != 0)
+  {
+    std::this_thread::yield();
+  }
+
+  // messages could still have been added between the last drain and the mode change
+  Drain();
+}
+
+/**
+ * Internal: Write a message to the sinks and update the telemetry
+ *
+ * @param level The level of the message
+ * @param name The name of the origin
+ * @param message The message
+ */
+void LogRegistry::Write(LogLevel level, char const *name, std::string const &message)
+{
   {
     FETCH_LOCK(lock_);
     GetLogger(name).log(ConvertFromLevel(level), message);
@@ -302,4 +601,19 @@ LogLevelMap GetLogLevelMap()
   return registry.GetLogLevelMap();
 }
 
+void SetLogMode(LogMode mode)
+{
+  registry.SetMode(mode);
+}
+
+void FlushLogs()
+{
+  registry.Flush();
+}
+
+uint64_t GetDroppedLogMessageCount()
+{
+  return registry.dropped_count();
+}
+
 }  // namespace fetch
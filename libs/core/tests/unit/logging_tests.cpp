@@ -0,0 +1,216 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/logging.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fcntl.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+using namespace fetch;
+using namespace std::chrono_literals;
+
+constexpr char const *LOGGING_NAME = "LoggingTests";
+
+TEST(LoggingTests, CheckAsynchronousMessagesAreWrittenWithoutDrops)
+{
+  static constexpr std::size_t NUM_THREADS         = 4;
+  static constexpr std::size_t MESSAGES_PER_THREAD = 25;
+
+  auto const dropped = GetDroppedLogMessageCount();
+
+  SetLogMode(LogMode::ASYNCHRONOUS);
+
+  std::vector<std::thread> threads{};
+  for (std::size_t i = 0; i < NUM_THREADS; ++i)
+  {
+    threads.emplace_back([i]() {
+      for (std::size_t j = 0; j < MESSAGES_PER_THREAD; ++j)
+      {
+        FETCH_LOG_INFO(LOGGING_NAME, "Thread: ", i, " message: ", j);
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  FlushLogs();
+
+  // switching the mode back is also expected to drain the queue
+  FETCH_LOG_INFO(LOGGING_NAME, "Final queued message");
+  SetLogMode(LogMode::SYNCHRONOUS);
+  FETCH_LOG_INFO(LOGGING_NAME, "Synchronous message");
+
+  // the volume of messages is well below the capacity of the queue
+  EXPECT_EQ(dropped, GetDroppedLogMessageCount());
+}
+
+#ifdef FETCH_LOG_INFO_ENABLED
+
+/**
+ * Redirects stdout into a full pipe, which blocks every write to the log sinks until the pipe is
+ * released. The output is collected once released.
+ */
+class BlockedStdout
+{
+public:
+  BlockedStdout()
+  {
+    int fds[2];
+    EXPECT_EQ(0, pipe(fds));
+    read_fd_  = fds[0];
+    write_fd_ = fds[1];
+
+    std::fflush(stdout);
+    saved_fd_ = dup(STDOUT_FILENO);
+    dup2(write_fd_, STDOUT_FILENO);
+
+    // fill the pipe completely
+    int const flags = fcntl(write_fd_, F_GETFL);
+    fcntl(write_fd_, F_SETFL, flags | O_NONBLOCK);
+    while (write(write_fd_, "\n", 1) > 0)
+    {
+    }
+    fcntl(write_fd_, F_SETFL, flags);
+  }
+
+  /**
+   * Start reading the pipe, which allows the blocked writes to complete
+   */
+  void Release()
+  {
+    reader_ = std::thread([this]() {
+      char    buffer[4096];
+      ssize_t num_bytes{0};
+      while ((num_bytes = read(read_fd_, buffer, sizeof(buffer))) > 0)
+      {
+        output_.append(buffer, static_cast<std::size_t>(num_bytes));
+      }
+    });
+  }
+
+  /**
+   * Restore stdout, must only be called once released
+   *
+   * @return Everything that was written to stdout in the meantime
+   */
+  std::string Restore()
+  {
+    std::fflush(stdout);
+    dup2(saved_fd_, STDOUT_FILENO);
+    close(saved_fd_);
+    close(write_fd_);
+
+    reader_.join();
+    close(read_fd_);
+
+    return output_;
+  }
+
+private:
+  int         read_fd_{-1};
+  int         write_fd_{-1};
+  int         saved_fd_{-1};
+  std::thread reader_;
+  std::string output_;
+};
+
+/**
+ * Log messages until the queue is full, which requires the background writer to be blocked
+ *
+ * @return The number of messages logged
+ */
+std::size_t FillLogQueue()
+{
+  static constexpr std::size_t MAX_MESSAGES = 1u << 20u;
+
+  auto const dropped = GetDroppedLogMessageCount();
+
+  std::size_t count{0};
+  while ((count < MAX_MESSAGES) && (GetDroppedLogMessageCount() == dropped))
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Queued message: ", count);
+    ++count;
+  }
+
+  return count;
+}
+
+TEST(LoggingTests, CheckLowPriorityMessagesAreDroppedWhenTheQueueIsFull)
+{
+  auto const dropped = GetDroppedLogMessageCount();
+
+  BlockedStdout blocked_stdout{};
+  SetLogMode(LogMode::ASYNCHRONOUS);
+
+  std::size_t const count         = FillLogQueue();
+  auto const        dropped_after = GetDroppedLogMessageCount();
+
+  blocked_stdout.Release();
+  SetLogMode(LogMode::SYNCHRONOUS);
+  std::string const output = blocked_stdout.Restore();
+
+  EXPECT_EQ(dropped + 1, dropped_after);
+
+  // the queued messages are all written, the last message is the one that was dropped
+  EXPECT_NE(std::string::npos, output.find("Queued message: 0\n"));
+  EXPECT_NE(std::string::npos, output.find("Queued message: " + std::to_string(count - 2) + "\n"));
+  EXPECT_EQ(std::string::npos, output.find("Queued message: " + std::to_string(count - 1) + "\n"));
+}
+
+TEST(LoggingTests, CheckErrorsAreWrittenSynchronouslyWhenTheQueueIsFull)
+{
+  BlockedStdout blocked_stdout{};
+  SetLogMode(LogMode::ASYNCHRONOUS);
+
+  FillLogQueue();
+  auto const dropped = GetDroppedLogMessageCount();
+
+  // the error blocks on the log sinks, which are held by the blocked background writer
+  std::thread error_thread{
+      []() { FETCH_LOG_ERROR(LOGGING_NAME, "Error logged while the queue is full"); }};
+  std::this_thread::sleep_for(100ms);
+
+  blocked_stdout.Release();
+  error_thread.join();
+
+  auto const dropped_after = GetDroppedLogMessageCount();
+
+  SetLogMode(LogMode::SYNCHRONOUS);
+  std::string const output = blocked_stdout.Restore();
+
+  EXPECT_EQ(dropped, dropped_after);
+  EXPECT_NE(std::string::npos, output.find("Error logged while the queue is full"));
+}
+
+#endif  // FETCH_LOG_INFO_ENABLED
+
+}  // namespace
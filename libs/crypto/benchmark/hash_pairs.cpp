@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/random/lcg.hpp"
+#include "crypto/hash_pairs.hpp"
+#include "crypto/sha256.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using fetch::crypto::HashPairs;
+using fetch::crypto::HashPairsEngine;
+using fetch::crypto::HASH_PAIR_INPUT_SIZE;
+using fetch::crypto::HASH_PAIR_OUTPUT_SIZE;
+using fetch::crypto::IsSupported;
+using fetch::crypto::SHA256;
+using fetch::random::LinearCongruentialGenerator;
+
+namespace {
+
+using Buffer = std::vector<uint8_t>;
+
+Buffer GenerateMessages(std::size_t count)
+{
+  LinearCongruentialGenerator rng;
+
+  Buffer buffer(count * HASH_PAIR_INPUT_SIZE);
+  for (auto &byte : buffer)
+  {
+    byte = static_cast<uint8_t>(rng());
+  }
+
+  return buffer;
+}
+
+/**
+ * Hash a batch of pairs with the specified engine. The number of lanes is 1 for the scalar and
+ * SHA-NI engines, 4 for SSE2 and 8 for AVX2.
+ *
+ * Arguments: engine, number of pairs in the batch
+ */
+void HashPairs_Engine(benchmark::State &state)
+{
+  auto const engine = static_cast<HashPairsEngine>(state.range(0));
+  auto const count  = static_cast<std::size_t>(state.range(1));
+
+  if (!IsSupported(engine))
+  {
+    state.SkipWithError("Engine not supported on this platform");
+    return;
+  }
+
+  Buffer const input = GenerateMessages(count);
+  Buffer       output(count * HASH_PAIR_OUTPUT_SIZE);
+
+  for (auto _ : state)
+  {
+    HashPairs(engine, input.data(), output.data(), count);
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
+/**
+ * The reference: hashing the same pairs one at a time through the OpenSSL backed hasher
+ *
+ * Arguments: number of pairs in the batch
+ */
+void HashPairs_OpenSsl(benchmark::State &state)
+{
+  auto const count = static_cast<std::size_t>(state.range(0));
+
+  Buffer const input = GenerateMessages(count);
+  Buffer       output(count * HASH_PAIR_OUTPUT_SIZE);
+
+  SHA256 hasher;
+  for (auto _ : state)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      hasher.Reset();
+      hasher.Update(input.data() + (i * HASH_PAIR_INPUT_SIZE), HASH_PAIR_INPUT_SIZE);
+      hasher.Final(output.data() + (i * HASH_PAIR_OUTPUT_SIZE));
+    }
+
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
+void EngineArguments(benchmark::internal::Benchmark *b)
+{
+  for (auto engine : {HashPairsEngine::SCALAR, HashPairsEngine::SSE2, HashPairsEngine::AVX2,
+                      HashPairsEngine::SHA_NI})
+  {
+    for (int64_t count : {8, 1024})
+    {
+      b->Args({static_cast<int64_t>(engine), count});
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(HashPairs_Engine)->Apply(EngineArguments);
+BENCHMARK(HashPairs_OpenSsl)->Arg(8)->Arg(1024);
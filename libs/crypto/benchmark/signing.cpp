@@ -20,13 +20,20 @@
 #include "core/byte_array/const_byte_array.hpp"
 #include "core/random/lcg.hpp"
 #include "crypto/ecdsa.hpp"
+#include "crypto/ecdsa_public_key_cache.hpp"
+#include "crypto/verifier.hpp"
 
 #include "benchmark/benchmark.h"
 
+#include <cstddef>
 #include <stdexcept>
+#include <vector>
 
+using fetch::crypto::ECDSAPublicKeyCache;
 using fetch::crypto::ECDSASigner;
 using fetch::crypto::ECDSAVerifier;
+using fetch::crypto::Identity;
+using fetch::crypto::Verifier;
 using fetch::byte_array::ConstByteArray;
 using fetch::byte_array::ByteArray;
 using fetch::random::LinearCongruentialGenerator;
@@ -80,6 +87,67 @@ void VerifySignature(benchmark::State &state)
   }
 }
 
+struct SignedMessage
+{
+  Identity       identity;
+  ConstByteArray signature;
+};
+
+std::vector<SignedMessage> GenerateSignedMessages(ConstByteArray const &msg, std::size_t count)
+{
+  std::vector<SignedMessage> messages;
+  messages.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ECDSASigner signer;
+
+    auto signature = signer.Sign(msg);
+    if (signature.empty())
+    {
+      throw std::runtime_error("Unable to sign the message");
+    }
+
+    messages.push_back({signer.identity(), std::move(signature)});
+  }
+
+  return messages;
+}
+
+void VerifySignatureWithKeyParsing(benchmark::State &state)
+{
+  ConstByteArray msg      = GenerateRandomData<2048>();
+  auto const     messages = GenerateSignedMessages(msg, static_cast<std::size_t>(state.range(0)));
+
+  std::size_t index{0};
+  for (auto _ : state)
+  {
+    auto const &message = messages[index++ % messages.size()];
+
+    // build a fresh verifier for every signature, decoding the public key each time
+    ECDSAVerifier verifier{message.identity};
+    verifier.Verify(msg, message.signature);
+  }
+}
+
+void VerifySignatureWithKeyCache(benchmark::State &state)
+{
+  ConstByteArray msg      = GenerateRandomData<2048>();
+  auto const     messages = GenerateSignedMessages(msg, static_cast<std::size_t>(state.range(0)));
+
+  ECDSAPublicKeyCache::Instance().Clear();
+
+  std::size_t index{0};
+  for (auto _ : state)
+  {
+    auto const &message = messages[index++ % messages.size()];
+
+    Verifier::Verify(message.identity, msg, message.signature);
+  }
+}
+
 }  // namespace
 
 BENCHMARK(VerifySignature);
+BENCHMARK(VerifySignatureWithKeyParsing)->Arg(1)->Arg(16)->Arg(256);
+BENCHMARK(VerifySignatureWithKeyCache)->Arg(1)->Arg(16)->Arg(256);
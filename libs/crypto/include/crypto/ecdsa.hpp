@@ -30,15 +30,21 @@ namespace crypto {
 
 class ECDSAVerifier : public Verifier
 {
-  using PublicKey = openssl::ECDSAPublicKey<>;
   using Signature = openssl::ECDSASignature<>;
 
 public:
+  using PublicKey = openssl::ECDSAPublicKey<>;
+
   explicit ECDSAVerifier(Identity ident)
     : identity_{std::move(ident)}
     , public_key_{identity_ ? PublicKey(identity_.identifier()) : PublicKey()}
   {}
 
+  ECDSAVerifier(Identity ident, PublicKey public_key)
+    : identity_{std::move(ident)}
+    , public_key_{std::move(public_key)}
+  {}
+
   bool Verify(ConstByteArray const &data, ConstByteArray const &signature) override
   {
     if (!identity_)
@@ -0,0 +1,90 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/mutex.hpp"
+#include "crypto/fnv.hpp"
+#include "crypto/openssl_ecdsa_public_key.hpp"
+#include "telemetry/telemetry.hpp"
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace fetch {
+namespace crypto {
+
+/**
+ * A bounded, thread safe cache of parsed ECDSA public keys indexed by their binary representation.
+ *
+ * Decoding a public key into its OpenSSL representation is a significant portion of the cost of
+ * verifying a signature. Since the majority of the signatures seen by a node come from a small set
+ * of repeat signers, the parsed keys are retained and reused. When the cache is full the least
+ * recently used key is evicted.
+ */
+class ECDSAPublicKeyCache
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using PublicKey      = openssl::ECDSAPublicKey<>;
+
+  static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+
+  static ECDSAPublicKeyCache &Instance();
+
+  // Construction / Destruction
+  explicit ECDSAPublicKeyCache(std::size_t capacity = DEFAULT_CAPACITY);
+  ECDSAPublicKeyCache(ECDSAPublicKeyCache const &) = delete;
+  ECDSAPublicKeyCache(ECDSAPublicKeyCache &&)      = delete;
+  ~ECDSAPublicKeyCache()                           = default;
+
+  PublicKey Lookup(ConstByteArray const &key_data);
+
+  /// @name Configuration
+  /// @{
+  void        SetCapacity(std::size_t capacity);
+  std::size_t capacity() const;
+  std::size_t size() const;
+  void        Clear();
+  /// @}
+
+  // Operators
+  ECDSAPublicKeyCache &operator=(ECDSAPublicKeyCache const &) = delete;
+  ECDSAPublicKeyCache &operator=(ECDSAPublicKeyCache &&) = delete;
+
+private:
+  using Entry   = std::pair<ConstByteArray, PublicKey>;
+  using Entries = std::list<Entry>;
+  using Index   = std::unordered_map<ConstByteArray, Entries::iterator>;
+  using Mutex   = std::mutex;
+
+  void Trim();
+
+  mutable Mutex lock_;
+  std::size_t   capacity_;
+  Entries       entries_;  ///< The cached keys, most recently used first
+  Index         index_;
+
+  telemetry::CounterPtr hit_count_;
+  telemetry::CounterPtr miss_count_;
+};
+
+}  // namespace crypto
+}  // namespace fetch
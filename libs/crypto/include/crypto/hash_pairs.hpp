@@ -0,0 +1,68 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fetch {
+namespace crypto {
+
+/**
+ * The implementations available for hashing batches of digest pairs
+ */
+enum class HashPairsEngine
+{
+  SCALAR,  ///< Portable implementation, one message at a time
+  SSE2,    ///< 4 messages in parallel in the lanes of the SSE registers
+  AVX2,    ///< 8 messages in parallel in the lanes of the AVX registers
+  SHA_NI,  ///< One message at a time with the x86 SHA extensions
+};
+
+constexpr std::size_t HASH_PAIR_INPUT_SIZE  = 64;  ///< The size of a pair of SHA256 digests
+constexpr std::size_t HASH_PAIR_OUTPUT_SIZE = 32;  ///< The size of the SHA256 digest of a pair
+
+/**
+ * Compute the SHA256 digests of a batch of 64 byte messages, typically the concatenation of two
+ * child digests in a Merkle tree. The output for message i is identical to the SHA256 of bytes
+ * [64i, 64i + 64) of the input.
+ *
+ * The output is allowed to alias the input, which allows a tree level to be condensed in place.
+ *
+ * @param input The count * 64 bytes of the messages
+ * @param output The count * 32 bytes for the resulting digests
+ * @param count The number of messages to hash
+ */
+void HashPairs(uint8_t const *input, uint8_t *output, std::size_t count);
+void HashPairs(HashPairsEngine engine, uint8_t const *input, uint8_t *output, std::size_t count);
+
+/**
+ * Compute the digests of a batch of messages as HashPairs, splitting large batches across a shared
+ * pool of worker threads. Unlike HashPairs, the output must not alias the input.
+ *
+ * @param input The count * 64 bytes of the messages
+ * @param output The count * 32 bytes for the resulting digests
+ * @param count The number of messages to hash
+ */
+void HashPairsInParallel(uint8_t const *input, uint8_t *output, std::size_t count);
+
+bool            IsSupported(HashPairsEngine engine);
+HashPairsEngine GetDefaultHashPairsEngine();
+
+}  // namespace crypto
+}  // namespace fetch
@@ -0,0 +1,143 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/ecdsa_public_key_cache.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/registry.hpp"
+
+namespace fetch {
+namespace crypto {
+
+/**
+ * Get the cache shared by all the verifiers in the process
+ *
+ * @return The reference to the cache
+ */
+ECDSAPublicKeyCache &ECDSAPublicKeyCache::Instance()
+{
+  static ECDSAPublicKeyCache instance;
+  return instance;
+}
+
+/**
+ * Construct the public key cache
+ *
+ * @param capacity The maximum number of keys to be cached
+ */
+ECDSAPublicKeyCache::ECDSAPublicKeyCache(std::size_t capacity)
+  : capacity_{capacity}
+  , hit_count_{telemetry::Registry::Instance().CreateCounter(
+        "crypto_public_key_cache_hit_total",
+        "The total number of public keys which were found in the cache")}
+  , miss_count_{telemetry::Registry::Instance().CreateCounter(
+        "crypto_public_key_cache_miss_total",
+        "The total number of public keys which had to be parsed")}
+{}
+
+/**
+ * Lookup the parsed version of the specified public key, parsing it if it is not already present
+ * in the cache. Keys which are not valid are never cached.
+ *
+ * @param key_data The binary representation of the public key
+ * @return The parsed public key
+ */
+ECDSAPublicKeyCache::PublicKey ECDSAPublicKeyCache::Lookup(ConstByteArray const &key_data)
+{
+  {
+    FETCH_LOCK(lock_);
+
+    auto it = index_.find(key_data);
+    if (it != index_.end())
+    {
+      // mark the entry as the most recently used
+      entries_.splice(entries_.begin(), entries_, it->second);
+
+      hit_count_->increment();
+      return it->second->second;
+    }
+  }
+
+  miss_count_->increment();
+
+  // parse the key outside of the lock since this is the expensive operation
+  PublicKey public_key{key_data};
+
+  FETCH_LOCK(lock_);
+
+  // another thread might have added the key while it was being parsed
+  if ((capacity_ > 0) && (index_.find(key_data) == index_.end()))
+  {
+    entries_.emplace_front(key_data, public_key);
+    index_.emplace(key_data, entries_.begin());
+
+    Trim();
+  }
+
+  return public_key;
+}
+
+/**
+ * Update the maximum number of keys to be cached, evicting keys if needed
+ *
+ * @param capacity The maximum number of keys
+ */
+void ECDSAPublicKeyCache::SetCapacity(std::size_t capacity)
+{
+  FETCH_LOCK(lock_);
+  capacity_ = capacity;
+
+  Trim();
+}
+
+std::size_t ECDSAPublicKeyCache::capacity() const
+{
+  FETCH_LOCK(lock_);
+  return capacity_;
+}
+
+std::size_t ECDSAPublicKeyCache::size() const
+{
+  FETCH_LOCK(lock_);
+  return entries_.size();
+}
+
+/**
+ * Remove all the cached keys
+ */
+void ECDSAPublicKeyCache::Clear()
+{
+  FETCH_LOCK(lock_);
+  index_.clear();
+  entries_.clear();
+}
+
+/**
+ * Evict the least recently used keys until the cache is within its capacity. The lock must be held
+ * by the caller.
+ */
+void ECDSAPublicKeyCache::Trim()
+{
+  while (entries_.size() > capacity_)
+  {
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+}
+
+}  // namespace crypto
+}  // namespace fetch
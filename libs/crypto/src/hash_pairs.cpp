@@ -0,0 +1,814 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/hash_pairs.hpp"
+#include "vectorise/platform.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define FETCH_HASH_PAIRS_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace fetch {
+namespace crypto {
+namespace {
+
+constexpr uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+constexpr uint32_t INITIAL_STATE[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                       0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+/**
+ * Every message is exactly 64 bytes long, so the second block of each of them is the same padding
+ * block. Its message schedule (combined with the round constants) is therefore fixed.
+ */
+struct PaddingSchedule
+{
+  uint32_t kw[64];
+};
+
+constexpr uint32_t RotateRight(uint32_t x, uint32_t n)
+{
+  return (x >> n) | (x << (32u - n));
+}
+
+constexpr PaddingSchedule BuildPaddingSchedule()
+{
+  PaddingSchedule schedule{};
+
+  uint32_t w[64]{};
+  w[0]  = 0x80000000u;  // the terminating bit
+  w[15] = 512u;         // the length of the message in bits
+
+  for (std::size_t i = 16; i < 64; ++i)
+  {
+    uint32_t const s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3u);
+    uint32_t const s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10u);
+    w[i]              = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  for (std::size_t i = 0; i < 64; ++i)
+  {
+    schedule.kw[i] = K[i] + w[i];
+  }
+
+  return schedule;
+}
+
+constexpr PaddingSchedule PADDING_SCHEDULE = BuildPaddingSchedule();
+
+/**
+ * The operations required by the compression function, on a single 32 bit word. The SIMD variants
+ * below provide the same operations on a register holding the words of several messages.
+ */
+struct ScalarLanes
+{
+  using Word = uint32_t;
+
+  static constexpr std::size_t LANES = 1;
+
+  static Word Set(uint32_t value)
+  {
+    return value;
+  }
+
+  static Word Add(Word a, Word b)
+  {
+    return a + b;
+  }
+
+  static Word Xor(Word a, Word b)
+  {
+    return a ^ b;
+  }
+
+  static Word And(Word a, Word b)
+  {
+    return a & b;
+  }
+
+  static Word Or(Word a, Word b)
+  {
+    return a | b;
+  }
+
+  static Word AndNot(Word a, Word b)
+  {
+    return ~a & b;
+  }
+
+  template <int N>
+  static Word ShiftRight(Word x)
+  {
+    return x >> N;
+  }
+
+  template <int N>
+  static Word ShiftLeft(Word x)
+  {
+    return x << N;
+  }
+
+  static Word Load(uint8_t const *input, std::size_t word)
+  {
+    uint32_t value;
+    std::memcpy(&value, input + (word * 4), sizeof(value));
+    return platform::FromBigEndian(value);
+  }
+
+  static void Store(uint8_t *output, Word const *state)
+  {
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      uint32_t const value = platform::ToBigEndian(state[i]);
+      std::memcpy(output + (i * 4), &value, sizeof(value));
+    }
+  }
+};
+
+#if defined(__SSE2__)
+
+struct Sse2Lanes
+{
+  using Word = __m128i;
+
+  static constexpr std::size_t LANES = 4;
+
+  static Word Set(uint32_t value)
+  {
+    return _mm_set1_epi32(static_cast<int>(value));
+  }
+
+  static Word Add(Word a, Word b)
+  {
+    return _mm_add_epi32(a, b);
+  }
+
+  static Word Xor(Word a, Word b)
+  {
+    return _mm_xor_si128(a, b);
+  }
+
+  static Word And(Word a, Word b)
+  {
+    return _mm_and_si128(a, b);
+  }
+
+  static Word Or(Word a, Word b)
+  {
+    return _mm_or_si128(a, b);
+  }
+
+  static Word AndNot(Word a, Word b)
+  {
+    return _mm_andnot_si128(a, b);
+  }
+
+  template <int N>
+  static Word ShiftRight(Word x)
+  {
+    return _mm_srli_epi32(x, N);
+  }
+
+  template <int N>
+  static Word ShiftLeft(Word x)
+  {
+    return _mm_slli_epi32(x, N);
+  }
+
+  static Word Load(uint8_t const *input, std::size_t word)
+  {
+    return _mm_set_epi32(static_cast<int>(ScalarLanes::Load(input + 192, word)),
+                         static_cast<int>(ScalarLanes::Load(input + 128, word)),
+                         static_cast<int>(ScalarLanes::Load(input + 64, word)),
+                         static_cast<int>(ScalarLanes::Load(input, word)));
+  }
+
+  static void Store(uint8_t *output, Word const *state)
+  {
+    alignas(16) uint32_t words[LANES][8];
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      alignas(16) uint32_t lanes[LANES];
+      _mm_store_si128(reinterpret_cast<__m128i *>(lanes), state[i]);
+
+      for (std::size_t lane = 0; lane < LANES; ++lane)
+      {
+        words[lane][i] = lanes[lane];
+      }
+    }
+
+    for (std::size_t lane = 0; lane < LANES; ++lane)
+    {
+      ScalarLanes::Store(output + (lane * HASH_PAIR_OUTPUT_SIZE), words[lane]);
+    }
+  }
+};
+
+#endif  // __SSE2__
+
+#if defined(FETCH_HASH_PAIRS_X86)
+
+/**
+ * The lanes are compiled for AVX2 regardless of the flags of the build and are only used once the
+ * support of the CPU (and the OS) has been detected at runtime. They are used by the dedicated AVX2
+ * kernel rather than the generic one.
+ */
+struct Avx2Lanes
+{
+  using Word = __m256i;
+
+  static constexpr std::size_t LANES = 8;
+
+  __attribute__((target("avx2"))) static Word Set(uint32_t value)
+  {
+    return _mm256_set1_epi32(static_cast<int>(value));
+  }
+
+  __attribute__((target("avx2"))) static Word Add(Word a, Word b)
+  {
+    return _mm256_add_epi32(a, b);
+  }
+
+  __attribute__((target("avx2"))) static Word Xor(Word a, Word b)
+  {
+    return _mm256_xor_si256(a, b);
+  }
+
+  __attribute__((target("avx2"))) static Word And(Word a, Word b)
+  {
+    return _mm256_and_si256(a, b);
+  }
+
+  __attribute__((target("avx2"))) static Word Or(Word a, Word b)
+  {
+    return _mm256_or_si256(a, b);
+  }
+
+  __attribute__((target("avx2"))) static Word AndNot(Word a, Word b)
+  {
+    return _mm256_andnot_si256(a, b);
+  }
+
+  template <int N>
+  __attribute__((target("avx2"))) static Word ShiftRight(Word x)
+  {
+    return _mm256_srli_epi32(x, N);
+  }
+
+  template <int N>
+  __attribute__((target("avx2"))) static Word ShiftLeft(Word x)
+  {
+    return _mm256_slli_epi32(x, N);
+  }
+
+  __attribute__((target("avx2"))) static Word Load(uint8_t const *input, std::size_t word)
+  {
+    // gather the word from each of the messages (64 bytes apart) and convert it from big endian
+    __m256i const offsets = _mm256_setr_epi32(0, 16, 32, 48, 64, 80, 96, 112);
+    __m256i const mask    = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                          3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+    __m256i const words = _mm256_i32gather_epi32(
+        reinterpret_cast<int const *>(input + (word * 4)), offsets, 4);
+
+    return _mm256_shuffle_epi8(words, mask);
+  }
+
+  __attribute__((target("avx2"))) static void Store(uint8_t *output, Word const *state)
+  {
+    alignas(32) uint32_t words[LANES][8];
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      alignas(32) uint32_t lanes[LANES];
+      _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), state[i]);
+
+      for (std::size_t lane = 0; lane < LANES; ++lane)
+      {
+        words[lane][i] = lanes[lane];
+      }
+    }
+
+    for (std::size_t lane = 0; lane < LANES; ++lane)
+    {
+      ScalarLanes::Store(output + (lane * HASH_PAIR_OUTPUT_SIZE), words[lane]);
+    }
+  }
+};
+
+#endif  // FETCH_HASH_PAIRS_X86
+
+template <typename L, int N>
+typename L::Word Rotate(typename L::Word x)
+{
+  return L::Or(L::template ShiftRight<N>(x), L::template ShiftLeft<32 - N>(x));
+}
+
+/**
+ * Run the 64 rounds of the compression function over the state
+ *
+ * @param state The working variables a to h
+ * @param kw Callable returning the sum of the round constant and the message schedule for a round
+ */
+template <typename L, typename KW>
+void Rounds(typename L::Word *state, KW &&kw)
+{
+  using Word = typename L::Word;
+
+  Word a = state[0], b = state[1], c = state[2], d = state[3];
+  Word e = state[4], f = state[5], g = state[6], h = state[7];
+
+  for (std::size_t i = 0; i < 64; ++i)
+  {
+    Word const s1 = L::Xor(L::Xor(Rotate<L, 6>(e), Rotate<L, 11>(e)), Rotate<L, 25>(e));
+    Word const ch = L::Xor(L::And(e, f), L::AndNot(e, g));
+    Word const t1 = L::Add(L::Add(h, s1), L::Add(ch, kw(i)));
+    Word const s0 = L::Xor(L::Xor(Rotate<L, 2>(a), Rotate<L, 13>(a)), Rotate<L, 22>(a));
+    Word const mj = L::Or(L::And(a, b), L::And(c, L::Or(a, b)));
+    Word const t2 = L::Add(s0, mj);
+
+    h = g;
+    g = f;
+    f = e;
+    e = L::Add(d, t1);
+    d = c;
+    c = b;
+    b = a;
+    a = L::Add(t1, t2);
+  }
+
+  state[0] = L::Add(state[0], a);
+  state[1] = L::Add(state[1], b);
+  state[2] = L::Add(state[2], c);
+  state[3] = L::Add(state[3], d);
+  state[4] = L::Add(state[4], e);
+  state[5] = L::Add(state[5], f);
+  state[6] = L::Add(state[6], g);
+  state[7] = L::Add(state[7], h);
+}
+
+/**
+ * Hash L::LANES consecutive messages, one in each lane of the registers
+ */
+template <typename L>
+void HashLanes(uint8_t const *input, uint8_t *output)
+{
+  using Word = typename L::Word;
+
+  // the full message is loaded before any output is written, since they are allowed to alias
+  Word w[16];
+  for (std::size_t i = 0; i < 16; ++i)
+  {
+    w[i] = L::Load(input, i);
+  }
+
+  Word state[8];
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    state[i] = L::Set(INITIAL_STATE[i]);
+  }
+
+  // the message block, extending the schedule in a rolling window of 16 words
+  Rounds<L>(state, [&w](std::size_t i) {
+    if (i >= 16)
+    {
+      Word const w15 = w[(i - 15) & 15u];
+      Word const w2  = w[(i - 2) & 15u];
+      Word const s0  = L::Xor(L::Xor(Rotate<L, 7>(w15), Rotate<L, 18>(w15)),
+                             L::template ShiftRight<3>(w15));
+      Word const s1  = L::Xor(L::Xor(Rotate<L, 17>(w2), Rotate<L, 19>(w2)),
+                             L::template ShiftRight<10>(w2));
+
+      w[i & 15u] = L::Add(L::Add(w[i & 15u], s0), L::Add(w[(i - 7) & 15u], s1));
+    }
+
+    return L::Add(w[i & 15u], L::Set(K[i]));
+  });
+
+  // the padding block
+  Rounds<L>(state, [](std::size_t i) { return L::Set(PADDING_SCHEDULE.kw[i]); });
+
+  L::Store(output, state);
+}
+
+template <typename L>
+void HashPairsWith(uint8_t const *input, uint8_t *output, std::size_t count)
+{
+  std::size_t i = 0;
+  for (; i + L::LANES <= count; i += L::LANES)
+  {
+    HashLanes<L>(input + (i * HASH_PAIR_INPUT_SIZE), output + (i * HASH_PAIR_OUTPUT_SIZE));
+  }
+
+  for (; i < count; ++i)
+  {
+    HashLanes<ScalarLanes>(input + (i * HASH_PAIR_INPUT_SIZE),
+                           output + (i * HASH_PAIR_OUTPUT_SIZE));
+  }
+}
+
+#if defined(FETCH_HASH_PAIRS_X86)
+
+bool DetectShaExtensions()
+{
+  unsigned int eax{0}, ebx{0}, ecx{0}, edx{0};
+
+  // the SHA extensions are reported in leaf 7, SSE4.1 and SSSE3 in leaf 1
+  if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) || ((ebx & (1u << 29u)) == 0))
+  {
+    return false;
+  }
+
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+  {
+    return false;
+  }
+
+  return ((ecx & (1u << 19u)) != 0) && ((ecx & (1u << 9u)) != 0);
+}
+
+bool DetectAvx2()
+{
+  unsigned int eax{0}, ebx{0}, ecx{0}, edx{0};
+
+  // AVX2 is reported in leaf 7, AVX and the use of XSAVE by the OS in leaf 1
+  if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) || ((ebx & (1u << 5u)) == 0))
+  {
+    return false;
+  }
+
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || ((ecx & (1u << 27u)) == 0) ||
+      ((ecx & (1u << 28u)) == 0))
+  {
+    return false;
+  }
+
+  // the OS must also save the upper halves of the AVX registers (along with the SSE registers)
+  uint32_t xcr0{0}, xcr0_high{0};
+  __asm__("xgetbv" : "=a"(xcr0), "=d"(xcr0_high) : "c"(0));
+
+  return (xcr0 & 0x6u) == 0x6u;
+}
+
+template <int N>
+__attribute__((target("avx2"))) __m256i RotateAvx2(__m256i x)
+{
+  return Avx2Lanes::Or(Avx2Lanes::ShiftRight<N>(x), Avx2Lanes::ShiftLeft<32 - N>(x));
+}
+
+/**
+ * Run the 64 rounds of the compression function over the state, in the same way as Rounds
+ *
+ * The generic kernel can not be used for the AVX2 lanes, since it is not compiled for the
+ * instruction set. Every function which handles the AVX registers must enable it.
+ *
+ * @param state The working variables a to h
+ * @param kw The sum of the round constant and the message schedule for each round
+ */
+__attribute__((target("avx2"))) void RoundsAvx2(__m256i *state, __m256i const *kw)
+{
+  using L = Avx2Lanes;
+
+  __m256i a = state[0], b = state[1], c = state[2], d = state[3];
+  __m256i e = state[4], f = state[5], g = state[6], h = state[7];
+
+  for (std::size_t i = 0; i < 64; ++i)
+  {
+    __m256i const s1 = L::Xor(L::Xor(RotateAvx2<6>(e), RotateAvx2<11>(e)), RotateAvx2<25>(e));
+    __m256i const ch = L::Xor(L::And(e, f), L::AndNot(e, g));
+    __m256i const t1 = L::Add(L::Add(h, s1), L::Add(ch, kw[i]));
+    __m256i const s0 = L::Xor(L::Xor(RotateAvx2<2>(a), RotateAvx2<13>(a)), RotateAvx2<22>(a));
+    __m256i const mj = L::Or(L::And(a, b), L::And(c, L::Or(a, b)));
+    __m256i const t2 = L::Add(s0, mj);
+
+    h = g;
+    g = f;
+    f = e;
+    e = L::Add(d, t1);
+    d = c;
+    c = b;
+    b = a;
+    a = L::Add(t1, t2);
+  }
+
+  state[0] = L::Add(state[0], a);
+  state[1] = L::Add(state[1], b);
+  state[2] = L::Add(state[2], c);
+  state[3] = L::Add(state[3], d);
+  state[4] = L::Add(state[4], e);
+  state[5] = L::Add(state[5], f);
+  state[6] = L::Add(state[6], g);
+  state[7] = L::Add(state[7], h);
+}
+
+__attribute__((target("avx2"))) void HashPairsAvx2(uint8_t const *input, uint8_t *output,
+                                                   std::size_t count)
+{
+  using L = Avx2Lanes;
+
+  __m256i padding[64];
+  for (std::size_t i = 0; i < 64; ++i)
+  {
+    padding[i] = L::Set(PADDING_SCHEDULE.kw[i]);
+  }
+
+  std::size_t i = 0;
+  for (; i + L::LANES <= count; i += L::LANES)
+  {
+    uint8_t const *messages = input + (i * HASH_PAIR_INPUT_SIZE);
+
+    // the full message is loaded before any output is written, since they are allowed to alias
+    __m256i w[64];
+    for (std::size_t j = 0; j < 16; ++j)
+    {
+      w[j] = L::Load(messages, j);
+    }
+
+    for (std::size_t j = 16; j < 64; ++j)
+    {
+      __m256i const s0 = L::Xor(L::Xor(RotateAvx2<7>(w[j - 15]), RotateAvx2<18>(w[j - 15])),
+                                L::ShiftRight<3>(w[j - 15]));
+      __m256i const s1 = L::Xor(L::Xor(RotateAvx2<17>(w[j - 2]), RotateAvx2<19>(w[j - 2])),
+                                L::ShiftRight<10>(w[j - 2]));
+
+      w[j] = L::Add(L::Add(w[j - 16], s0), L::Add(w[j - 7], s1));
+    }
+
+    for (std::size_t j = 0; j < 64; ++j)
+    {
+      w[j] = L::Add(w[j], L::Set(K[j]));
+    }
+
+    __m256i state[8];
+    for (std::size_t j = 0; j < 8; ++j)
+    {
+      state[j] = L::Set(INITIAL_STATE[j]);
+    }
+
+    RoundsAvx2(state, w);
+    RoundsAvx2(state, padding);
+
+    L::Store(output + (i * HASH_PAIR_OUTPUT_SIZE), state);
+  }
+
+  for (; i < count; ++i)
+  {
+    HashLanes<ScalarLanes>(input + (i * HASH_PAIR_INPUT_SIZE),
+                           output + (i * HASH_PAIR_OUTPUT_SIZE));
+  }
+}
+
+alignas(16) constexpr uint8_t PADDING_BLOCK[64] = {0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                                   0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                                   0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                                   0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                                   0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0};
+
+/**
+ * Compress a single block into the state, held in the ABEF / CDGH layout used by the instructions
+ */
+__attribute__((target("sha,sse4.1,ssse3"))) void ShaNiCompress(__m128i &abef, __m128i &cdgh,
+                                                                uint8_t const *block)
+{
+  __m128i const byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bll, 0x0405060700010203ll);
+
+  __m128i const abef_save = abef;
+  __m128i const cdgh_save = cdgh;
+
+  __m128i msg[4];
+  for (std::size_t i = 0; i < 16; ++i)
+  {
+    __m128i &current = msg[i & 3u];
+
+    if (i < 4)
+    {
+      current = _mm_shuffle_epi8(
+          _mm_loadu_si128(reinterpret_cast<__m128i const *>(block + (i * 16))), byte_swap);
+    }
+    else
+    {
+      // W[t] = sigma1(W[t-2]) + W[t-7] + sigma0(W[t-15]) + W[t-16], four words at a time
+      __m128i const previous = msg[(i - 1) & 3u];
+      __m128i const w7       = _mm_alignr_epi8(previous, msg[(i - 2) & 3u], 4);
+
+      current = _mm_sha256msg1_epu32(current, msg[(i - 3) & 3u]);
+      current = _mm_sha256msg2_epu32(_mm_add_epi32(current, w7), previous);
+    }
+
+    // two rounds with the lower words, then two with the upper ones
+    __m128i const constants = _mm_loadu_si128(reinterpret_cast<__m128i const *>(K + (i * 4)));
+    __m128i       kw        = _mm_add_epi32(current, constants);
+    cdgh                    = _mm_sha256rnds2_epu32(cdgh, abef, kw);
+    kw                      = _mm_shuffle_epi32(kw, 0x0E);
+    abef                    = _mm_sha256rnds2_epu32(abef, cdgh, kw);
+  }
+
+  abef = _mm_add_epi32(abef, abef_save);
+  cdgh = _mm_add_epi32(cdgh, cdgh_save);
+}
+
+__attribute__((target("sha,sse4.1,ssse3"))) void HashPairsShaNi(uint8_t const *input,
+                                                                 uint8_t *output, std::size_t count)
+{
+  // convert the initial state from ABCD / EFGH into ABEF / CDGH
+  __m128i const abcd = _mm_loadu_si128(reinterpret_cast<__m128i const *>(INITIAL_STATE));
+  __m128i const efgh = _mm_loadu_si128(reinterpret_cast<__m128i const *>(INITIAL_STATE + 4));
+
+  __m128i const cdab         = _mm_shuffle_epi32(abcd, 0xB1);
+  __m128i const hgfe         = _mm_shuffle_epi32(efgh, 0x1B);
+  __m128i const initial_abef = _mm_alignr_epi8(cdab, hgfe, 8);
+  __m128i const initial_cdgh = _mm_blend_epi16(hgfe, cdab, 0xF0);
+
+  __m128i const byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bll, 0x0405060700010203ll);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    __m128i abef = initial_abef;
+    __m128i cdgh = initial_cdgh;
+
+    ShaNiCompress(abef, cdgh, input + (i * HASH_PAIR_INPUT_SIZE));
+    ShaNiCompress(abef, cdgh, PADDING_BLOCK);
+
+    // convert back into ABCD / EFGH and to big endian
+    __m128i const feba = _mm_shuffle_epi32(abef, 0x1B);
+    __m128i const dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+    __m128i const dcba = _mm_blend_epi16(feba, dchg, 0xF0);
+    __m128i const hgef = _mm_alignr_epi8(dchg, feba, 8);
+
+    uint8_t *digest = output + (i * HASH_PAIR_OUTPUT_SIZE);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(digest), _mm_shuffle_epi8(dcba, byte_swap));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(digest + 16), _mm_shuffle_epi8(hgef, byte_swap));
+  }
+}
+
+#endif  // FETCH_HASH_PAIRS_X86
+
+HashPairsEngine DetectDefaultEngine()
+{
+  // in order of preference, the 8 lanes of AVX2 outperform the single stream of the SHA extensions
+  for (auto engine : {HashPairsEngine::AVX2, HashPairsEngine::SHA_NI, HashPairsEngine::SSE2})
+  {
+    if (IsSupported(engine))
+    {
+      return engine;
+    }
+  }
+
+  return HashPairsEngine::SCALAR;
+}
+
+// below this the cost of dispatching the work outweighs hashing it on the calling thread
+constexpr std::size_t MIN_PAIRS_PER_TASK = 1024;
+
+threading::Pool &HashingPool()
+{
+  static threading::Pool pool{std::max(1u, std::thread::hardware_concurrency()), "HashPairs"};
+  return pool;
+}
+
+}  // namespace
+
+bool IsSupported(HashPairsEngine engine)
+{
+  switch (engine)
+  {
+  case HashPairsEngine::SCALAR:
+    return true;
+  case HashPairsEngine::SSE2:
+#if defined(__SSE2__)
+    return true;
+#else
+    return false;
+#endif
+  case HashPairsEngine::AVX2:
+#if defined(FETCH_HASH_PAIRS_X86)
+  {
+    static bool const supported = DetectAvx2();
+    return supported;
+  }
+#else
+    return false;
+#endif
+  case HashPairsEngine::SHA_NI:
+#if defined(FETCH_HASH_PAIRS_X86)
+  {
+    static bool const supported = DetectShaExtensions();
+    return supported;
+  }
+#else
+    return false;
+#endif
+  }
+
+  return false;
+}
+
+HashPairsEngine GetDefaultHashPairsEngine()
+{
+  static HashPairsEngine const engine = DetectDefaultEngine();
+  return engine;
+}
+
+void HashPairs(uint8_t const *input, uint8_t *output, std::size_t count)
+{
+  HashPairs(GetDefaultHashPairsEngine(), input, output, count);
+}
+
+void HashPairs(HashPairsEngine engine, uint8_t const *input, uint8_t *output, std::size_t count)
+{
+  assert(IsSupported(engine));
+
+  switch (engine)
+  {
+  case HashPairsEngine::SCALAR:
+    HashPairsWith<ScalarLanes>(input, output, count);
+    break;
+#if defined(__SSE2__)
+  case HashPairsEngine::SSE2:
+    HashPairsWith<Sse2Lanes>(input, output, count);
+    break;
+#endif
+#if defined(FETCH_HASH_PAIRS_X86)
+  case HashPairsEngine::AVX2:
+    HashPairsAvx2(input, output, count);
+    break;
+  case HashPairsEngine::SHA_NI:
+    HashPairsShaNi(input, output, count);
+    break;
+#endif
+  default:
+    HashPairsWith<ScalarLanes>(input, output, count);
+    break;
+  }
+}
+
+void HashPairsInParallel(uint8_t const *input, uint8_t *output, std::size_t count)
+{
+  auto &pool = HashingPool();
+
+  std::size_t const num_tasks = std::min(pool.concurrency(), count / MIN_PAIRS_PER_TASK);
+  if (num_tasks < 2)
+  {
+    HashPairs(input, output, count);
+    return;
+  }
+
+  std::size_t const per_task = (count + num_tasks - 1) / num_tasks;
+
+  std::vector<std::future<void>> pending;
+  pending.reserve(num_tasks - 1);
+  for (std::size_t begin = per_task; begin < count; begin += per_task)
+  {
+    std::size_t const size = std::min(per_task, count - begin);
+
+    pending.emplace_back(pool.Dispatch([input, output, begin, size]() {
+      HashPairs(input + (begin * HASH_PAIR_INPUT_SIZE), output + (begin * HASH_PAIR_OUTPUT_SIZE),
+                size);
+    }));
+  }
+
+  // the calling thread takes the first share of the work rather than waiting idle
+  HashPairs(input, output, per_task);
+
+  for (auto &task : pending)
+  {
+    task.get();
+  }
+}
+
+}  // namespace crypto
+}  // namespace fetch
@@ -17,6 +17,7 @@
 //------------------------------------------------------------------------------
 
 #include "crypto/hash.hpp"
+#include "crypto/hash_pairs.hpp"
 #include "crypto/merkle_tree.hpp"
 #include "crypto/sha256.hpp"
 #include "vectorise/platform.hpp"
@@ -24,6 +25,8 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <vector>
 
 namespace fetch {
 namespace crypto {
@@ -31,6 +34,79 @@ namespace crypto {
 using HashArray = MerkleTree::Digest;
 using Container = MerkleTree::Container;
 
+namespace {
+
+bool AreAllDigests(Container const &leaves)
+{
+  for (auto const &leaf : leaves)
+  {
+    if (leaf.size() != HASH_PAIR_OUTPUT_SIZE)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Compute the root of a tree whose leaves are all SHA256 digests, condensing each level of the
+ * tree in place in a flat buffer with batched hashing. The result is identical to the generic
+ * computation, where the tree is padded up to a power of 2 with empty leaves.
+ */
+HashArray CalculateRootOfDigests(Container const &leaves)
+{
+  std::size_t const num_leaves = leaves.size();
+  std::size_t const num_pairs  = num_leaves / 2;
+
+  std::size_t width = 1;
+  while (width < num_leaves)
+  {
+    width <<= 1;
+  }
+
+  std::vector<uint8_t> level(num_leaves * HASH_PAIR_OUTPUT_SIZE);
+  for (std::size_t i = 0; i < num_leaves; ++i)
+  {
+    std::memcpy(level.data() + (i * HASH_PAIR_OUTPUT_SIZE), leaves[i].pointer(),
+                HASH_PAIR_OUTPUT_SIZE);
+  }
+
+  // the first level of parents, where the padding leaves are empty rather than a digest
+  HashPairs(level.data(), level.data(), num_pairs);
+
+  std::size_t parent = num_pairs;
+  level.resize((width / 2) * HASH_PAIR_OUTPUT_SIZE);
+
+  if ((num_leaves & 1u) != 0)
+  {
+    HashArray const odd = Hash<SHA256>(leaves.back());
+    std::memcpy(level.data() + (parent * HASH_PAIR_OUTPUT_SIZE), odd.pointer(),
+                HASH_PAIR_OUTPUT_SIZE);
+    ++parent;
+  }
+
+  if (parent < (width / 2))
+  {
+    HashArray const padding = Hash<SHA256>(HashArray{});
+    for (; parent < (width / 2); ++parent)
+    {
+      std::memcpy(level.data() + (parent * HASH_PAIR_OUTPUT_SIZE), padding.pointer(),
+                  HASH_PAIR_OUTPUT_SIZE);
+    }
+  }
+
+  // the remaining levels only contain digests
+  for (width /= 2; width > 1; width /= 2)
+  {
+    HashPairs(level.data(), level.data(), width / 2);
+  }
+
+  return HashArray{level.data(), HASH_PAIR_OUTPUT_SIZE};
+}
+
+}  // namespace
+
 MerkleTree::MerkleTree(std::size_t count)
   : leaf_nodes_{count}
 {}
@@ -54,6 +130,12 @@ void MerkleTree::CalculateRoot() const
     return;
   }
 
+  if (AreAllDigests(leaf_nodes_))
+  {
+    root_ = CalculateRootOfDigests(leaf_nodes_);
+    return;
+  }
+
   // make a copy of the leaf nodes which are then condensed
   std::vector<Digest> hashes = leaf_nodes_;
 
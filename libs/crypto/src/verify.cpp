@@ -17,13 +17,15 @@
 //------------------------------------------------------------------------------
 
 #include "crypto/ecdsa.hpp"
+#include "crypto/ecdsa_public_key_cache.hpp"
 #include "crypto/verifier.hpp"
 
 namespace fetch {
 namespace crypto {
 
 /**
- * Build the corresponding Verifier based from the provided identity
+ * Build the corresponding Verifier based from the provided identity. The parsed public key is
+ * reused from the process wide cache where possible.
  *
  * @param identity The identity to build the verifier from
  * @return The generated verifier
@@ -33,7 +35,15 @@ std::unique_ptr<Verifier> Verifier::Build(Identity const &identity)
   std::unique_ptr<Verifier> verifier;
 
   // only supported signature scheme currently
-  verifier = std::make_unique<ECDSAVerifier>(identity);
+  if (identity)
+  {
+    verifier = std::make_unique<ECDSAVerifier>(
+        identity, ECDSAPublicKeyCache::Instance().Lookup(identity.identifier()));
+  }
+  else
+  {
+    verifier = std::make_unique<ECDSAVerifier>(identity);
+  }
 
   return verifier;
 }
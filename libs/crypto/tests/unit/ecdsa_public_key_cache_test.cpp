@@ -0,0 +1,91 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/ecdsa.hpp"
+#include "crypto/ecdsa_public_key_cache.hpp"
+#include "crypto/verifier.hpp"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::ECDSAPublicKeyCache;
+using fetch::crypto::ECDSASigner;
+using fetch::crypto::Verifier;
+
+ConstByteArray const TEST_DATA{0x2a, 0xc8, 0xa5, 0xb0, 0x45, 0xfc, 0x3e, 0xa4};
+
+TEST(ECDSAPublicKeyCacheTests, CachedKeysVerifySignatures)
+{
+  ECDSAPublicKeyCache cache{4};
+
+  ECDSASigner signer;
+  auto const  signature = signer.Sign(TEST_DATA);
+  ASSERT_FALSE(signature.empty());
+
+  auto const first  = cache.Lookup(signer.public_key());
+  auto const second = cache.Lookup(signer.public_key());
+  EXPECT_EQ(1u, cache.size());
+
+  fetch::crypto::ECDSAVerifier verifier{signer.identity(), second};
+  EXPECT_TRUE(verifier.Verify(TEST_DATA, signature));
+  EXPECT_EQ(first.KeyAsBin(), second.KeyAsBin());
+}
+
+TEST(ECDSAPublicKeyCacheTests, LeastRecentlyUsedKeysAreEvicted)
+{
+  ECDSAPublicKeyCache cache{2};
+
+  std::vector<ECDSASigner> signers(3);
+
+  cache.Lookup(signers[0].public_key());
+  cache.Lookup(signers[1].public_key());
+
+  // refresh the first key so that the second is the least recently used
+  cache.Lookup(signers[0].public_key());
+  cache.Lookup(signers[2].public_key());
+  EXPECT_EQ(2u, cache.size());
+
+  cache.SetCapacity(1);
+  EXPECT_EQ(1u, cache.size());
+
+  cache.SetCapacity(0);
+  cache.Lookup(signers[0].public_key());
+  EXPECT_EQ(0u, cache.size());
+}
+
+TEST(ECDSAPublicKeyCacheTests, InvalidSignaturesAreRejectedWithCachedKeys)
+{
+  ECDSASigner signer;
+  ECDSASigner other;
+
+  auto const signature = signer.Sign(TEST_DATA);
+  ASSERT_FALSE(signature.empty());
+
+  // verify twice to exercise both the miss and the hit path
+  for (std::size_t i = 0; i < 2; ++i)
+  {
+    EXPECT_TRUE(Verifier::Verify(signer.identity(), TEST_DATA, signature));
+    EXPECT_FALSE(Verifier::Verify(other.identity(), TEST_DATA, signature));
+  }
+}
+
+}  // namespace
@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/hash_pairs.hpp"
+#include "crypto/sha256.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+using namespace fetch::crypto;
+
+using fetch::byte_array::ConstByteArray;
+using Buffer = std::vector<uint8_t>;
+
+Buffer GenerateMessages(std::size_t count)
+{
+  fetch::random::LinearCongruentialGenerator rng;
+
+  Buffer buffer(count * HASH_PAIR_INPUT_SIZE);
+  for (auto &byte : buffer)
+  {
+    byte = static_cast<uint8_t>(rng());
+  }
+
+  return buffer;
+}
+
+void ExpectMatchesReference(Buffer const &input, Buffer const &output, std::size_t count)
+{
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ConstByteArray const message{input.data() + (i * HASH_PAIR_INPUT_SIZE), HASH_PAIR_INPUT_SIZE};
+    ConstByteArray const digest{output.data() + (i * HASH_PAIR_OUTPUT_SIZE),
+                                HASH_PAIR_OUTPUT_SIZE};
+
+    ASSERT_EQ(Hash<SHA256>(message), digest) << "Mismatch for message " << i;
+  }
+}
+
+class HashPairsTests : public ::testing::TestWithParam<HashPairsEngine>
+{
+protected:
+  // engines which the machine can not run are reported, rather than passing silently
+  bool SkipIfUnsupported()
+  {
+    if (IsSupported(GetParam()))
+    {
+      return false;
+    }
+
+    RecordProperty("skipped", "engine not supported by this machine");
+    std::cerr << "[  SKIPPED ] engine " << static_cast<int>(GetParam())
+              << " is not supported by this machine" << std::endl;
+
+    return true;
+  }
+};
+
+TEST_P(HashPairsTests, CheckDigestsMatchSha256)
+{
+  if (SkipIfUnsupported())
+  {
+    return;
+  }
+
+  // cover the full batches of every engine as well as all the possible remainders
+  for (std::size_t count = 0; count <= 40; ++count)
+  {
+    Buffer const input = GenerateMessages(count);
+    Buffer       output(count * HASH_PAIR_OUTPUT_SIZE);
+
+    HashPairs(GetParam(), input.data(), output.data(), count);
+    ExpectMatchesReference(input, output, count);
+  }
+}
+
+TEST_P(HashPairsTests, CheckLevelCanBeCondensedInPlace)
+{
+  if (SkipIfUnsupported())
+  {
+    return;
+  }
+
+  for (std::size_t count = 1; count <= 40; ++count)
+  {
+    Buffer const input = GenerateMessages(count);
+    Buffer       buffer{input};
+
+    HashPairs(GetParam(), buffer.data(), buffer.data(), count);
+    ExpectMatchesReference(input, buffer, count);
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(Engines, HashPairsTests,
+                        ::testing::Values(HashPairsEngine::SCALAR, HashPairsEngine::SSE2,
+                                          HashPairsEngine::AVX2, HashPairsEngine::SHA_NI), );
+
+TEST(HashPairsTest, CheckParallelDigestsMatchSha256)
+{
+  // small batches are hashed on the calling thread, larger ones are split unevenly across tasks
+  for (std::size_t count : {0u, 1u, 1023u, 4099u, 20011u})
+  {
+    Buffer const input = GenerateMessages(count);
+    Buffer       output(count * HASH_PAIR_OUTPUT_SIZE);
+
+    HashPairsInParallel(input.data(), output.data(), count);
+    ExpectMatchesReference(input, output, count);
+  }
+}
+
+TEST(HashPairsTest, CheckDefaultEngineIsSupported)
+{
+  EXPECT_TRUE(IsSupported(HashPairsEngine::SCALAR));
+  EXPECT_TRUE(IsSupported(GetDefaultHashPairsEngine()));
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+TEST(HashPairsTest, CheckRuntimeDetectionMatchesTheCpu)
+{
+  // the engine used by the build is chosen at runtime, so the detection itself must be right for
+  // the engines above to have been covered on this machine
+  EXPECT_EQ(__builtin_cpu_supports("avx2") != 0, IsSupported(HashPairsEngine::AVX2));
+
+  if (__builtin_cpu_supports("avx2"))
+  {
+    EXPECT_EQ(HashPairsEngine::AVX2, GetDefaultHashPairsEngine());
+  }
+}
+#endif
+
+}  // namespace
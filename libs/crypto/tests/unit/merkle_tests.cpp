@@ -25,6 +25,10 @@
 
 #include "gtest/gtest.h"
 
+#include <cstddef>
+#include <string>
+#include <vector>
+
 using namespace fetch;
 using namespace fetch::crypto;
 
@@ -105,6 +109,41 @@ TEST(crypto_merkle_tree, manual_test_non_log2_count)
   EXPECT_EQ(tree.root(), final);
 }
 
+TEST(crypto_merkle_tree, digest_leaves_match_generic_calculation)
+{
+  for (std::size_t count = 2; count <= 40; ++count)
+  {
+    MerkleTree tree{count};
+
+    std::vector<ConstByteArray> level;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      tree[i] = Hash<crypto::SHA256>(std::to_string(i));
+      level.push_back(tree[i]);
+    }
+
+    // reference: pad up to a power of 2 with empty leaves and condense level by level
+    while ((level.size() & (level.size() - 1)) != 0)
+    {
+      level.emplace_back();
+    }
+
+    while (level.size() > 1)
+    {
+      std::vector<ConstByteArray> parents;
+      for (std::size_t i = 0; i < level.size(); i += 2)
+      {
+        parents.push_back(CalculateHash(level[i], level[i + 1]));
+      }
+
+      level = parents;
+    }
+
+    tree.CalculateRoot();
+    EXPECT_EQ(tree.root(), level[0]) << "Mismatch for " << count << " leaves";
+  }
+}
+
 TEST(crypto_merkle_tree, partially_filled_tree)
 {
   MerkleTree tree{100};
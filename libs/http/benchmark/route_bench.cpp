@@ -0,0 +1,300 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "http/method.hpp"
+#include "http/route.hpp"
+#include "http/route_table.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <functional>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::http::Method;
+using fetch::http::Route;
+using fetch::http::RouteTable;
+using fetch::http::ViewParameters;
+
+namespace {
+
+struct RouteDefinition
+{
+  Method      method;
+  char const *path;
+};
+
+// The routes served by a constellation node
+RouteDefinition const ROUTES[] = {
+    {Method::GET, "/api/logging/"},
+    {Method::POST, "/api/logging/"},
+    {Method::GET, "/api/definitions"},
+    {Method::GET, "/api/telemetry"},
+    {Method::GET, "/api/health/alive"},
+    {Method::GET, "/api/health/ready"},
+    {Method::GET, "/api/status"},
+    {Method::GET, "/api/status/chain"},
+    {Method::GET, "/api/status/backlog"},
+    {Method::GET, "/api/status/states"},
+    {Method::GET, "/api/status/muddle"},
+    {Method::POST, "/api/contract/submit"},
+    {Method::POST, "/api/contract/(digest=[a-fA-F0-9]{64})/"
+                   "(identifier=[1-9A-HJ-NP-Za-km-z]{48,50})/(query=.+)"},
+    {Method::GET, "/api/tx/(digest=[a-fA-F0-9]{64})/"},
+    {Method::POST, "/api/tx"},
+    {Method::GET, "/api/status/tx/(digest=[a-fA-F0-9]{64})"},
+};
+
+char const *const TX_STATUS_REQUEST =
+    "/api/status/tx/0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef";
+
+char const *const CONTRACT_QUERY_REQUEST =
+    "/api/contract/0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef/"
+    "2ifr5dSFRAnXexBMC3HYEVp3JHSuz7KBPXWDRBV4xdFrqGy6R9/balance";
+
+/**
+ * The previous dispatcher: a linear scan over all the routes where every parameter is matched by
+ * copying the remaining path and running the regex engine.
+ */
+class LinearRegexDispatcher
+{
+public:
+  LinearRegexDispatcher()
+  {
+    for (auto const &definition : ROUTES)
+    {
+      routes_.emplace_back(definition.method, Parse(definition.path));
+    }
+  }
+
+  std::size_t Dispatch(Method method, ConstByteArray const &path) const
+  {
+    for (std::size_t index = 0; index < routes_.size(); ++index)
+    {
+      if (routes_[index].first != method)
+      {
+        continue;
+      }
+
+      ViewParameters params;
+      if (Match(routes_[index].second, path, params))
+      {
+        return index;
+      }
+    }
+
+    return routes_.size();
+  }
+
+private:
+  using MatchFunction  = std::function<bool(std::size_t &, ByteArray const &, ViewParameters &)>;
+  using MatchFunctions = std::vector<MatchFunction>;
+
+  static MatchFunctions Parse(ConstByteArray const &path)
+  {
+    MatchFunctions functions;
+
+    std::size_t last = 0;
+    std::size_t i    = 0;
+    while (i < path.size())
+    {
+      if (path[i] == '(')
+      {
+        std::size_t count = 1;
+        std::size_t j     = i + 1;
+        while ((j < path.size()) && (count != 0))
+        {
+          count +=
+              static_cast<std::size_t>(path[j] == '(') - static_cast<std::size_t>(path[j] == ')');
+          ++j;
+        }
+
+        functions.emplace_back(Literal(path.SubArray(last, i - last)));
+
+        auto const param = static_cast<std::string>(path.SubArray(i + 1, j - i - 2));
+        auto const eq    = param.find('=');
+        functions.emplace_back(Parameter(param.substr(0, eq), "^" + param.substr(eq + 1)));
+
+        last = i = j;
+      }
+      else
+      {
+        ++i;
+      }
+    }
+
+    if (last < path.size())
+    {
+      functions.emplace_back(Literal(path.SubArray(last)));
+    }
+
+    return functions;
+  }
+
+  static MatchFunction Literal(ByteArray const &value)
+  {
+    return [value](std::size_t &i, ByteArray const &path, ViewParameters &) {
+      bool ret = path.Match(value, i);
+      if (ret)
+      {
+        i += value.size();
+      }
+      return ret;
+    };
+  }
+
+  static MatchFunction Parameter(ByteArray const &var, std::string const &pattern)
+  {
+    std::regex rgx(pattern);
+    return [rgx, var](std::size_t &i, ByteArray const &path, ViewParameters &params) {
+      std::string s = std::string(path.SubArray(i));
+      std::smatch matches;
+      bool        ret = std::regex_search(s, matches, rgx);
+
+      if (ret)
+      {
+        if (matches.size() != 1)
+        {
+          return false;
+        }
+
+        std::string m = matches[0];
+        params[var]   = path.SubArray(i, m.size());
+        i += m.size();
+      }
+
+      return ret;
+    };
+  }
+
+  static bool Match(MatchFunctions const &functions, ConstByteArray const &path,
+                    ViewParameters &params)
+  {
+    std::size_t i = 0;
+    params.Clear();
+
+    for (auto const &m : functions)
+    {
+      if (!m(i, path, params))
+      {
+        return false;
+      }
+    }
+
+    return (i == path.size());
+  }
+
+  std::vector<std::pair<Method, MatchFunctions>> routes_;
+};
+
+/**
+ * The compiled dispatcher: candidate routes are located via the route table and parameters are
+ * matched with the hand written matchers
+ */
+class CompiledDispatcher
+{
+public:
+  CompiledDispatcher()
+  {
+    for (auto const &definition : ROUTES)
+    {
+      auto route = Route::FromString(definition.path);
+      table_.Add(definition.method, route.prefix(), routes_.size());
+      routes_.emplace_back(std::move(route));
+    }
+  }
+
+  std::size_t Dispatch(Method method, ConstByteArray const &path)
+  {
+    table_.Lookup(method, path, candidates_);
+
+    ViewParameters params;
+    for (auto const index : candidates_)
+    {
+      if (routes_[index].Match(path, params))
+      {
+        return index;
+      }
+    }
+
+    return routes_.size();
+  }
+
+private:
+  std::vector<Route>  routes_;
+  RouteTable          table_;
+  RouteTable::Indices candidates_;
+};
+
+template <typename Dispatcher>
+void Dispatch(benchmark::State &state, Method method, char const *request)
+{
+  Dispatcher           dispatcher;
+  ConstByteArray const path{request};
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(dispatcher.Dispatch(method, path));
+  }
+}
+
+void LinearRegex_TxStatus(benchmark::State &state)
+{
+  Dispatch<LinearRegexDispatcher>(state, Method::GET, TX_STATUS_REQUEST);
+}
+
+void Compiled_TxStatus(benchmark::State &state)
+{
+  Dispatch<CompiledDispatcher>(state, Method::GET, TX_STATUS_REQUEST);
+}
+
+void LinearRegex_ContractQuery(benchmark::State &state)
+{
+  Dispatch<LinearRegexDispatcher>(state, Method::POST, CONTRACT_QUERY_REQUEST);
+}
+
+void Compiled_ContractQuery(benchmark::State &state)
+{
+  Dispatch<CompiledDispatcher>(state, Method::POST, CONTRACT_QUERY_REQUEST);
+}
+
+void LinearRegex_StatusChain(benchmark::State &state)
+{
+  Dispatch<LinearRegexDispatcher>(state, Method::GET, "/api/status/chain");
+}
+
+void Compiled_StatusChain(benchmark::State &state)
+{
+  Dispatch<CompiledDispatcher>(state, Method::GET, "/api/status/chain");
+}
+
+}  // namespace
+
+BENCHMARK(LinearRegex_TxStatus);
+BENCHMARK(Compiled_TxStatus);
+BENCHMARK(LinearRegex_ContractQuery);
+BENCHMARK(Compiled_ContractQuery);
+BENCHMARK(LinearRegex_StatusChain);
+BENCHMARK(Compiled_StatusChain);
@@ -143,10 +143,19 @@ public:
                                             Authenticator const &auth = NormalAccessAuthentication);
   std::vector<UnmountedView> const &views() const;
 
+  /// @name Concurrency
+  /// @{
+  bool IsThreadSafe() const;
+  /// @}
+
+protected:
+  void SetThreadSafe(bool thread_safe);
+
 private:
   std::vector<UnmountedView> views_;
   fetch::variant::Variant    interface_description_;
   std::string                name_;
+  bool                       thread_safe_{false};  ///< Views can be executed concurrently
 };
 }  // namespace http
 }  // namespace fetch
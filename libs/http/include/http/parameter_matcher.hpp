@@ -0,0 +1,57 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <bitset>
+#include <cstddef>
+#include <limits>
+
+namespace fetch {
+namespace http {
+
+/**
+ * A hand written matcher for the common route parameter patterns.
+ *
+ * Supports patterns made of a single character set followed by an optional (greedy) quantifier,
+ * for example `[a-fA-F0-9]{64}`, `[1-9A-HJ-NP-Za-km-z]{48,50}`, `\d+` or `.+`. For these patterns
+ * the result is identical to the anchored regular expression search previously performed, without
+ * copying the remaining path or invoking the regex engine.
+ */
+class ParameterMatcher
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  static constexpr std::size_t UNBOUNDED = std::numeric_limits<std::size_t>::max();
+
+  static bool Compile(ConstByteArray const &pattern, ParameterMatcher &matcher);
+
+  bool Match(ConstByteArray const &path, std::size_t offset, std::size_t &length) const;
+
+private:
+  using CharacterSet = std::bitset<256>;
+
+  CharacterSet allowed_{};
+  std::size_t  min_length_{1};
+  std::size_t  max_length_{1};
+};
+
+}  // namespace http
+}  // namespace fetch
@@ -20,6 +20,7 @@
 #include "core/byte_array/byte_array.hpp"
 #include "core/byte_array/const_byte_array.hpp"
 #include "core/logging.hpp"
+#include "http/parameter_matcher.hpp"
 #include "http/validators.hpp"
 #include "http/view_parameters.hpp"
 
@@ -39,7 +40,7 @@ class Route
 public:
   static constexpr char const *LOGGING_NAME = "HttpRoute";
   using MatchFunction =
-      std::function<bool(std::size_t &, byte_array::ByteArray const &, ViewParameters &)>;
+      std::function<bool(std::size_t &, byte_array::ConstByteArray const &, ViewParameters &)>;
   using MatchingVector = std::vector<MatchFunction>;
   using ParameterList  = std::vector<byte_array::ConstByteArray>;
   using ValidatorMap   = std::unordered_map<byte_array::ConstByteArray, validators::Validator>;
@@ -89,6 +90,10 @@ public:
         }
 
         byte_array::ByteArray match = path.SubArray(last, i - last);
+        if (ret.path_parameters_.empty())
+        {
+          ret.prefix_ = path.SubArray(0, i);
+        }
         ++i;
         byte_array::ByteArray param_pattern = path.SubArray(i, j - i - 1);
 
@@ -109,6 +114,11 @@ public:
       ret.path_.Append(match);
     }
 
+    if (ret.path_parameters_.empty())
+    {
+      ret.prefix_ = path;
+    }
+
     return ret;
   }
 
@@ -122,6 +132,17 @@ public:
     return path_;
   }
 
+  /**
+   * The literal part of the route before the first parameter. Any path matching this route must
+   * start with this prefix.
+   *
+   * @return The literal prefix of the route
+   */
+  byte_array::ConstByteArray const &prefix() const
+  {
+    return prefix_;
+  }
+
   ParameterList path_parameters() const
   {
     return path_parameters_;
@@ -148,14 +169,15 @@ public:
 private:
   void AddMatch(byte_array::ByteArray const &value)
   {
-    match_.push_back([value](std::size_t &i, byte_array::ByteArray const &path, ViewParameters &) {
-      bool ret = path.Match(value, i);
-      if (ret)
-      {
-        i += value.size();
-      }
-      return ret;
-    });
+    match_.push_back(
+        [value](std::size_t &i, byte_array::ConstByteArray const &path, ViewParameters &) {
+          bool ret = path.Match(value, i);
+          if (ret)
+          {
+            i += value.size();
+          }
+          return ret;
+        });
   }
 
   byte_array::ByteArray AddParameter(byte_array::ByteArray const &value)
@@ -173,36 +195,61 @@ private:
     byte_array::ByteArray var = value.SubArray(0, i);
     ++i;
 
-    std::string reg = "^" + std::string(value.SubArray(i, value.size() - i));
+    byte_array::ConstByteArray const pattern = value.SubArray(i, value.size() - i);
 
-    std::regex rgx(reg);
-    match_.push_back(
-        [rgx, var](std::size_t &i, byte_array::ByteArray const &path, ViewParameters &params) {
-          std::string s = std::string(path.SubArray(i));
-          std::smatch matches;
-          bool        ret = std::regex_search(s, matches, rgx);
+    // the common parameter patterns are matched by hand since this avoids copying the remaining
+    // path and running the regex engine for every request
+    ParameterMatcher matcher{};
+    if (ParameterMatcher::Compile(pattern, matcher))
+    {
+      match_.push_back([matcher, var](std::size_t &i, byte_array::ConstByteArray const &path,
+                                      ViewParameters &params) {
+        std::size_t length{0};
+        if (!matcher.Match(path, i, length))
+        {
+          return false;
+        }
 
-          if (ret)
-          {
-            if (matches.size() != 1)
-            {
-              // Ambiguous matches are treated as non-matches.
-              return false;
-            }
+        params[var] = path.SubArray(i, length);
+        i += length;
+
+        return true;
+      });
 
-            std::string m = matches[0];
+      return var;
+    }
 
-            params[var] = path.SubArray(i, m.size());
+    std::regex rgx("^" + static_cast<std::string>(pattern));
+    match_.push_back([rgx, var](std::size_t &i, byte_array::ConstByteArray const &path,
+                                ViewParameters &params) {
+      char const *begin = path.char_pointer() + i;
+      char const *end   = path.char_pointer() + path.size();
 
-            i += m.size();
-          }
+      std::cmatch matches;
+      bool        ret = std::regex_search(begin, end, matches, rgx);
 
-          return ret;
-        });
+      if (ret)
+      {
+        if (matches.size() != 1)
+        {
+          // Ambiguous matches are treated as non-matches.
+          return false;
+        }
+
+        auto const length = static_cast<std::size_t>(matches.length(0));
+
+        params[var] = path.SubArray(i, length);
+
+        i += length;
+      }
+
+      return ret;
+    });
     return var;
   }
 
   byte_array::ByteArray original_;
+  byte_array::ByteArray prefix_;
   byte_array::ByteArray path_;
   MatchingVector        match_;
   ParameterList         path_parameters_;
@@ -0,0 +1,80 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "http/method.hpp"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace http {
+
+/**
+ * A prefix trie of routes keyed on the method and the path segments of the literal prefix of each
+ * route.
+ *
+ * The table does not perform the final route match, instead it narrows down the set of routes
+ * which could possibly match a given request. The candidates are returned in registration order so
+ * that the first matching route is the same as with a linear scan of all the routes.
+ */
+class RouteTable
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using Index          = std::size_t;
+  using Indices        = std::vector<Index>;
+
+  // Construction / Destruction
+  RouteTable()                   = default;
+  RouteTable(RouteTable const &) = delete;
+  RouteTable(RouteTable &&)      = default;
+  ~RouteTable()                  = default;
+
+  void Add(Method method, ConstByteArray const &prefix, Index index);
+  void Lookup(Method method, ConstByteArray const &path, Indices &candidates) const;
+  void Clear();
+
+  // Operators
+  RouteTable &operator=(RouteTable const &) = delete;
+  RouteTable &operator=(RouteTable &&) = default;
+
+private:
+  struct Node
+  {
+    using NodePtr  = std::unique_ptr<Node>;
+    using Child    = std::pair<ConstByteArray, NodePtr>;
+    using Children = std::vector<Child>;
+
+    Node *Find(ConstByteArray const &path, std::size_t start, std::size_t length) const;
+
+    Children children;  ///< The child nodes keyed on the next path segment
+    Indices  routes;    ///< The routes whose literal prefix terminates at this node
+  };
+
+  using Roots = std::map<Method, Node>;
+
+  Roots roots_;
+};
+
+}  // namespace http
+}  // namespace fetch
@@ -28,10 +28,17 @@
 #include "http/request.hpp"
 #include "http/response.hpp"
 #include "http/route.hpp"
+#include "http/route_table.hpp"
 #include "http/status.hpp"
+#include "network/details/thread_pool.hpp"
 #include "network/fetch_asio.hpp"
 #include "network/management/network_manager.hpp"
+#include "telemetry/gauge.hpp"
+#include "telemetry/histogram.hpp"
+#include "telemetry/registry.hpp"
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <functional>
@@ -39,6 +46,7 @@
 #include <mutex>
 #include <new>
 #include <system_error>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -54,13 +62,17 @@ public:
   using Socket            = asio::ip::tcp::tcp::socket;
   using Acceptor          = asio::ip::tcp::tcp::acceptor;
   using ConnectionManager = HTTPConnectionManager;
+  using ThreadPool        = network::ThreadPool;
+  using Clock             = std::chrono::steady_clock;
+  using Timestamp         = Clock::time_point;
 
   using RequestMiddleware  = std::function<void(HTTPRequest &)>;
   using ViewType           = typename HTTPModule::ViewType;
   using Authenticator      = typename HTTPModule::Authenticator;
   using ResponseMiddleware = std::function<void(HTTPResponse &, HTTPRequest const &)>;
 
-  static constexpr char const *LOGGING_NAME = "HTTPServer";
+  static constexpr char const *LOGGING_NAME        = "HTTPServer";
+  static constexpr std::size_t DEFAULT_NUM_WORKERS = 4;
 
   struct MountedView
   {
@@ -69,14 +81,28 @@ public:
     Route                      route;
     ViewType                   view;
     Authenticator              authenticator;
+    bool                       thread_safe;
   };
 
-  explicit HTTPServer(NetworkManager const &network_manager)
+  /**
+   * Construct the HTTP server
+   *
+   * @param network_manager The network manager used to service the connections
+   * @param num_workers The number of worker threads used to execute the views
+   */
+  explicit HTTPServer(NetworkManager const &network_manager,
+                      std::size_t           num_workers = DEFAULT_NUM_WORKERS)
     : networkManager_(network_manager)
-  {}
+    , worker_pool_{network::MakeThreadPool(num_workers, "HTTP")}
+  {
+    worker_pool_->Start();
+  }
 
   virtual ~HTTPServer()
   {
+    // ensure no views are being executed while the server is torn down
+    worker_pool_->Stop();
+
     auto socketWeak = socket_;
     auto accepWeak  = acceptor_;
 
@@ -121,14 +147,109 @@ public:
   }
 
   void Stop()
-  {}
+  {
+    worker_pool_->Stop();
+    queue_depth_->set(0);
+
+    FETCH_LOCK(pending_mutex_);
+    pending_.clear();
+  }
 
   void PushRequest(HandleType client, HTTPRequest req) override
+  {
+    // dispatch the request onto the worker pool so that slow views do not block the network
+    // threads or each other. Requests from the same connection are processed one at a time and in
+    // the order they were received, so that the responses to pipelined requests are not reordered
+    bool schedule{false};
+    {
+      FETCH_LOCK(pending_mutex_);
+
+      auto &queue = pending_[client];
+      schedule    = queue.empty();
+      queue.push_back(PendingRequest{std::move(req), Clock::now()});
+    }
+
+    queue_depth_->increment();
+
+    if (schedule)
+    {
+      worker_pool_->Post([this, client]() { ProcessNextRequest(client); });
+    }
+  }
+
+  /**
+   * Process the request at the front of the queue of a client. The request stays at the front of
+   * the queue until it has been responded to, which prevents any later request from the same client
+   * being scheduled in the meantime. Called from the worker pool.
+   *
+   * @param client The handle of the client whose next request should be processed
+   */
+  void ProcessNextRequest(HandleType client)
+  {
+    PendingRequest pending{};
+    {
+      FETCH_LOCK(pending_mutex_);
+
+      auto it = pending_.find(client);
+      if ((it == pending_.end()) || it->second.empty())
+      {
+        return;
+      }
+
+      pending = std::move(it->second.front());
+    }
+
+    queue_depth_->decrement();
+
+    Timestamp const started = Clock::now();
+    queue_duration_->Add(ToSeconds(started - pending.queued));
+
+    ProcessRequest(client, pending.request);
+
+    request_duration_->Add(ToSeconds(Clock::now() - started));
+
+    // schedule the next request from this client (if any)
+    bool schedule{false};
+    {
+      FETCH_LOCK(pending_mutex_);
+
+      auto it = pending_.find(client);
+      if (it != pending_.end())
+      {
+        it->second.pop_front();
+
+        if (it->second.empty())
+        {
+          pending_.erase(it);
+        }
+        else
+        {
+          schedule = true;
+        }
+      }
+    }
+
+    if (schedule)
+    {
+      worker_pool_->Post([this, client]() { ProcessNextRequest(client); });
+    }
+  }
+
+  /**
+   * Execute the middleware and the matching view for a request and send the response back to the
+   * client. Called from the worker pool.
+   *
+   * Views from modules which have not opted in to concurrent execution are serialised with respect
+   * to each other, while thread safe views (and all middleware) run in parallel.
+   *
+   * @param client The handle of the client which made the request
+   * @param req The request to process
+   */
+  void ProcessRequest(HandleType client, HTTPRequest &req)
   {
     // TODO(issue 35): Need to actually add better support for the options here
     if (req.method() == Method::OPTIONS)
     {
-
       HTTPResponse res("", fetch::http::mime_types::GetMimeTypeFromExtension(".html"),
                        Status::SUCCESS_OK);
       res.AddHeader("Access-Control-Allow-Origin", "*");
@@ -140,8 +261,6 @@ public:
       return;
     }
 
-    // TODO(issue 28): improve such that it works for multiple threads.
-    FETCH_LOCK(eval_mutex_);
     HTTPResponse res("page not found", mime_types::GetMimeTypeFromExtension(".html"),
                      Status::CLIENT_ERROR_NOT_FOUND);
 
@@ -155,15 +274,15 @@ public:
         m(req);
       }
 
+      // lookup the views which could possibly match the URL
+      RouteTable::Indices candidates;
+      route_table_.Lookup(req.method(), req.uri(), candidates);
+
       // finding the view that matches the URL
       ViewParameters params;
-      for (auto &v : views_)
+      for (auto const index : candidates)
       {
-        // skip all views that don't match the required method
-        if (v.method != req.method())
-        {
-          continue;
-        }
+        auto &v = views_[index];
 
         if (v.route.Match(req.uri(), params))
         {
@@ -178,7 +297,15 @@ public:
           }
 
           // generating result
-          res = v.view(params, req);
+          if (v.thread_safe)
+          {
+            res = v.view(params, req);
+          }
+          else
+          {
+            FETCH_LOCK(eval_mutex_);
+            res = v.view(params, req);
+          }
           break;
         }
       }
@@ -249,7 +376,7 @@ public:
 
   void AddView(byte_array::ConstByteArray description, Method method,
                byte_array::ByteArray const &path, std::vector<HTTPParameter> const &parameters,
-               ViewType const &view, Authenticator authenticator)
+               ViewType const &view, Authenticator authenticator, bool thread_safe = false)
   {
     auto route = Route::FromString(path);
 
@@ -260,8 +387,9 @@ public:
       route.AddValidator(param.name, std::move(v));
     }
 
-    views_.push_back(
-        {std::move(description), method, std::move(route), view, std::move(authenticator)});
+    route_table_.Add(method, route.prefix(), views_.size());
+    views_.push_back({std::move(description), method, std::move(route), view,
+                      std::move(authenticator), thread_safe});
   }
 
   void AddModule(HTTPModule const &module)
@@ -269,7 +397,7 @@ public:
     for (auto const &view : module.views())
     {
       this->AddView(view.description, view.method, view.route, view.parameters, view.view,
-                    view.authenticator);
+                    view.authenticator, module.IsThreadSafe());
     }
   }
 
@@ -285,10 +413,27 @@ public:
   }
 
 private:
-  std::mutex eval_mutex_;
+  struct PendingRequest
+  {
+    HTTPRequest request;
+    Timestamp   queued;
+  };
+
+  using PendingQueue  = std::deque<PendingRequest>;
+  using PendingQueues  = std::unordered_map<HandleType, PendingQueue>;
+
+  static double ToSeconds(Clock::duration const &duration)
+  {
+    return std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+  }
+
+  std::mutex    eval_mutex_;     ///< Serialises the execution of non thread safe views
+  std::mutex    pending_mutex_;  ///< Protects the pending requests
+  PendingQueues pending_;        ///< The requests waiting to be processed, for each client
 
   std::vector<RequestMiddleware>  pre_view_middleware_;
   std::vector<MountedView>        views_;
+  RouteTable                      route_table_;
   std::vector<ResponseMiddleware> post_view_middleware_;
 
   NetworkManager                     networkManager_;
@@ -296,6 +441,21 @@ private:
   std::weak_ptr<Acceptor>            acceptor_;
   std::weak_ptr<Socket>              socket_;
   std::shared_ptr<ConnectionManager> manager_{std::make_shared<ConnectionManager>(*this)};
+  ThreadPool                         worker_pool_;
+
+  /// @name Telemetry
+  /// @{
+  telemetry::GaugePtr<uint64_t> queue_depth_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
+      "http_server_request_queue_depth", "The number of HTTP requests waiting for a worker")};
+  telemetry::HistogramPtr queue_duration_{telemetry::Registry::Instance().CreateHistogram(
+      {0.0001, 0.0005, 0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1., 5.},
+      "http_server_request_queue_duration_seconds",
+      "Histogram of the time HTTP requests wait for a worker")};
+  telemetry::HistogramPtr request_duration_{telemetry::Registry::Instance().CreateHistogram(
+      {0.0001, 0.0005, 0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1., 5., 10.},
+      "http_server_request_duration_seconds",
+      "Histogram of the time taken to process HTTP requests")};
+  /// @}
 };
 }  // namespace http
 }  // namespace fetch
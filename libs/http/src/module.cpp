@@ -186,5 +186,29 @@ std::vector<HTTPModule::UnmountedView> const &HTTPModule::views() const
   return views_;
 }
 
+/**
+ * Determine if the views of this module can be executed concurrently by the HTTP server
+ *
+ * @return true if the views are thread safe, otherwise false
+ */
+bool HTTPModule::IsThreadSafe() const
+{
+  return thread_safe_;
+}
+
+/**
+ * Opt in (or out) of concurrent execution of the views of this module.
+ *
+ * By default all views are executed serially by the HTTP server. Modules whose views only access
+ * thread safe resources (for example read only queries) should signal this so that their requests
+ * can be processed in parallel.
+ *
+ * @param thread_safe Flag to signal the views of this module are thread safe
+ */
+void HTTPModule::SetThreadSafe(bool thread_safe)
+{
+  thread_safe_ = thread_safe;
+}
+
 }  // namespace http
 }  // namespace fetch
@@ -0,0 +1,300 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "http/parameter_matcher.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+namespace fetch {
+namespace http {
+namespace {
+
+using CharacterSet = std::bitset<256>;
+
+void AddRange(CharacterSet &set, uint8_t first, uint8_t last)
+{
+  for (std::size_t c = first; c <= last; ++c)
+  {
+    set.set(c);
+  }
+}
+
+bool IsDigit(uint8_t c)
+{
+  return (c >= '0') && (c <= '9');
+}
+
+/**
+ * Parse a decimal number from the pattern
+ *
+ * @param pattern The pattern being parsed
+ * @param pos The current position, updated on success
+ * @param value The output value
+ * @return true if successful, otherwise false
+ */
+bool ParseNumber(byte_array::ConstByteArray const &pattern, std::size_t &pos, std::size_t &value)
+{
+  std::size_t const start = pos;
+
+  value = 0;
+  while ((pos < pattern.size()) && IsDigit(pattern[pos]))
+  {
+    value = (value * 10u) + static_cast<std::size_t>(pattern[pos] - '0');
+    ++pos;
+  }
+
+  return pos != start;
+}
+
+/**
+ * Parse the character set at the start of the pattern. Supported forms are `.`, `\d`, `\w` and
+ * bracket expressions made up of literal characters and ranges.
+ *
+ * @param pattern The pattern being parsed
+ * @param pos The current position, updated on success
+ * @param set The output character set
+ * @return true if successful, otherwise false
+ */
+bool ParseCharacterSet(byte_array::ConstByteArray const &pattern, std::size_t &pos,
+                       CharacterSet &set)
+{
+  if (pos >= pattern.size())
+  {
+    return false;
+  }
+
+  uint8_t const c = pattern[pos];
+  if (c == '.')
+  {
+    // in ECMAScript mode the wildcard matches everything apart from the line terminators
+    set.set();
+    set.reset('\n');
+    set.reset('\r');
+    ++pos;
+
+    return true;
+  }
+
+  if (c == '\\')
+  {
+    if (pos + 1 >= pattern.size())
+    {
+      return false;
+    }
+
+    switch (pattern[pos + 1])
+    {
+    case 'd':
+      AddRange(set, '0', '9');
+      break;
+    case 'w':
+      AddRange(set, '0', '9');
+      AddRange(set, 'a', 'z');
+      AddRange(set, 'A', 'Z');
+      set.set('_');
+      break;
+    default:
+      return false;
+    }
+
+    pos += 2;
+    return true;
+  }
+
+  if (c != '[')
+  {
+    return false;
+  }
+
+  std::size_t i = pos + 1;
+
+  // negated sets and nested classes are left to the regex engine
+  if ((i >= pattern.size()) || (pattern[i] == '^'))
+  {
+    return false;
+  }
+
+  while ((i < pattern.size()) && (pattern[i] != ']'))
+  {
+    uint8_t const first = pattern[i];
+    if ((first == '\\') || (first == '['))
+    {
+      return false;
+    }
+
+    // determine if this is a range or a single character
+    if ((i + 2 < pattern.size()) && (pattern[i + 1] == '-') && (pattern[i + 2] != ']'))
+    {
+      uint8_t const last = pattern[i + 2];
+      if ((last == '\\') || (last == '[') || (last < first))
+      {
+        return false;
+      }
+
+      AddRange(set, first, last);
+      i += 3;
+    }
+    else
+    {
+      set.set(first);
+      ++i;
+    }
+  }
+
+  // ensure the set is both closed and not empty
+  if ((i >= pattern.size()) || (i == pos + 1))
+  {
+    return false;
+  }
+
+  pos = i + 1;
+  return true;
+}
+
+/**
+ * Parse the (optional) greedy quantifier following the character set
+ *
+ * @param pattern The pattern being parsed
+ * @param pos The current position, updated on success
+ * @param min_length The output minimum number of repetitions
+ * @param max_length The output maximum number of repetitions
+ * @return true if successful, otherwise false
+ */
+bool ParseQuantifier(byte_array::ConstByteArray const &pattern, std::size_t &pos,
+                     std::size_t &min_length, std::size_t &max_length)
+{
+  min_length = 1;
+  max_length = 1;
+
+  if (pos >= pattern.size())
+  {
+    return true;
+  }
+
+  switch (pattern[pos])
+  {
+  case '+':
+    max_length = ParameterMatcher::UNBOUNDED;
+    ++pos;
+    break;
+
+  case '*':
+    min_length = 0;
+    max_length = ParameterMatcher::UNBOUNDED;
+    ++pos;
+    break;
+
+  case '{':
+    ++pos;
+    if (!ParseNumber(pattern, pos, min_length))
+    {
+      return false;
+    }
+
+    max_length = min_length;
+    if ((pos < pattern.size()) && (pattern[pos] == ','))
+    {
+      ++pos;
+      if (!ParseNumber(pattern, pos, max_length))
+      {
+        max_length = ParameterMatcher::UNBOUNDED;
+      }
+    }
+
+    if ((pos >= pattern.size()) || (pattern[pos] != '}') || (max_length < min_length))
+    {
+      return false;
+    }
+    ++pos;
+    break;
+
+  default:
+    return false;
+  }
+
+  return true;
+}
+
+}  // namespace
+
+/**
+ * Attempt to compile the specified regular expression into a hand written matcher
+ *
+ * @param pattern The regular expression for the parameter
+ * @param matcher The output matcher
+ * @return true if the pattern is supported, otherwise false (and the regex engine should be used)
+ */
+bool ParameterMatcher::Compile(ConstByteArray const &pattern, ParameterMatcher &matcher)
+{
+  std::size_t pos{0};
+
+  CharacterSet allowed{};
+  std::size_t  min_length{0};
+  std::size_t  max_length{0};
+
+  if (!ParseCharacterSet(pattern, pos, allowed))
+  {
+    return false;
+  }
+
+  if (!ParseQuantifier(pattern, pos, min_length, max_length))
+  {
+    return false;
+  }
+
+  // lazy quantifiers, alternations, groups, etc. are all unsupported
+  if (pos != pattern.size())
+  {
+    return false;
+  }
+
+  matcher.allowed_    = allowed;
+  matcher.min_length_ = min_length;
+  matcher.max_length_ = max_length;
+
+  return true;
+}
+
+/**
+ * Greedily match the parameter against the path at the specified offset
+ *
+ * @param path The path being matched
+ * @param offset The offset into the path where the parameter starts
+ * @param length The output length of the matched parameter
+ * @return true if the parameter matched, otherwise false
+ */
+bool ParameterMatcher::Match(ConstByteArray const &path, std::size_t offset,
+                             std::size_t &length) const
+{
+  std::size_t const available = (offset < path.size()) ? path.size() - offset : 0;
+  std::size_t const limit     = std::min(available, max_length_);
+
+  length = 0;
+  while ((length < limit) && allowed_.test(path[offset + length]))
+  {
+    ++length;
+  }
+
+  return length >= min_length_;
+}
+
+}  // namespace http
+}  // namespace fetch
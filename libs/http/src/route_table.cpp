@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "http/route_table.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace fetch {
+namespace http {
+
+/**
+ * Register a route with the table
+ *
+ * Only the complete segments (terminated by a '/') of the prefix are used as keys in the trie,
+ * since any trailing partial segment could be extended by a parameter.
+ *
+ * @param method The method of the route
+ * @param prefix The literal prefix of the route (before any parameter)
+ * @param index The index of the route which is returned from lookups
+ */
+void RouteTable::Add(Method method, ConstByteArray const &prefix, Index index)
+{
+  Node *node = &roots_[method];
+
+  std::size_t start{0};
+  for (;;)
+  {
+    std::size_t const end = prefix.Find('/', start);
+    if (end == ConstByteArray::NPOS)
+    {
+      break;
+    }
+
+    Node *child = node->Find(prefix, start, end - start);
+    if (child == nullptr)
+    {
+      node->children.emplace_back(prefix.SubArray(start, end - start), std::make_unique<Node>());
+      child = node->children.back().second.get();
+    }
+
+    node  = child;
+    start = end + 1;
+  }
+
+  node->routes.push_back(index);
+}
+
+/**
+ * Determine the set of routes which could match the specified path
+ *
+ * @param method The method of the request
+ * @param path The path of the request
+ * @param candidates The output set of candidate routes, in registration order
+ */
+void RouteTable::Lookup(Method method, ConstByteArray const &path, Indices &candidates) const
+{
+  candidates.clear();
+
+  auto const root = roots_.find(method);
+  if (root == roots_.end())
+  {
+    return;
+  }
+
+  Node const *node = &root->second;
+  candidates.insert(candidates.end(), node->routes.begin(), node->routes.end());
+
+  std::size_t start{0};
+  for (;;)
+  {
+    std::size_t const end = path.Find('/', start);
+    if (end == ConstByteArray::NPOS)
+    {
+      break;
+    }
+
+    node = node->Find(path, start, end - start);
+    if (node == nullptr)
+    {
+      break;
+    }
+
+    candidates.insert(candidates.end(), node->routes.begin(), node->routes.end());
+
+    start = end + 1;
+  }
+
+  // restore the registration order
+  std::sort(candidates.begin(), candidates.end());
+}
+
+/**
+ * Locate the child node for the specified path segment. The number of children for each node is
+ * typically small so a linear search (which does not need to allocate) is used.
+ *
+ * @param path The path containing the segment
+ * @param start The start of the segment in the path
+ * @param length The length of the segment
+ * @return The child node if found, otherwise nullptr
+ */
+RouteTable::Node *RouteTable::Node::Find(ConstByteArray const &path, std::size_t start,
+                                         std::size_t length) const
+{
+  for (auto const &child : children)
+  {
+    if ((child.first.size() == length) && path.Match(child.first, start))
+    {
+      return child.second.get();
+    }
+  }
+
+  return nullptr;
+}
+
+/**
+ * Remove all the routes from the table
+ */
+void RouteTable::Clear()
+{
+  roots_.clear();
+}
+
+}  // namespace http
+}  // namespace fetch
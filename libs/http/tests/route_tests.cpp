@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "http/parameter_matcher.hpp"
+#include "http/route.hpp"
+#include "http/route_table.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::http::Method;
+using fetch::http::ParameterMatcher;
+using fetch::http::Route;
+using fetch::http::RouteTable;
+using fetch::http::ViewParameters;
+
+// Reference implementation using the regex engine
+bool RegexMatch(std::string const &pattern, std::string const &path, std::size_t &length)
+{
+  std::regex  rgx("^" + pattern);
+  std::smatch matches;
+
+  if (std::regex_search(path, matches, rgx))
+  {
+    length = static_cast<std::size_t>(matches.length(0));
+    return true;
+  }
+
+  return false;
+}
+
+TEST(ParameterMatcherTests, CommonPatternsMatchRegex)
+{
+  std::vector<std::string> const patterns = {
+      "[a-fA-F0-9]{64}", "[1-9A-HJ-NP-Za-km-z]{48,50}", "\\d+", ".+", "[a-z]*", "[-a]{2,}", "\\w{3}",
+  };
+
+  std::vector<std::string> const paths = {
+      "",
+      "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef",
+      "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdeX",
+      "0123456789ABCDEF0123456789abcdef0123456789abcdef0123456789abcdef/query",
+      "2ifr5dSFRAnXexBMC3HYEVp3JHSuz7KBPXWDRBV4xdFrqGy6R9",
+      "2ifr5dSFRAnXexBMC3HYEVp3JHSuz7KBPXWDRBV4xdFrqGy6R9ab",
+      "2ifr5dSFRAnXexBMC3HYEVp3JHSuz7KBPXWDRBV4xd0",
+      "12345/foo",
+      "abc\ndef",
+      "a-a-b",
+      "w_1x",
+  };
+
+  for (auto const &pattern : patterns)
+  {
+    ParameterMatcher matcher{};
+    ASSERT_TRUE(ParameterMatcher::Compile(pattern, matcher)) << pattern;
+
+    for (auto const &path : paths)
+    {
+      std::size_t expected_length{0};
+      bool const  expected = RegexMatch(pattern, path, expected_length);
+
+      std::size_t length{0};
+      EXPECT_EQ(expected, matcher.Match(path, 0, length)) << pattern << " " << path;
+
+      if (expected)
+      {
+        EXPECT_EQ(expected_length, length) << pattern << " " << path;
+      }
+    }
+  }
+}
+
+TEST(ParameterMatcherTests, UnsupportedPatternsAreRejected)
+{
+  std::vector<std::string> const patterns = {
+      "[^a]+", "(a|b)", "a+", "[a-z]+?", "[a-z]{3", "[]", "\\s+", "[a-z]+[0-9]+",
+  };
+
+  for (auto const &pattern : patterns)
+  {
+    ParameterMatcher matcher{};
+    EXPECT_FALSE(ParameterMatcher::Compile(pattern, matcher)) << pattern;
+  }
+}
+
+TEST(RouteTests, ParametersAreExtracted)
+{
+  auto route = Route::FromString(
+      "/api/contract/(digest=[a-fA-F0-9]{64})/(identifier=[1-9A-HJ-NP-Za-km-z]{48,50})/"
+      "(query=.+)");
+
+  EXPECT_EQ(route.prefix(), "/api/contract/");
+
+  std::string const digest(64, 'a');
+  std::string const identifier = "2ifr5dSFRAnXexBMC3HYEVp3JHSuz7KBPXWDRBV4xdFrqGy6R9";
+
+  ViewParameters params;
+  ASSERT_TRUE(route.Match("/api/contract/" + digest + "/" + identifier + "/balance", params));
+  EXPECT_EQ(params["digest"], digest);
+  EXPECT_EQ(params["identifier"], identifier);
+  EXPECT_EQ(params["query"], "balance");
+
+  EXPECT_FALSE(route.Match("/api/contract/" + digest + "/" + identifier + "/", params));
+  EXPECT_FALSE(route.Match("/api/contract/" + digest + "/foo/balance", params));
+}
+
+TEST(RouteTests, RegexFallbackForUnsupportedPatterns)
+{
+  auto route = Route::FromString("/api/item/(id=(foo|bar)[0-9]+)");
+
+  ViewParameters params;
+  EXPECT_FALSE(route.Match("/api/item/bar12", params));  // ambiguous (sub-matches) as before
+  EXPECT_FALSE(route.Match("/api/item/baz12", params));
+
+  auto simple = Route::FromString("/api/item/(id=[a-z]+[0-9]+)");
+  ASSERT_TRUE(simple.Match("/api/item/bar12", params));
+  EXPECT_EQ(params["id"], "bar12");
+}
+
+TEST(RouteTableTests, CandidatesAreInRegistrationOrder)
+{
+  RouteTable table;
+  table.Add(Method::GET, "/api/status/tx/", 0);
+  table.Add(Method::GET, "/api/status", 1);
+  table.Add(Method::GET, "/api/tx/", 2);
+  table.Add(Method::POST, "/api/tx", 3);
+  table.Add(Method::GET, "/api/status/", 4);
+  table.Add(Method::GET, "", 5);
+
+  RouteTable::Indices candidates;
+
+  table.Lookup(Method::GET, "/api/status/tx/abcd", candidates);
+  EXPECT_EQ(candidates, (RouteTable::Indices{0, 1, 4, 5}));
+
+  table.Lookup(Method::GET, "/api/status", candidates);
+  EXPECT_EQ(candidates, (RouteTable::Indices{1, 5}));
+
+  table.Lookup(Method::GET, "/api/tx/abcd", candidates);
+  EXPECT_EQ(candidates, (RouteTable::Indices{1, 2, 5}));
+
+  table.Lookup(Method::POST, "/api/tx", candidates);
+  EXPECT_EQ(candidates, (RouteTable::Indices{3}));
+
+  table.Lookup(Method::DELETE, "/api/tx", candidates);
+  EXPECT_TRUE(candidates.empty());
+}
+
+}  // namespace
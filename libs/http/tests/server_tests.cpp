@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "http/server.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::http::HTTPRequest;
+using fetch::http::HTTPResponse;
+using fetch::http::HTTPServer;
+using fetch::http::Method;
+using fetch::http::ViewParameters;
+using fetch::network::NetworkManager;
+
+using namespace std::chrono_literals;
+
+class HTTPServerTests : public ::testing::Test
+{
+protected:
+  static constexpr std::size_t NUM_WORKERS  = 4;
+  static constexpr std::size_t NUM_REQUESTS = 4;
+
+  void SetUp() override
+  {
+    network_manager_ = std::make_unique<NetworkManager>("NetMgr", 1);
+    server_          = std::make_unique<HTTPServer>(*network_manager_, NUM_WORKERS);
+  }
+
+  void TearDown() override
+  {
+    server_.reset();
+    network_manager_.reset();
+  }
+
+  void AddSlowView(bool thread_safe)
+  {
+    server_->AddView("slow view", Method::GET, "/slow", {},
+                     [this](ViewParameters const &, HTTPRequest const &request) {
+                       std::size_t const current = ++active_;
+
+                       {
+                         std::lock_guard<std::mutex> lock(order_mutex_);
+                         order_.emplace_back(static_cast<std::string>(request.body()));
+                       }
+
+                       // track the peak level of concurrency
+                       std::size_t peak = peak_;
+                       while ((current > peak) && !peak_.compare_exchange_weak(peak, current))
+                       {
+                       }
+
+                       std::this_thread::sleep_for(50ms);
+
+                       --active_;
+                       ++completed_;
+
+                       return HTTPResponse("done");
+                     },
+                     [](HTTPRequest const &) { return true; }, thread_safe);
+  }
+
+  void PushRequests(bool same_client = false)
+  {
+    for (std::size_t i = 0; i < NUM_REQUESTS; ++i)
+    {
+      HTTPRequest request;
+      request.SetMethod(Method::GET);
+      request.SetURI("/slow");
+      request.SetBody(std::to_string(i));
+
+      server_->PushRequest(same_client ? 0 : i, request);
+    }
+  }
+
+  bool WaitForCompletion()
+  {
+    for (std::size_t i = 0; i < 200; ++i)
+    {
+      if (completed_ >= NUM_REQUESTS)
+      {
+        return true;
+      }
+
+      std::this_thread::sleep_for(10ms);
+    }
+
+    return false;
+  }
+
+  std::unique_ptr<NetworkManager> network_manager_;
+  std::unique_ptr<HTTPServer>     server_;
+  std::atomic<std::size_t>        active_{0};
+  std::atomic<std::size_t>        peak_{0};
+  std::atomic<std::size_t>        completed_{0};
+  std::mutex                      order_mutex_;
+  std::vector<std::string>        order_;
+};
+
+TEST_F(HTTPServerTests, ThreadSafeViewsExecuteConcurrently)
+{
+  AddSlowView(true);
+  PushRequests();
+
+  ASSERT_TRUE(WaitForCompletion());
+  EXPECT_GT(peak_.load(), 1u);
+}
+
+TEST_F(HTTPServerTests, ViewsAreSerialisedByDefault)
+{
+  AddSlowView(false);
+  PushRequests();
+
+  ASSERT_TRUE(WaitForCompletion());
+  EXPECT_EQ(peak_.load(), 1u);
+}
+
+TEST_F(HTTPServerTests, RequestsFromOneClientAreProcessedInOrder)
+{
+  AddSlowView(true);
+  PushRequests(true);
+
+  ASSERT_TRUE(WaitForCompletion());
+  EXPECT_EQ(peak_.load(), 1u);
+
+  std::vector<std::string> const expected{"0", "1", "2", "3"};
+  EXPECT_EQ(order_, expected);
+}
+
+}  // namespace
@@ -0,0 +1,153 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "ledger/block_packer_interface.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/main_chain.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "miner/annealer_miner.hpp"
+#include "miner/basic_miner.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::ledger::Block;
+using fetch::ledger::BlockPackerInterface;
+using fetch::ledger::MainChain;
+using fetch::ledger::TransactionLayout;
+using fetch::miner::AnnealerMiner;
+using fetch::miner::BasicMiner;
+using fetch::random::LinearCongruentialGenerator;
+
+using Layouts        = std::vector<TransactionLayout>;
+using BlockPackerPtr = std::unique_ptr<BlockPackerInterface>;
+
+constexpr uint32_t    LOG2_NUM_LANES = 4;
+constexpr std::size_t NUM_LANES      = 1u << LOG2_NUM_LANES;
+constexpr std::size_t NUM_SLICES     = 16;
+
+constexpr std::chrono::milliseconds ANNEALER_BUDGET{20};
+
+Layouts GenerateLayouts(std::size_t count)
+{
+  LinearCongruentialGenerator rng{};
+
+  Layouts layouts{};
+  layouts.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ByteArray digest{};
+    digest.Resize(32);
+
+    auto *raw = reinterpret_cast<uint64_t *>(digest.pointer());
+    for (std::size_t j = 0; j < 4; ++j)
+    {
+      raw[j] = rng();
+    }
+
+    // each transaction uses between 1 and 4 lanes (the low bits of the LCG are poorly distributed)
+    BitVector         mask{NUM_LANES};
+    std::size_t const num_resources = 1u + ((rng() >> 32u) % 4u);
+    for (std::size_t j = 0; j < num_resources; ++j)
+    {
+      mask.set((rng() >> 32u) % NUM_LANES, 1);
+    }
+
+    layouts.emplace_back(digest, mask, 1u + ((rng() >> 32u) % 10000u), 0, 1000);
+  }
+
+  return layouts;
+}
+
+/**
+ * Pack a single block from a freshly populated pool for each iteration, reporting the average fee
+ * and lane occupancy of the generated blocks
+ */
+template <typename Factory>
+void PackBlock(benchmark::State &state, Factory &&factory)
+{
+  auto const layouts = GenerateLayouts(static_cast<std::size_t>(state.range(0)));
+
+  MainChain chain{false, MainChain::Mode::IN_MEMORY_DB};
+
+  double total_fee{0};
+  double total_occupancy{0};
+
+  BlockPackerPtr packer{};
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    packer = factory();
+    for (auto const &layout : layouts)
+    {
+      packer->EnqueueTransaction(layout);
+    }
+
+    Block block{};
+    block.body.previous_hash = chain.GetHeaviestBlockHash();
+    state.ResumeTiming();
+
+    packer->GenerateBlock(block, NUM_LANES, NUM_SLICES, chain);
+
+    state.PauseTiming();
+    for (auto const &slice : block.body.slices)
+    {
+      for (auto const &layout : slice)
+      {
+        total_fee += static_cast<double>(layout.charge());
+        total_occupancy += static_cast<double>(layout.mask().PopCount());
+      }
+    }
+
+    // exclude the destruction of the packer from the timings
+    packer.reset();
+    state.ResumeTiming();
+  }
+
+  auto const iterations       = static_cast<double>(state.iterations());
+  state.counters["fee"]       = total_fee / iterations;
+  state.counters["occupancy"] = total_occupancy / (iterations * NUM_LANES * NUM_SLICES);
+}
+
+void BlockPacker_Basic(benchmark::State &state)
+{
+  PackBlock(state, [] { return std::make_unique<BasicMiner>(LOG2_NUM_LANES); });
+}
+
+void BlockPacker_Annealer(benchmark::State &state)
+{
+  PackBlock(state, [] { return std::make_unique<AnnealerMiner>(LOG2_NUM_LANES, ANNEALER_BUDGET); });
+}
+
+}  // namespace
+
+BENCHMARK(BlockPacker_Basic)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BlockPacker_Annealer)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,180 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/digest.hpp"
+#include "core/random/lcg.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "miner/lane_indexed_pool.hpp"
+#include "miner/transaction_layout_queue.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::ledger::Block;
+using fetch::ledger::TransactionLayout;
+using fetch::miner::LaneIndexedPool;
+using fetch::miner::TransactionLayoutQueue;
+using fetch::random::LinearCongruentialGenerator;
+
+using Layouts = std::vector<TransactionLayout>;
+
+constexpr std::size_t NUM_LANES  = 16;
+constexpr std::size_t NUM_SLICES = 16;
+
+Layouts GenerateLayouts(std::size_t count)
+{
+  LinearCongruentialGenerator rng{};
+
+  Layouts layouts{};
+  layouts.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ByteArray digest{};
+    digest.Resize(32);
+
+    auto *raw = reinterpret_cast<uint64_t *>(digest.pointer());
+    for (std::size_t j = 0; j < 4; ++j)
+    {
+      raw[j] = rng();
+    }
+
+    // each transaction uses between 1 and 3 lanes
+    BitVector         mask{NUM_LANES};
+    std::size_t const num_resources = 1u + (rng() % 3u);
+    for (std::size_t j = 0; j < num_resources; ++j)
+    {
+      mask.set(rng() % NUM_LANES, 1);
+    }
+
+    layouts.emplace_back(digest, mask, 1u + (rng() % 10000u), 0, 1000);
+  }
+
+  return layouts;
+}
+
+/**
+ * The previous packing strategy: sort the whole queue by fee and then scan it from the start for
+ * every slice
+ */
+void PackSlices(TransactionLayoutQueue &queue, Block::Body &body)
+{
+  queue.Sort([](TransactionLayout const &a, TransactionLayout const &b) {
+    return a.charge() > b.charge();
+  });
+
+  body.slices.resize(NUM_SLICES);
+  for (auto &slice : body.slices)
+  {
+    BitVector slice_state{NUM_LANES};
+
+    auto it = queue.begin();
+    while ((it != queue.end()) && (slice_state.PopCount() != NUM_LANES))
+    {
+      BitVector const collisions = slice_state & it->mask();
+
+      if (collisions.PopCount() == 0)
+      {
+        slice_state |= it->mask();
+        slice.push_back(*it);
+        it = queue.Erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+}
+
+void PackSlices(LaneIndexedPool &pool, Block::Body &body)
+{
+  body.slices.resize(NUM_SLICES);
+  for (auto &slice : body.slices)
+  {
+    pool.GenerateSlice(slice);
+  }
+}
+
+// The pools are populated outside of the timed region. This mirrors the miner where transactions
+// are added to the pool once but the pool is packed (and previously sorted) for every block.
+void MinerPacking_SortedQueue(benchmark::State &state)
+{
+  auto const layouts = GenerateLayouts(static_cast<std::size_t>(state.range(0)));
+
+  std::unique_ptr<TransactionLayoutQueue> queue;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    queue = std::make_unique<TransactionLayoutQueue>();
+    for (auto const &layout : layouts)
+    {
+      queue->Add(layout);
+    }
+    Block::Body body{};
+    state.ResumeTiming();
+
+    PackSlices(*queue, body);
+
+    // exclude the destruction of the pool from the timings
+    state.PauseTiming();
+    queue.reset();
+    state.ResumeTiming();
+  }
+}
+
+void MinerPacking_LaneIndexedPool(benchmark::State &state)
+{
+  auto const layouts = GenerateLayouts(static_cast<std::size_t>(state.range(0)));
+
+  std::unique_ptr<LaneIndexedPool> pool;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    pool = std::make_unique<LaneIndexedPool>(NUM_LANES);
+    for (auto const &layout : layouts)
+    {
+      pool->Add(layout);
+    }
+    Block::Body body{};
+    state.ResumeTiming();
+
+    PackSlices(*pool, body);
+
+    // exclude the destruction of the pool from the timings
+    state.PauseTiming();
+    pool.reset();
+    state.ResumeTiming();
+  }
+}
+
+}  // namespace
+
+BENCHMARK(MinerPacking_SortedQueue)->Range(1000, 100000);
+BENCHMARK(MinerPacking_LaneIndexedPool)->Range(1000, 100000);
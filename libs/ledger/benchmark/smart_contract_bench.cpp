@@ -0,0 +1,90 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "in_memory_storage.hpp"
+#include "ledger/chaincode/smart_contract.hpp"
+#include "ledger/identifier.hpp"
+#include "ledger/state_adapter.hpp"
+#include "variant/variant.hpp"
+#include "vm/module.hpp"
+#include "vm/vm.hpp"
+#include "vm_modules/vm_factory.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <memory>
+
+namespace {
+
+using fetch::ledger::Identifier;
+using fetch::ledger::SmartContract;
+using fetch::ledger::StateAdapter;
+using fetch::variant::Variant;
+using fetch::vm_modules::VMFactory;
+
+char const *CONTRACT_SOURCE = R"(
+  @query
+  function greet(name : String) : String
+    var greeting = "Hello, " + name;
+    return greeting;
+  endfunction
+)";
+
+/**
+ * The per call cost of creating a fresh VM instance, which was previously paid on every contract
+ * invocation
+ */
+void SmartContract_CreateVM(benchmark::State &state)
+{
+  auto module = VMFactory::GetModule(VMFactory::USE_SMART_CONTRACTS);
+
+  for (auto _ : state)
+  {
+    auto vm = std::make_unique<fetch::vm::VM>(module.get());
+    benchmark::DoNotOptimize(vm);
+  }
+}
+
+/**
+ * The end to end cost of a trivial query against a contract, which is dominated by the per call
+ * overhead of the invocation
+ */
+void SmartContract_Query(benchmark::State &state)
+{
+  InMemoryStorageUnit storage{};
+  SmartContract       contract{CONTRACT_SOURCE};
+  StateAdapter        adapter{storage, Identifier{"fetch.benchmark"}};
+
+  Variant request = Variant::Object();
+  request["name"] = "benchmark";
+
+  contract.Attach(adapter);
+
+  for (auto _ : state)
+  {
+    Variant response{};
+    contract.DispatchQuery("greet", request, response);
+  }
+
+  contract.Detach();
+}
+
+}  // namespace
+
+BENCHMARK(SmartContract_CreateVM);
+BENCHMARK(SmartContract_Query);
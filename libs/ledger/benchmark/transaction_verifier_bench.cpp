@@ -117,6 +117,64 @@ void CreateRanges(benchmark::internal::Benchmark *b)
   }
 }
 
+void TransactionVerifierBatchBench(benchmark::State &state)
+{
+  static constexpr std::size_t NUM_TXS = 10000;
+
+  auto const num_threads = static_cast<std::size_t>(state.range(0));
+  auto const batch_size  = static_cast<std::size_t>(state.range(1));
+
+  ECDSASigner signer;
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+
+    // transactions cache their verification result, so a fresh set is needed for each run
+    auto const txs = GenerateTransactions(NUM_TXS, signer);
+
+    DummySink sink{txs.size()};
+
+    // needs to be created on the heap because of memory use
+    auto verifier =
+        std::make_unique<TransactionVerifier>(sink, num_threads, "BatchVerifier", batch_size);
+
+    // front load the verifier
+    for (auto const &tx : txs)
+    {
+      verifier->AddTransaction(tx);
+    }
+
+    verifier->Start();
+    state.ResumeTiming();
+
+    sink.Wait();
+
+    state.PauseTiming();
+    verifier->Stop();
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NUM_TXS));
+}
+
+void CreateBatchRanges(benchmark::internal::Benchmark *b)
+{
+  auto const max_threads = static_cast<int>(std::thread::hardware_concurrency());
+
+  for (int i = 1; i <= max_threads; i <<= 1)
+  {
+    for (int batch_size = 1; batch_size <= 256; batch_size <<= 2)
+    {
+      b->Args({i, batch_size});
+    }
+  }
+}
+
 }  // namespace
 
 BENCHMARK(TransactionVerifierBench)->Apply(CreateRanges);
+BENCHMARK(TransactionVerifierBatchBench)
+    ->Apply(CreateBatchRanges)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
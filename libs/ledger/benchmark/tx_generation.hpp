@@ -66,6 +66,7 @@ inline TransactionList GenerateTransactions(std::size_t count, ECDSASigner const
     auto tx = TransactionBuilder()
                   .From(Address{signer.identity()})
                   .TargetChainCode("fetch.token", BitVector{})
+                  .Action("transfer")
                   .Data(GenerateRandomArray<Word>(large_packets ? TX_SIZE_IN_WORDS : 1ull, rng))
                   .Signer(signer.identity())
                   .Seal()
@@ -31,6 +31,7 @@
 #include "ledger/upow/synergetic_execution_manager_interface.hpp"
 #include "ledger/upow/synergetic_miner_interface.hpp"
 #include "moment/deadline_timer.hpp"
+#include "network/details/thread_pool.hpp"
 #include "telemetry/telemetry.hpp"
 
 #include <atomic>
@@ -142,6 +143,10 @@ class BlockSinkInterface;
  *                                  │                  │────────────────────────────────┘
  *                                  └──────────────────┘
  *
+ * When pipelining is enabled the commit of the state generated by a block is handed to a
+ * background worker as soon as the block has been validated. The state machine carries on with the
+ * next block (validation, waiting for its transactions and planning its execution) and only holds
+ * off in the states which modify the state database until the commit has completed.
  */
 class BlockCoordinator
 {
@@ -191,11 +196,12 @@ public:
                    std::size_t num_slices, std::size_t block_difficulty, ConsensusPtr consensus);
   BlockCoordinator(BlockCoordinator const &) = delete;
   BlockCoordinator(BlockCoordinator &&)      = delete;
-  ~BlockCoordinator()                        = default;
+  ~BlockCoordinator();
 
   template <typename R, typename P>
   void SetBlockPeriod(std::chrono::duration<R, P> const &period);
   void EnableMining(bool enable = true);
+  void EnablePipelining(bool enable = true);
   void TriggerBlockGeneration();  // useful in tests
 
   std::weak_ptr<core::Runnable> GetWeakRunnable()
@@ -230,6 +236,11 @@ public:
     });
   }
 
+  bool IsCommitInProgress() const
+  {
+    return commit_in_progress_;
+  }
+
   bool IsSynced() const
   {
     return last_executed_block_.Apply([this](auto const &last_executed_block_hash) -> bool {
@@ -271,6 +282,9 @@ private:
   using DeadlineTimer        = fetch::moment::DeadlineTimer;
   using SynergeticExecMgrPtr = std::unique_ptr<SynergeticExecutionManagerInterface>;
   using SynExecStatus        = SynergeticExecutionManagerInterface::ExecStatus;
+  using ThreadPool           = network::ThreadPool;
+  using StageClock           = std::chrono::steady_clock;
+  using StageTimepoint       = StageClock::time_point;
 
   /// @name Monitor State
   /// @{
@@ -301,6 +315,8 @@ private:
   bool            ScheduleBlock(Block const &block);
   ExecutionStatus QueryExecutorStatus();
   void            UpdateNextBlockTime();
+  void            CommitState(Block const &block);
+  bool            WaitForPendingCommit();
 
   static char const *ToString(ExecutionStatus state);
 
@@ -350,6 +366,15 @@ private:
   bool have_asked_for_missing_txs_{};
   /// @}
 
+  /// @name Pipelining
+  /// @{
+  Flag           pipelined_{false};           ///< Flag to signal if commits are made in background
+  Flag           commit_in_progress_{false};  ///< Flag to signal a background commit is running
+  ConstByteArray committing_block_{};         ///< The hash of the block whose state is committing
+  ThreadPool     commit_pool_{};              ///< The worker used to make background commits
+  StageTimepoint stage_start_{};              ///< The time at which the current state was entered
+  /// @}
+
   /// @name Synergetic Contracts
   /// @{
   SynergeticExecMgrPtr synergetic_exec_mgr_;
@@ -382,6 +407,9 @@ private:
   telemetry::GaugePtr<uint64_t> current_block_num_;
   telemetry::GaugePtr<uint64_t> next_block_num_;
   telemetry::GaugePtr<uint64_t> block_hash_;
+  telemetry::GaugePtr<uint64_t> commit_in_progress_gauge_;
+  telemetry::HistogramMapPtr    stage_durations_;
+  telemetry::CounterMapPtr      overlapped_stage_count_;
   /// @}
 };
 
@@ -26,6 +26,7 @@
 #include "ledger/chain/block.hpp"
 #include "ledger/chain/consensus/proof_of_work.hpp"
 #include "ledger/chain/constants.hpp"
+#include "ledger/chain/transaction_index.hpp"
 #include "ledger/chain/transaction_layout.hpp"
 #include "network/generics/milli_timer.hpp"
 #include "storage/object_store.hpp"
@@ -186,6 +187,8 @@ public:
   void WriteToFile();
   void TrimCache();
   void FlushBlock(IntBlockPtr const &block);
+  void ResetTransactionIndex();
+  void RebuildBloomFilter();
   /// @}
 
   /// @name Loose Blocks
@@ -237,6 +240,7 @@ public:
   TipsMap                           tips_;          ///< Keep track of the tips
   HeaviestTip                       heaviest_;      ///< Heaviest block/tip
   LooseBlockMap                     loose_blocks_;  ///< Waiting (loose) blocks
+  TransactionIndex                  tx_index_;      ///< Index of the transactions in the chain
   std::unique_ptr<BasicBloomFilter> bloom_filter_;
   bool const                        enable_bloom_filter_;
   telemetry::GaugePtr<std::size_t>  bloom_filter_queried_bit_count_;
@@ -160,9 +160,10 @@ private:
 
   /// @name Metadata
   /// @{
-  Digest digest_{};                       ///< The digest of the transaction
-  bool   verification_completed_{false};  ///< Signal that the verification has been done
-  bool   verified_{false};                ///< The cached result of the verification
+  Digest         digest_{};                       ///< The digest of the transaction
+  ConstByteArray payload_{};                      ///< The serialized payload (when retained)
+  bool           verification_completed_{false};  ///< Signal that the verification has been done
+  bool           verified_{false};                ///< The cached result of the verification
   /// @}
 
   // There are only two ways to generate a transaction, each from one of the two companion classes:
@@ -0,0 +1,267 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/digest.hpp"
+#include "ledger/chain/block.hpp"
+#include "storage/object_store.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * The record of a transaction in the transaction index. A transaction can be present in more than
+ * one block when there are competing forks of the chain.
+ */
+struct TransactionIndexRecord
+{
+  struct Location
+  {
+    Block::Hash hash{};           ///< The hash of the block containing the transaction
+    uint64_t    block_number{0};  ///< The height of the block containing the transaction
+  };
+
+  using Locations = std::vector<Location>;
+
+  Digest    digest{};        ///< The digest of the transaction
+  uint64_t  valid_until{0};  ///< The block number from which the transaction is no longer valid
+  Locations locations{};     ///< The blocks which contain the transaction
+};
+
+/**
+ * The digests of the transactions in the transaction index which expire at the same block number
+ */
+struct TransactionIndexExpiry
+{
+  using Digests = std::vector<Digest>;
+
+  uint64_t valid_until{0};  ///< The block number from which the transactions are no longer valid
+  Digests  digests{};       ///< The digests of the transactions
+};
+
+/**
+ * Index of the digests of the transactions which have been included in blocks.
+ *
+ * Since a transaction can not be included in a block at or above its valid until block number,
+ * transactions are only retained until the chain has progressed beyond this point (plus the
+ * finality period). Note that the validity window of a transaction is not capped, so this does not
+ * bound the size of the index.
+ *
+ * When a persistent store is configured the index is kept on disk, along with the transactions
+ * grouped by the block number at which they expire. Only the changes since the last Flush() are
+ * held in memory, together with the set of expiry block numbers. The index records the chain head
+ * at which it was last flushed, so that a stale index can be detected and rebuilt on recovery.
+ * Without a persistent store the complete index is held in memory.
+ */
+class TransactionIndex
+{
+public:
+  using Record    = TransactionIndexRecord;
+  using Location  = Record::Location;
+  using Locations = Record::Locations;
+
+  // Construction / Destruction
+  TransactionIndex()                         = default;
+  TransactionIndex(TransactionIndex const &) = delete;
+  TransactionIndex(TransactionIndex &&)      = delete;
+  ~TransactionIndex();
+
+  /// @name Persistence
+  /// @{
+  void               New(std::string const &prefix);
+  void               Load(std::string const &prefix);
+  void               Flush();
+  void               SetHead(Block::Hash const &hash);
+  Block::Hash const &head() const;
+  /// @}
+
+  /// @name Index Operations
+  /// @{
+  void        Add(Block const &block);
+  void        Remove(Block const &block);
+  bool        Lookup(Digest const &digest, Locations &locations) const;
+  std::size_t Prune(uint64_t block_number);
+  void        Clear();
+  std::size_t size() const;
+  /// @}
+
+  template <typename Visitor>
+  void VisitDigests(Visitor &&visitor) const;
+
+  // Operators
+  TransactionIndex &operator=(TransactionIndex const &) = delete;
+  TransactionIndex &operator=(TransactionIndex &&) = delete;
+
+private:
+  using Records     = DigestMap<Record>;
+  using Expiry      = std::map<uint64_t, DigestSet>;
+  using BlockNumber = std::set<uint64_t>;
+  using Store       = storage::ObjectStore<Record, 256>;
+  using StorePtr    = std::unique_ptr<Store>;
+  using ExpiryStore = storage::ObjectStore<TransactionIndexExpiry>;
+  using ExpiryPtr   = std::unique_ptr<ExpiryStore>;
+
+  void      Open(std::string const &prefix, bool create);
+  bool      Get(Digest const &digest, Record &record) const;
+  void      Put(Record const &record);
+  void      Drop(Digest const &digest);
+  bool      NextExpiry(uint64_t &valid_until) const;
+  DigestSet TakeExpiry(uint64_t valid_until);
+  void      WriteHead(Block::Hash const &hash);
+
+  Records      records_{};         ///< The index, or its unflushed changes when persistent
+  Expiry       expiry_{};          ///< Digests by valid until, only unflushed ones when persistent
+  BlockNumber  stored_expiry_{};   ///< The valid until block numbers in the expiry store
+  BlockNumber  removed_expiry_{};  ///< The pruned block numbers to remove from the expiry store
+  std::size_t  count_{0};          ///< The number of transactions in the index
+  Block::Hash  head_{};            ///< The chain head which the index corresponds to
+  StorePtr     store_{};           ///< The (optional) persistent copy of the index
+  ExpiryPtr    expiry_store_{};    ///< The (optional) persistent copy of the expiry index
+  std::fstream head_file_{};       ///< The (optional) persistent copy of the head
+};
+
+/**
+ * Visit each of the digests in the index
+ *
+ * @param visitor The callable to be invoked with each of the digests
+ */
+template <typename Visitor>
+void TransactionIndex::VisitDigests(Visitor &&visitor) const
+{
+  for (auto const &element : records_)
+  {
+    // removals which have not been flushed are recorded without any locations
+    if (!element.second.locations.empty())
+    {
+      visitor(element.first);
+    }
+  }
+
+  if (store_)
+  {
+    for (auto it = store_->begin(), end = store_->end(); it != end; ++it)
+    {
+      Digest const digest = it.GetKey().id();
+
+      if (records_.find(digest) == records_.end())
+      {
+        visitor(digest);
+      }
+    }
+  }
+}
+
+}  // namespace ledger
+
+namespace serializers {
+
+template <typename V, typename D>
+struct MapSerializer;
+
+template <typename D>
+struct MapSerializer<ledger::TransactionIndexRecord::Location, D>
+{
+public:
+  using Type       = ledger::TransactionIndexRecord::Location;
+  using DriverType = D;
+
+  static uint8_t const HASH         = 1;
+  static uint8_t const BLOCK_NUMBER = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &location)
+  {
+    auto map = map_constructor(2);
+    map.Append(HASH, location.hash);
+    map.Append(BLOCK_NUMBER, location.block_number);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &location)
+  {
+    map.ExpectKeyGetValue(HASH, location.hash);
+    map.ExpectKeyGetValue(BLOCK_NUMBER, location.block_number);
+  }
+};
+
+template <typename D>
+struct MapSerializer<ledger::TransactionIndexRecord, D>
+{
+public:
+  using Type       = ledger::TransactionIndexRecord;
+  using DriverType = D;
+
+  static uint8_t const DIGEST      = 1;
+  static uint8_t const VALID_UNTIL = 2;
+  static uint8_t const LOCATIONS   = 3;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &record)
+  {
+    auto map = map_constructor(3);
+    map.Append(DIGEST, record.digest);
+    map.Append(VALID_UNTIL, record.valid_until);
+    map.Append(LOCATIONS, record.locations);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &record)
+  {
+    map.ExpectKeyGetValue(DIGEST, record.digest);
+    map.ExpectKeyGetValue(VALID_UNTIL, record.valid_until);
+    map.ExpectKeyGetValue(LOCATIONS, record.locations);
+  }
+};
+
+template <typename D>
+struct MapSerializer<ledger::TransactionIndexExpiry, D>
+{
+public:
+  using Type       = ledger::TransactionIndexExpiry;
+  using DriverType = D;
+
+  static uint8_t const VALID_UNTIL = 1;
+  static uint8_t const DIGESTS     = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &expiry)
+  {
+    auto map = map_constructor(2);
+    map.Append(VALID_UNTIL, expiry.valid_until);
+    map.Append(DIGESTS, expiry.digests);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &expiry)
+  {
+    map.ExpectKeyGetValue(VALID_UNTIL, expiry.valid_until);
+    map.ExpectKeyGetValue(DIGESTS, expiry.digests);
+  }
+};
+
+}  // namespace serializers
+}  // namespace fetch
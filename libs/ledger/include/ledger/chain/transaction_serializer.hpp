@@ -55,7 +55,7 @@ public:
   /// @name  Serialisation / Deserialization
   /// @{
   bool Serialize(Transaction const &tx);
-  bool Deserialize(Transaction &tx) const;
+  bool Deserialize(Transaction &tx, bool retain_payload = true) const;
 
   // Operators (throw on error)
   TransactionSerializer &operator<<(Transaction const &tx);
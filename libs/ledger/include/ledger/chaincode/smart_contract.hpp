@@ -17,17 +17,21 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/mutex.hpp"
 #include "crypto/fnv.hpp"  // needed for std::hash<ConstByteArray> !!!
 #include "ledger/chaincode/contract.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace fetch {
 
 namespace vm {
 struct Executable;
 class Module;
+class VM;
 }  // namespace vm
 
 namespace ledger {
@@ -46,7 +50,7 @@ public:
 
   // Construction / Destruction
   explicit SmartContract(std::string const &source);
-  ~SmartContract() override = default;
+  ~SmartContract() override;
 
   ConstByteArray contract_digest() const
   {
@@ -60,18 +64,30 @@ public:
 
 private:
   using ModulePtr = std::shared_ptr<vm::Module>;
+  using VMPtr     = std::unique_ptr<vm::VM>;
+  using VMPool    = std::vector<VMPtr>;
+
+  class VMLease;
+
+  static constexpr std::size_t MAX_POOLED_VMS = 4;
 
   // Transaction /
   Result InvokeAction(std::string const &name, Transaction const &tx, BlockIndex index);
   Status InvokeQuery(std::string const &name, Query const &request, Query &response);
   Result InvokeInit(Address const &owner);
 
+  // VM Pool
+  VMPtr AcquireVM();
+  void  ReleaseVM(VMPtr vm);
+
   BlockIndex     block_index_{};  ///< The index current contract's block
   std::string    source_;         ///< The source of the current contract
   ConstByteArray digest_;         ///< The digest of the current contract
   ExecutablePtr  executable_;     ///< The internal script object of the parsed source
   ModulePtr      module_;         ///< The internal module instance for the contract
   std::string    init_fn_name_;
+  Mutex          vm_pool_lock_;
+  VMPool         vm_pool_;  ///< The idle VM instances available for reuse
 };
 
 }  // namespace ledger
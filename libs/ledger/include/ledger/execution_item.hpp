@@ -32,11 +32,13 @@ namespace ledger {
 class ExecutionItem
 {
 public:
-  using LaneIndex  = uint32_t;
-  using BlockIndex = ExecutorInterface::BlockIndex;
-  using SliceIndex = ExecutorInterface::SliceIndex;
-  using Status     = ExecutorInterface::Status;
-  using Result     = ExecutorInterface::Result;
+  using LaneIndex         = uint32_t;
+  using BlockIndex        = ExecutorInterface::BlockIndex;
+  using SliceIndex        = ExecutorInterface::SliceIndex;
+  using Status            = ExecutorInterface::Status;
+  using Result            = ExecutorInterface::Result;
+  using PendingChangesPtr = ExecutorInterface::PendingChangesPtr;
+  using ResourceSet       = PendingChanges::ResourceSet;
 
   static constexpr char const *LOGGING_NAME = "ExecutionItem";
 
@@ -56,6 +58,13 @@ public:
 
   void Execute(ExecutorInterface &executor);
 
+  /// @name Speculative Execution
+  /// @{
+  void ExecuteSpeculatively(ExecutorInterface &executor, StorageInterface &state);
+  bool ConflictsWith(ResourceSet const &modified) const;
+  void ApplyChanges(ResourceSet &modified);
+  /// @}
+
   // Operators
   ExecutionItem &operator=(ExecutionItem const &) = delete;
   ExecutionItem &operator=(ExecutionItem &&) = delete;
@@ -63,12 +72,13 @@ public:
 private:
   using AtomicFee = std::atomic<uint64_t>;
 
-  Digest      digest_;
-  BlockIndex  block_{0};
-  SliceIndex  slice_{0};
-  BitVector   shards_;
-  Result      result_;
-  TokenAmount fee_{0};
+  Digest            digest_;
+  BlockIndex        block_{0};
+  SliceIndex        slice_{0};
+  BitVector         shards_;
+  Result            result_;
+  TokenAmount       fee_{0};
+  PendingChangesPtr pending_changes_;
 };
 
 inline ExecutionItem::ExecutionItem(Digest digest, BlockIndex block, SliceIndex slice,
@@ -114,5 +124,74 @@ inline void ExecutionItem::Execute(ExecutorInterface &executor)
   }
 }
 
+/**
+ * Execute the transaction without applying its changes to the state. Executing the item again
+ * discards the changes from any previous execution.
+ *
+ * @param executor The executor to be used
+ * @param state The state to execute against, the changes are later applied to the same state
+ */
+inline void ExecutionItem::ExecuteSpeculatively(ExecutorInterface &executor,
+                                                StorageInterface &state)
+{
+  pending_changes_.reset();
+
+  try
+  {
+    result_ =
+        executor.ExecuteSpeculatively(digest_, block_, slice_, shards_, state, pending_changes_);
+    fee_    = result_.fee;
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Exception thrown while executing transaction: ", ex.what());
+
+    result_ = {ContractExecutionStatus::RESOURCE_FAILURE};
+    fee_    = 0;
+    pending_changes_.reset();
+  }
+}
+
+/**
+ * Determine if the speculative execution read any of the specified resources
+ *
+ * @param modified The set of resources modified since the speculative execution
+ * @return true if the execution must be repeated, otherwise false
+ */
+inline bool ExecutionItem::ConflictsWith(ResourceSet const &modified) const
+{
+  if (!pending_changes_ || modified.empty())
+  {
+    return false;
+  }
+
+  for (auto const &resource : pending_changes_->read_set())
+  {
+    if (modified.find(resource) != modified.end())
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Apply the changes from the speculative execution to the state
+ *
+ * @param modified The set of modified resources to be updated with the changes made
+ */
+inline void ExecutionItem::ApplyChanges(ResourceSet &modified)
+{
+  if (pending_changes_)
+  {
+    auto const &write_set = pending_changes_->write_set();
+    modified.insert(write_set.begin(), write_set.end());
+
+    pending_changes_->Apply();
+    pending_changes_.reset();
+  }
+}
+
 }  // namespace ledger
 }  // namespace fetch
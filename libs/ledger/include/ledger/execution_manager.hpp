@@ -26,6 +26,7 @@
 #include "ledger/execution_item.hpp"
 #include "ledger/execution_manager_interface.hpp"
 #include "ledger/executor.hpp"
+#include "ledger/storage_unit/overlay_storage_adapter.hpp"
 #include "ledger/storage_unit/storage_unit_interface.hpp"
 #include "network/details/thread_pool.hpp"
 #include "storage/object_store.hpp"
@@ -68,12 +69,16 @@ public:
   Digest         LastProcessedBlock() override;
   State          GetState() override;
   bool           Abort() override;
+  bool           PrepareExecution(Block::Body const &block) override;
   /// @}
 
   // general control of the operation of the module
   void Start();
   void Stop();
 
+  // configuration
+  void SetOptimisticExecution(bool enabled);
+
   // statistics
   std::size_t completed_executions() const
   {
@@ -104,19 +109,26 @@ private:
   using AtomicState       = std::atomic<State>;
   using CounterPtr        = telemetry::CounterPtr;
   using HistogramPtr      = telemetry::HistogramPtr;
+  using ResourceSet       = ExecutionItem::ResourceSet;
 
   uint32_t const log2_num_lanes_;
 
   Flag running_{false};
   Flag monitor_ready_{false};
+  Flag optimistic_{false};
 
   Protected<State> state_{State::IDLE};
 
-  StorageUnitPtr storage_;
+  StorageUnitPtr        storage_;
+  OverlayStorageAdapter slice_state_;  ///< The changes applied by the current speculative slice
 
   Mutex         execution_plan_lock_;  ///< guards `execution_plan_`
   ExecutionPlan execution_plan_;
 
+  Mutex         prepared_plan_lock_;  ///< guards `prepared_plan_` and `prepared_block_`
+  ExecutionPlan prepared_plan_;
+  Digest        prepared_block_;
+
   Digest  last_block_hash_ = GENESIS_DIGEST;
   Address last_block_miner_{};
 
@@ -141,12 +153,19 @@ private:
   CounterPtr   slices_executed_count_;
   CounterPtr   fees_settled_count_;
   CounterPtr   blocks_completed_count_;
+  CounterPtr   tx_speculative_count_;
+  CounterPtr   tx_conflicts_count_;
   HistogramPtr execution_duration_;
 
   void MonitorThreadEntrypoint();
 
-  bool PlanExecution(Block::Body const &block);
-  void DispatchExecution(ExecutionItem &item);
+  bool        PlanExecution(Block::Body const &block);
+  void        BuildExecutionPlan(Block::Body const &block, ExecutionPlan &plan) const;
+  void        DispatchExecution(ExecutionItem &item, bool speculative);
+  bool        CommitSpeculativeExecution(ExecutionItemList &items);
+  void        RecordExecution(ExecutionItem const &item);
+  ExecutorPtr AcquireIdleExecutor();
+  void        ReleaseExecutor(ExecutorPtr executor);
 };
 
 }  // namespace ledger
@@ -64,6 +64,18 @@ public:
   virtual State          GetState()                                 = 0;
   virtual bool           Abort()                                    = 0;
   /// @}
+
+  /**
+   * Optionally plan the execution of a block ahead of it being scheduled. A subsequent call to
+   * Execute for the same block is then able to reuse the plan.
+   *
+   * @param block The block to be planned
+   * @return true if the block has been planned, otherwise false
+   */
+  virtual bool PrepareExecution(Block::Body const & /*block*/)
+  {
+    return false;
+  }
 };
 
 /**
@@ -20,6 +20,7 @@
 #include "crypto/fnv.hpp"
 #include "ledger/chain/block.hpp"
 #include "ledger/chaincode/chain_code_cache.hpp"
+#include "ledger/chaincode/token_contract.hpp"
 #include "ledger/executor_interface.hpp"
 #include "ledger/storage_unit/storage_unit_interface.hpp"
 #include "telemetry/telemetry.hpp"
@@ -31,7 +32,6 @@ namespace fetch {
 namespace ledger {
 
 class Address;
-class TokenContract;
 class CachedStorageAdapter;
 class StateSentinelAdapter;
 class StakeUpdateInterface;
@@ -54,14 +54,21 @@ public:
   Result Execute(Digest const &digest, BlockIndex block, SliceIndex slice,
                  BitVector const &shards) override;
   void   SettleFees(Address const &miner, TokenAmount amount, uint32_t log2_num_lanes) override;
+  Result ExecuteSpeculatively(Digest const &digest, BlockIndex block, SliceIndex slice,
+                              BitVector const &shards, StorageInterface &state,
+                              PendingChangesPtr &changes) override;
   /// @}
 
 private:
   using TokenContractPtr        = std::shared_ptr<TokenContract>;
   using TransactionPtr          = std::shared_ptr<Transaction>;
   using CachedStorageAdapterPtr = std::shared_ptr<CachedStorageAdapter>;
+  using StakeUpdates            = TokenContract::StakeUpdates;
 
-  bool RetrieveTransaction(Digest const &digest);
+  Result ExecuteTransaction(Digest const &digest, BlockIndex block, SliceIndex slice,
+                            BitVector const &shards, StorageInterface &state, bool forward_locks);
+  bool   RetrieveTransaction(Digest const &digest);
+  void PrefetchResources();
   bool ValidationChecks(Result &result);
   bool ExecuteTransactionContract(Result &result);
   bool ProcessTransfers(Result &result);
@@ -81,8 +88,10 @@ private:
   SliceIndex              slice_{};
   BitVector               allowed_shards_{};
   LaneIndex               log2_num_lanes_{0};
+  StorageInterface *      state_{nullptr};  ///< The state the transaction is executed against
   TransactionPtr          current_tx_{};
   CachedStorageAdapterPtr storage_cache_;
+  StakeUpdates            pending_stake_updates_;
   /// @}
 
   telemetry::HistogramPtr overall_duration_;
@@ -19,6 +19,10 @@
 
 #include "core/digest.hpp"
 #include "ledger/execution_result.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include <memory>
+#include <unordered_set>
 
 namespace fetch {
 
@@ -27,16 +31,40 @@ class BitVector;
 namespace ledger {
 
 class Address;
+class StorageInterface;
+
+/**
+ * The changes made by a transaction which has been executed but not yet applied to the state
+ * database. The resources accessed by the execution are exposed so that the caller can determine if
+ * the execution conflicts with other transactions before deciding to apply the changes.
+ */
+class PendingChanges
+{
+public:
+  using ResourceSet = std::unordered_set<storage::ResourceAddress>;
+
+  // Construction / Destruction
+  PendingChanges()          = default;
+  virtual ~PendingChanges() = default;
+
+  /// @name Pending Changes Interface
+  /// @{
+  virtual ResourceSet const &read_set() const  = 0;
+  virtual ResourceSet const &write_set() const = 0;
+  virtual void               Apply()           = 0;
+  /// @}
+};
 
 class ExecutorInterface
 {
 public:
-  using BlockIndex  = uint64_t;
-  using SliceIndex  = uint64_t;
-  using LaneIndex   = uint32_t;
-  using TokenAmount = uint64_t;
-  using Status      = ContractExecutionStatus;
-  using Result      = ContractExecutionResult;
+  using BlockIndex        = uint64_t;
+  using SliceIndex        = uint64_t;
+  using LaneIndex         = uint32_t;
+  using TokenAmount       = uint64_t;
+  using Status            = ContractExecutionStatus;
+  using Result            = ContractExecutionResult;
+  using PendingChangesPtr = std::unique_ptr<PendingChanges>;
 
   // Construction / Destruction
   ExecutorInterface()          = default;
@@ -48,6 +76,26 @@ public:
                          BitVector const &shards)                                              = 0;
   virtual void   SettleFees(Address const &miner, TokenAmount amount, uint32_t log2_num_lanes) = 0;
   /// @}
+
+  /**
+   * Execute a transaction without applying the changes to the state database. Executors which do
+   * not support this apply the changes immediately and do not populate the pending changes.
+   *
+   * @param digest The transaction digest to be executed
+   * @param block The current block index
+   * @param slice The current slice index
+   * @param shards The bit vector outlining the shards in use by this transaction
+   * @param state The state to read from, the pending changes are applied to the same state
+   * @param changes The output pending changes to be applied by the caller
+   * @return The status code for the operation
+   */
+  virtual Result ExecuteSpeculatively(Digest const &digest, BlockIndex block, SliceIndex slice,
+                                      BitVector const &shards, StorageInterface & /*state*/,
+                                      PendingChangesPtr &changes)
+  {
+    changes.reset();
+    return Execute(digest, block, slice, shards);
+  }
 };
 
 }  // namespace ledger
@@ -63,6 +63,13 @@ struct ShardConfig
   Timeperiod  sync_service_promise_timeout{2000};
   Timeperiod  sync_service_fetch_period{5000};
   /// @}
+
+  /// @name State Storage Configuration
+  /// @{
+  uint64_t state_snapshot_interval{0};   ///< Num commits between state snapshots (0 to disable)
+  uint64_t state_snapshot_retention{0};  ///< Num state snapshots retained (0 for unlimited)
+  uint64_t state_cache_size{1u << 24};   ///< Page cache per state file in bytes (0 for direct)
+  /// @}
 };
 
 using ShardConfigs = std::vector<ShardConfig>;
@@ -22,6 +22,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 namespace fetch {
@@ -30,17 +31,28 @@ namespace ledger {
 /**
  * Designed for temporary caching of values to reduce hits to the underlying storage engine.
  *
- * Initially intended in conjuction with the smart contract engine
+ * Initially intended in conjuction with the smart contract engine. The adapter also records the
+ * set of resources which have been read from and written to the underlying storage engine so that
+ * conflicts between concurrently executed transactions can be detected.
  */
 class CachedStorageAdapter : public StorageInterface
 {
 public:
+  using ResourceSet = std::unordered_set<ResourceAddress>;
+
   // Construction / Destruction
-  explicit CachedStorageAdapter(StorageInterface &storage);
+  explicit CachedStorageAdapter(StorageInterface &storage, bool forward_locks = true);
   ~CachedStorageAdapter() override;
 
   void Flush();
   void Clear();
+  void Prefetch(Addresses const &keys);
+
+  /// @name Access Tracking
+  /// @{
+  ResourceSet const &read_set() const;
+  ResourceSet const &write_set() const;
+  /// @}
 
   /// @name State Interface
   /// @{
@@ -63,6 +75,11 @@ private:
     explicit CacheEntry(StateValue v)
       : value{std::move(v)}
     {}
+
+    CacheEntry(StateValue v, bool f)
+      : value{std::move(v)}
+      , flushed{f}
+    {}
   };
 
   using Cache = std::unordered_map<ResourceAddress, CacheEntry>;
@@ -70,17 +87,21 @@ private:
   /// @name Cache Helpers
   /// @{
   void       AddCacheEntry(ResourceAddress const &address, StateValue const &value);
+  void       RecordRead(ResourceAddress const &address, Document const &document);
   StateValue GetCacheEntry(ResourceAddress const &address) const;
   bool       HasCacheEntry(ResourceAddress const &address) const;
   /// @}
 
-  StorageInterface &storage_;  ///< The reference to the underlying storage engine
+  StorageInterface &storage_;       ///< The reference to the underlying storage engine
+  bool const        forward_locks_;  ///< Whether lock requests are passed to the storage engine
 
   /// @name Cache Data
   /// @{
   mutable Mutex lock_;
   Cache         cache_{};                ///< The local cache
   bool          flush_required_{false};  ///< Top level cache flush flag
+  ResourceSet   read_set_{};             ///< The resources loaded from the storage engine
+  ResourceSet   write_set_{};            ///< The resources that will be changed by a flush
   /// @}
 };
 
@@ -0,0 +1,78 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "ledger/storage_unit/storage_unit_interface.hpp"
+
+#include <unordered_map>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Holds the values written to the storage engine in memory until they are flushed.
+ *
+ * Lookups of resources which have been written are served from the overlay, so the values are
+ * visible to later readers before they reach the storage engine. All other lookups are passed
+ * straight through and are not cached. The buffered values are written with a single batched
+ * request, which the storage unit client turns into one message per lane.
+ *
+ * This is used to collect the changes of all the transactions in a slice.
+ */
+class OverlayStorageAdapter : public StorageInterface
+{
+public:
+  // Construction / Destruction
+  explicit OverlayStorageAdapter(StorageInterface &storage);
+  ~OverlayStorageAdapter() override = default;
+
+  void        Flush();
+  void        Clear();
+  std::size_t size() const;
+
+  /// @name State Interface
+  /// @{
+  Document Get(ResourceAddress const &key) override;
+  Document GetOrCreate(ResourceAddress const &key) override;
+  void     Set(ResourceAddress const &key, StateValue const &value) override;
+  bool     Lock(ShardIndex index) override;
+  bool     Unlock(ShardIndex index) override;
+  Keys     KeyDump() const override;
+  void     Reset() override;
+  /// @}
+
+  /// @name Batched State Interface
+  /// @{
+  Documents GetMany(Addresses const &keys) override;
+  void      SetMany(KeyValues const &values) override;
+  /// @}
+
+private:
+  using Values = std::unordered_map<ResourceAddress, StateValue>;
+
+  bool Lookup(ResourceAddress const &key, Document &document) const;
+
+  StorageInterface &storage_;  ///< The reference to the underlying storage engine
+
+  mutable Mutex lock_;
+  Values        values_{};  ///< The values written since the last flush
+};
+
+}  // namespace ledger
+}  // namespace fetch
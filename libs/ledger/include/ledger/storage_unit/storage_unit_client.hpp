@@ -75,6 +75,9 @@ public:
   Document Get(ResourceAddress const &key) override;
   void     Set(ResourceAddress const &key, StateValue const &value) override;
 
+  Documents GetMany(Addresses const &keys) override;
+  void      SetMany(KeyValues const &values) override;
+
   Keys KeyDump() const override;
   void Reset() override;
 
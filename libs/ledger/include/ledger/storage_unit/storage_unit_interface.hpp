@@ -23,6 +23,7 @@
 #include "storage/document.hpp"
 #include "storage/resource_mapper.hpp"
 
+#include <utility>
 #include <vector>
 
 namespace fetch {
@@ -38,6 +39,10 @@ public:
   using StateValue      = byte_array::ConstByteArray;
   using ShardIndex      = uint32_t;
   using Keys            = std::vector<storage::ResourceID>;
+  using Addresses       = std::vector<ResourceAddress>;
+  using Documents       = std::vector<Document>;
+  using KeyValue        = std::pair<ResourceAddress, StateValue>;
+  using KeyValues       = std::vector<KeyValue>;
 
   // Construction / Destruction
   StorageInterface()          = default;
@@ -53,6 +58,12 @@ public:
   virtual Keys     KeyDump() const                                          = 0;
   virtual void     Reset()                                                  = 0;
   /// @}
+
+  /// @name Batched State Interface
+  /// @{
+  virtual Documents GetMany(Addresses const &keys);
+  virtual void      SetMany(KeyValues const &values);
+  /// @}
 };
 
 class StorageUnitInterface : public StorageInterface
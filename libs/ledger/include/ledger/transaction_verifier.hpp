@@ -23,6 +23,7 @@
 #include <cstddef>
 #include <memory>
 #include <thread>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
@@ -33,13 +34,14 @@ class TransactionSink;
 class TransactionVerifier
 {
 public:
-  static constexpr char const *LOGGING_NAME = "TxVerifier";
+  static constexpr char const *LOGGING_NAME       = "TxVerifier";
+  static constexpr std::size_t  DEFAULT_BATCH_SIZE = 64;
 
   using TransactionPtr = std::shared_ptr<Transaction>;
 
   // Construction / Destruction
-  TransactionVerifier(TransactionSink &sink, std::size_t verifying_threads,
-                      std::string const &name);
+  TransactionVerifier(TransactionSink &sink, std::size_t verifying_threads, std::string const &name,
+                      std::size_t batch_size = DEFAULT_BATCH_SIZE);
   TransactionVerifier(TransactionVerifier const &) = delete;
   TransactionVerifier(TransactionVerifier &&)      = delete;
   ~TransactionVerifier();
@@ -71,11 +73,15 @@ private:
   using Sink            = TransactionSink;
   using GaugePtr        = telemetry::GaugePtr<uint64_t>;
   using CounterPtr      = telemetry::CounterPtr;
+  using HistogramPtr    = telemetry::HistogramPtr;
+  using TransactionList = std::vector<TransactionPtr>;
 
   void Verifier();
+  void VerifyBatch(TransactionList &batch);
   void Dispatcher();
 
   std::size_t const verifying_threads_;
+  std::size_t const batch_size_;
   std::string const name_;
   Sink &            sink_;
   Flag              active_{true};
@@ -84,15 +90,16 @@ private:
   UnverifiedQueue   unverified_queue_;
 
   // telemetry
-  GaugePtr   unverified_queue_length_;
-  GaugePtr   unverified_queue_max_length_;
-  GaugePtr   verified_queue_length_;
-  GaugePtr   verified_queue_max_length_;
-  CounterPtr unverified_tx_total_;
-  CounterPtr verified_tx_total_;
-  CounterPtr discarded_tx_total_;
-  CounterPtr dispatched_tx_total_;
-  GaugePtr   num_threads_;
+  GaugePtr     unverified_queue_length_;
+  GaugePtr     unverified_queue_max_length_;
+  GaugePtr     verified_queue_length_;
+  GaugePtr     verified_queue_max_length_;
+  CounterPtr   unverified_tx_total_;
+  CounterPtr   verified_tx_total_;
+  CounterPtr   discarded_tx_total_;
+  CounterPtr   dispatched_tx_total_;
+  GaugePtr     num_threads_;
+  HistogramPtr batch_sizes_;
 };
 
 }  // namespace ledger
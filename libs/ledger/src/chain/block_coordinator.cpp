@@ -35,8 +35,10 @@
 #include "ledger/upow/synergetic_execution_manager.hpp"
 #include "ledger/upow/synergetic_executor.hpp"
 #include "telemetry/counter.hpp"
+#include "telemetry/counter_map.hpp"
 #include "telemetry/gauge.hpp"
 #include "telemetry/histogram.hpp"
+#include "telemetry/histogram_map.hpp"
 #include "telemetry/registry.hpp"
 
 #include <cassert>
@@ -44,6 +46,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <thread>
 #include <utility>
 
 namespace fetch {
@@ -69,6 +72,7 @@ const std::size_t               MIN_BLOCK_SYNC_SLIPPAGE_FOR_WAITLESS_SYNC_OF_MIS
 const std::chrono::seconds      WAIT_FOR_TX_TIMEOUT_INTERVAL{600};
 const uint32_t                  THRESHOLD_FOR_FAST_SYNCING{100u};
 const std::size_t               DIGEST_LENGTH_BYTES{32};
+const std::chrono::milliseconds COMMIT_POLL_INTERVAL{5};
 
 SynergeticExecMgrPtr CreateSynergeticExecutor(DAGPtr dag, StorageUnitInterface &storage_unit)
 {
@@ -180,6 +184,15 @@ BlockCoordinator::BlockCoordinator(MainChain &chain, DAGPtr dag,
         "The number of the next block which is scheduled to be executed by the block coordinator")}
   , block_hash_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
         "block_hash", "The last seen block hash beginning")}
+  , commit_in_progress_gauge_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
+        "ledger_block_coordinator_commit_in_progress",
+        "Signals if the state of a block is currently being committed in the background")}
+  , stage_durations_{telemetry::Registry::Instance().CreateHistogramMap(
+        {0.0001, 0.001, 0.01, 0.1, 1, 10, 100}, "ledger_block_coordinator_stage_duration_seconds",
+        "stage", "The histogram of the time spent in each stage of the block coordinator")}
+  , overlapped_stage_count_{telemetry::Registry::Instance().CreateCounterMap(
+        "ledger_block_coordinator_overlapped_stage_total",
+        "The total number of times a stage was entered while a commit was in progress")}
 {
   // configure the state machine
   // clang-format off
@@ -207,18 +220,43 @@ BlockCoordinator::BlockCoordinator(MainChain &chain, DAGPtr dag,
   // clang-format on
 
   state_machine_->OnStateChange([this](State current, State previous) {
-    FETCH_UNUSED(this);
     if (periodic_print_.Poll())
     {
       FETCH_LOG_INFO(LOGGING_NAME, "Current state: ", ToString(current),
                      " (previous: ", ToString(previous), ")");
     }
+
+    // record the occupancy of the stage that has just been left
+    auto const now = StageClock::now();
+    stage_durations_->Add(ToString(previous), ToSeconds(now - stage_start_));
+    stage_start_ = now;
+
+    if (commit_in_progress_)
+    {
+      overlapped_stage_count_->Increment({{"stage", ToString(current)}});
+    }
   });
 
+  stage_start_ = StageClock::now();
+
   // TODO(private issue 792): this shouldn't be here, but if it is, it locks the whole system on
   // startup. RecoverFromStartup();
 }
 
+BlockCoordinator::~BlockCoordinator()
+{
+  // ensure that any outstanding commit has completed before tearing down
+  while (commit_in_progress_)
+  {
+    std::this_thread::sleep_for(COMMIT_POLL_INTERVAL);
+  }
+
+  if (commit_pool_)
+  {
+    commit_pool_->Stop();
+  }
+}
+
 /**
  * Force the block interval to expire causing the state machine to be able to generate a block if
  * needed
@@ -235,6 +273,11 @@ BlockCoordinator::State BlockCoordinator::OnReloadState()
 {
   reload_state_count_->increment();
 
+  if (WaitForPendingCommit())
+  {
+    return State::RELOAD_STATE;
+  }
+
   // if no current block then this is the first time in the state therefore lookup the heaviest
   // block
   if (!current_block_)
@@ -296,11 +339,13 @@ BlockCoordinator::State BlockCoordinator::OnSynchronising()
   bool const extra_debug = syncing_periodic_.Poll();
 
   // cache some useful variables
+  // the state hashes are not queried while contending with a background commit
+  bool const     committing           = commit_in_progress_;
   auto const     current_hash         = current_block_->body.hash;
   auto const     previous_hash        = current_block_->body.previous_hash;
   auto const     desired_state        = current_block_->body.merkle_hash;
-  auto const     last_committed_state = storage_unit_.LastCommitHash();
-  auto const     current_state        = storage_unit_.CurrentHash();
+  auto const     last_committed_state = committing ? Digest{} : storage_unit_.LastCommitHash();
+  auto const     current_state        = committing ? Digest{} : storage_unit_.CurrentHash();
   auto const     last_processed_block = execution_manager_.LastProcessedBlock();
   uint64_t const current_dag_epoch    = dag_ ? dag_->CurrentEpoch() : 0;
 
@@ -398,10 +443,21 @@ BlockCoordinator::State BlockCoordinator::OnSynchronising()
                      next_block->body.block_number, " of ", current_block_->body.block_number, ")");
     }
 
+    // when the state of the common parent is still being committed in the background the storage
+    // is already at the desired state and the next block can be started straight away. Otherwise
+    // the commit needs to complete before the storage can be examined.
+    bool const parent_committing =
+        commit_in_progress_ && (common_parent->body.hash == committing_block_);
+
+    if (!parent_committing && WaitForPendingCommit())
+    {
+      return State::SYNCHRONISING;
+    }
+
     // we expect that the common parent in this case will always have been processed, but this
     // should be checked
-    if (!storage_unit_.HashExists(common_parent->body.merkle_hash,
-                                  common_parent->body.block_number))
+    if (!parent_committing && !storage_unit_.HashExists(common_parent->body.merkle_hash,
+                                                        common_parent->body.block_number))
     {
       FETCH_LOG_ERROR(LOGGING_NAME, "Ancestor block's state hash cannot be retrieved for block: 0x",
                       current_hash.ToHex(), " number: ", common_parent->body.block_number,
@@ -427,8 +483,8 @@ BlockCoordinator::State BlockCoordinator::OnSynchronising()
     }
 
     // revert the storage back to the known state
-    if (!storage_unit_.RevertToHash(common_parent->body.merkle_hash,
-                                    common_parent->body.block_number))
+    if (!parent_committing && !storage_unit_.RevertToHash(common_parent->body.merkle_hash,
+                                                          common_parent->body.block_number))
     {
       FETCH_LOG_ERROR(LOGGING_NAME, "Unable to restore state for block", ToBase64(current_hash));
 
@@ -624,6 +680,11 @@ BlockCoordinator::State BlockCoordinator::OnSynergeticExecution()
 {
   syn_exec_state_count_->count();
 
+  if (WaitForPendingCommit())
+  {
+    return State::SYNERGETIC_EXECUTION;
+  }
+
   bool const is_genesis = current_block_->body.previous_hash == GENESIS_DIGEST;
 
   // Executing synergetic work
@@ -761,6 +822,15 @@ BlockCoordinator::State BlockCoordinator::OnWaitForTransactions(State current, S
     // clear the pending transaction set
     pending_txs_.reset();
 
+    // while the previous block is still being committed, use the time to plan the execution of
+    // this block ahead of it being scheduled
+    if (commit_in_progress_)
+    {
+      auto const start = StageClock::now();
+      execution_manager_.PrepareExecution(current_block_->body);
+      stage_durations_->Add("Plan Execution", ToSeconds(StageClock::now() - start));
+    }
+
     return State::SYNERGETIC_EXECUTION;
   }
 
@@ -785,6 +855,11 @@ BlockCoordinator::State BlockCoordinator::OnScheduleBlockExecution()
 {
   sch_block_state_count_->increment();
 
+  if (WaitForPendingCommit())
+  {
+    return State::SCHEDULE_BLOCK_EXECUTION;
+  }
+
   State next_state{State::RESET};
 
   // schedule the current block for execution
@@ -905,7 +980,7 @@ BlockCoordinator::State BlockCoordinator::OnPostExecBlockValidation()
   else
   {
     // Commit this state
-    storage_unit_.Commit(current_block_->body.block_number);
+    CommitState(*current_block_);
 
     // Notify the DAG of this epoch
     if (dag_)
@@ -953,6 +1028,11 @@ BlockCoordinator::State BlockCoordinator::OnNewSynergeticExecution()
 {
   new_syn_state_count_->increment();
 
+  if (WaitForPendingCommit())
+  {
+    return State::NEW_SYNERGETIC_EXECUTION;
+  }
+
   if (synergetic_exec_mgr_ && dag_)
   {
     // lookup the previous block
@@ -982,6 +1062,11 @@ BlockCoordinator::State BlockCoordinator::OnExecuteNewBlock()
 {
   new_exec_state_count_->increment();
 
+  if (WaitForPendingCommit())
+  {
+    return State::EXECUTE_NEW_BLOCK;
+  }
+
   State next_state{State::RESET};
 
   // schedule the current block for execution
@@ -1012,7 +1097,7 @@ BlockCoordinator::State BlockCoordinator::OnWaitForNewBlockExecution()
     FETCH_LOG_DEBUG(LOGGING_NAME, "Merkle Hash: ", ToBase64(next_block_->body.merkle_hash));
 
     // Commit the state generated by this block
-    storage_unit_.Commit(next_block_->body.block_number);
+    CommitState(*next_block_);
 
     // Notify the DAG of this epoch
     if (dag_)
@@ -1233,6 +1318,63 @@ void BlockCoordinator::UpdateNextBlockTime()
   next_block_time_ = Clock::now() + block_period_;
 }
 
+/**
+ * Commit the current state of the storage unit as the state of the specified block. When
+ * pipelining is enabled the commit is made by the background worker and this function returns
+ * immediately.
+ *
+ * @param block The block whose state is to be committed
+ */
+void BlockCoordinator::CommitState(Block const &block)
+{
+  uint64_t const block_number = block.body.block_number;
+
+  auto const commit = [this, block_number]() {
+    auto const start = StageClock::now();
+
+    storage_unit_.Commit(block_number);
+
+    stage_durations_->Add("Commit", ToSeconds(StageClock::now() - start));
+  };
+
+  if (pipelined_ && commit_pool_)
+  {
+    committing_block_   = block.body.hash;
+    commit_in_progress_ = true;
+    commit_in_progress_gauge_->set(1u);
+
+    commit_pool_->Post([this, commit]() {
+      commit();
+
+      commit_in_progress_gauge_->set(0u);
+      commit_in_progress_ = false;
+    });
+  }
+  else
+  {
+    commit();
+  }
+}
+
+/**
+ * Determine if the state machine must hold off from modifying the state database because a
+ * background commit has not yet completed. In this case the next invocation of the state machine
+ * is delayed slightly.
+ *
+ * @return true if the caller should wait, otherwise false
+ */
+bool BlockCoordinator::WaitForPendingCommit()
+{
+  bool const pending = commit_in_progress_;
+
+  if (pending)
+  {
+    state_machine_->Delay(COMMIT_POLL_INTERVAL);
+  }
+
+  return pending;
+}
+
 char const *BlockCoordinator::ToString(State state)
 {
   char const *text = "Unknown";
@@ -1327,5 +1469,23 @@ void BlockCoordinator::EnableMining(bool enable)
   mining_enabled_ = enable;
 }
 
+/**
+ * Enable or disable the pipelining of block commits. When enabled the state of each block is
+ * committed in the background while the coordinator moves on to the next block. This should be
+ * configured before the state machine is started.
+ *
+ * @param enable The flag to signal pipelined operation
+ */
+void BlockCoordinator::EnablePipelining(bool enable)
+{
+  if (enable && !commit_pool_)
+  {
+    commit_pool_ = network::MakeThreadPool(1, "BC:Commit");
+    commit_pool_->Start();
+  }
+
+  pipelined_ = enable;
+}
+
 }  // namespace ledger
 }  // namespace fetch
@@ -37,6 +37,7 @@
 #include <deque>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -45,6 +46,14 @@ using fetch::generics::MilliTimer;
 
 namespace fetch {
 namespace ledger {
+namespace {
+
+constexpr char const *TX_INDEX_PREFIX = "chain.tx_index";
+
+// the number of blocks between flushes of the transaction index while it is being rebuilt
+constexpr uint64_t TX_INDEX_REBUILD_INTERVAL = 1000;
+
+}  // namespace
 
 /**
  * Constructs the main chain
@@ -91,6 +100,8 @@ MainChain::~MainChain()
   {
     block_store_->Flush(false);
   }
+
+  tx_index_.Flush();
 }
 
 void MainChain::Reset()
@@ -111,6 +122,9 @@ void MainChain::Reset()
                      std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
   }
 
+  ResetTransactionIndex();
+  RebuildBloomFilter();
+
   auto genesis = CreateGenesisBlock();
 
   // add the block to the cache
@@ -138,9 +152,16 @@ BlockStatus MainChain::AddBlock(Block const &blk)
   FETCH_LOG_DEBUG(LOGGING_NAME, "New Block: 0x", block->body.hash.ToHex(), " -> ", ToString(status),
                   " (weight: ", block->weight, " total: ", block->total_weight, ")");
 
-  if (status == BlockStatus::ADDED)
+  // loose blocks are also indexed since they can become part of the chain at any point
+  if ((status == BlockStatus::ADDED) || (status == BlockStatus::LOOSE))
   {
+    FETCH_LOCK(lock_);
+
+    tx_index_.Add(*block);
     AddBlockToBloomFilter(*block);
+
+    // remove the transactions that can no longer be included in a block
+    tx_index_.Prune(GetHeaviestBlock()->body.block_number);
   }
 
   return status;
@@ -237,7 +258,6 @@ bool MainChain::LoadBlock(BlockHash const &hash, Block &block, BlockHash *next_h
   if (block_store_->Get(storage::ResourceID(hash), record))
   {
     block = record.block;
-    AddBlockToBloomFilter(block);
     if (next_hash != nullptr)
     {
       *next_hash = record.next_hash;
@@ -318,11 +338,25 @@ bool MainChain::RemoveTree(BlockHash const &removed_hash, BlockHashSet &invalida
       }
       references_.erase(children.first, children.second);
 
-      // next, remove the block record from the cache, if found
-      if (block_chain_.erase(hash) != 0u)
+      // next, remove the block record from the cache (and its transactions from the index), if
+      // found
+      auto const it = block_chain_.find(hash);
+      if (it != block_chain_.end())
       {
+        tx_index_.Remove(*it->second);
+        block_chain_.erase(it);
+
         retVal = true;
       }
+      else if (block_store_)
+      {
+        // the block might already have been trimmed from the cache, but it is still indexed
+        Block stored{};
+        if (LoadBlock(hash, stored))
+        {
+          tx_index_.Remove(stored);
+        }
+      }
     }
   }
 
@@ -735,12 +769,14 @@ void MainChain::RecoverFromFile(Mode mode)
     block_store_->New("chain.db", "chain.index.db");
     head_store_.open("chain.head.db",
                      std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+    ResetTransactionIndex();
     return;
   }
   if (Mode::LOAD_PERSISTENT_DB == mode)
   {
     block_store_->Load("chain.db", "chain.index.db");
     head_store_.open("chain.head.db", std::ios::binary | std::ios::in | std::ios::out);
+    tx_index_.Load(TX_INDEX_PREFIX);
   }
   else
   {
@@ -754,11 +790,26 @@ void MainChain::RecoverFromFile(Mode mode)
   // retrieve the starting hash
   BlockHash head_block_hash = GetHeadHash();
 
+  // when the transaction index does not correspond to the head of the stored chain (for example it
+  // was created by a previous version or was not flushed before shutdown) it is rebuilt from the
+  // blocks visited during recovery
+  bool const rebuild_tx_index = (tx_index_.head() != head_block_hash);
+  if (rebuild_tx_index)
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Rebuilding the transaction index");
+    ResetTransactionIndex();
+  }
+
   bool recovery_complete{false};
   if (!head_block_hash.empty() && LoadBlock(head_block_hash, *block))
   {
     auto block_index = block->body.block_number;
 
+    if (rebuild_tx_index)
+    {
+      tx_index_.Add(*block);
+    }
+
     // Save the head
     head = block;
 
@@ -776,6 +827,18 @@ void MainChain::RecoverFromFile(Mode mode)
       }
 
       block_index = next->body.block_number;
+
+      if (rebuild_tx_index)
+      {
+        tx_index_.Add(*next);
+
+        // limit the unflushed part of the index when rebuilding it for a long chain
+        if ((block_index % TX_INDEX_REBUILD_INTERVAL) == 0)
+        {
+          tx_index_.Prune(head->body.block_number);
+          tx_index_.Flush();
+        }
+      }
     }
 
     if (block_index != 0)
@@ -810,6 +873,15 @@ void MainChain::RecoverFromFile(Mode mode)
       FETCH_LOG_INFO(LOGGING_NAME, "Heaviest block now: ", heaviest_block_num);
       FETCH_LOG_INFO(LOGGING_NAME, "Heaviest block weight: ", GetHeaviestBlock()->total_weight);
 
+      tx_index_.Prune(heaviest_block_num);
+      FETCH_LOG_INFO(LOGGING_NAME, "Transaction index size: ", tx_index_.size());
+
+      if (rebuild_tx_index)
+      {
+        tx_index_.SetHead(head_block_hash);
+        tx_index_.Flush();
+      }
+
       // signal that the recovery was successful
       recovery_complete = true;
     }
@@ -829,7 +901,11 @@ void MainChain::RecoverFromFile(Mode mode)
     head_store_.close();
     head_store_.open("chain.head.db",
                      std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+
+    ResetTransactionIndex();
   }
+
+  RebuildBloomFilter();
 }
 
 /**
@@ -917,6 +993,8 @@ void MainChain::WriteToFile()
 
     // Force flush of the file object!
     block_store_->Flush(false);
+    tx_index_.SetHead(GetHeadHash());
+    tx_index_.Flush();
 
     // as final step do some sanity checks
     TrimCache();
@@ -1013,6 +1091,32 @@ void MainChain::FlushBlock(IntBlockPtr const &block)
   tips_.erase(block->body.hash);
 }
 
+/**
+ * Internal: Clear the transaction index, recreating the persistent copy when the chain is backed
+ * by storage
+ */
+void MainChain::ResetTransactionIndex()
+{
+  if (block_store_)
+  {
+    tx_index_.New(TX_INDEX_PREFIX);
+  }
+  else
+  {
+    tx_index_.Clear();
+  }
+}
+
+/**
+ * Internal: Repopulate the bloom filter from the contents of the transaction index
+ */
+void MainChain::RebuildBloomFilter()
+{
+  bloom_filter_ = std::make_unique<BasicBloomFilter>();
+
+  tx_index_.VisitDigests([this](Digest const &digest) { bloom_filter_->Add(digest); });
+}
+
 // We have added a non-loose block. It is then safe to lock the loose blocks map and
 // walk through it adding the blocks, so long as we do breadth first search (!!)
 void MainChain::CompleteLooseBlocks(IntBlockPtr const &block)
@@ -1527,10 +1631,14 @@ void MainChain::SetHeadHash(BlockHash const &hash)
 DigestSet MainChain::DetectDuplicateTransactions(BlockHash const &starting_hash,
                                                  DigestSet const &transactions) const
 {
+  using PendingMap = std::unordered_map<BlockHash, std::vector<Digest>>;
+
   MilliTimer const timer{"DuplicateTransactionsCheck", 100};
 
   FETCH_LOG_DEBUG(LOGGING_NAME, "Starting TX uniqueness verify");
 
+  FETCH_LOCK(lock_);
+
   IntBlockPtr block;
   if (!LookupBlock(starting_hash, block, false) || block->is_loose)
   {
@@ -1552,41 +1660,50 @@ DigestSet MainChain::DetectDuplicateTransactions(BlockHash const &starting_hash,
     bloom_filter_query_count_->increment();
   }
 
-  auto search_chain_for_duplicates =
-      [this, block](DigestSet const &transaction_digests) mutable -> DigestSet {
-    DigestSet duplicates{};
-    for (;;)
-    {
-      // Traversing the chain fully is costly: break out early if we know the transactions are all
-      // duplicated (or both sets are empty)
-      if (transaction_digests.size() == duplicates.size())
-      {
-        break;
-      }
+  DigestSet const &candidates = enable_bloom_filter_ ? potential_duplicates : transactions;
 
-      for (auto const &slice : block->body.slices)
-      {
-        for (auto const &tx : slice)
-        {
-          if (transaction_digests.find(tx.digest()) != transaction_digests.end())
-          {
-            duplicates.insert(tx.digest());
-          }
-        }
-      }
+  // probe the index for the blocks containing each of the transactions. Only the blocks which are
+  // not above the starting block can be ancestors of it
+  uint64_t const starting_block_number = block->body.block_number;
+  uint64_t       lowest_block_number   = starting_block_number;
 
-      // exit the loop once we can no longer find the block
-      if (!LookupBlock(block->body.previous_hash, block, false))
+  PendingMap                  pending{};
+  TransactionIndex::Locations locations{};
+  for (auto const &digest : candidates)
+  {
+    if (!tx_index_.Lookup(digest, locations))
+    {
+      continue;
+    }
+
+    for (auto const &location : locations)
+    {
+      if (location.block_number <= starting_block_number)
       {
-        break;
+        pending[location.hash].push_back(digest);
+        lowest_block_number = std::min(lowest_block_number, location.block_number);
       }
     }
+  }
 
-    return duplicates;
-  };
+  // walk down the chain only as far as the lowest of the blocks found in the index, in order to
+  // determine which of them are ancestors of the starting block
+  DigestSet duplicates{};
+  while (!pending.empty())
+  {
+    auto const it = pending.find(block->body.hash);
+    if (it != pending.end())
+    {
+      duplicates.insert(it->second.begin(), it->second.end());
+      pending.erase(it);
+    }
 
-  DigestSet const duplicates =
-      search_chain_for_duplicates(enable_bloom_filter_ ? potential_duplicates : transactions);
+    if ((block->body.block_number <= lowest_block_number) ||
+        !LookupBlock(block->body.previous_hash, block, false))
+    {
+      break;
+    }
+  }
 
   auto const false_positives = potential_duplicates.size() - duplicates.size();
 
@@ -55,8 +55,9 @@ bool Transaction::Verify()
     // clear the verified flag
     verified_ = false;
 
-    // generate the payload for this transaction
-    ConstByteArray payload = TransactionSerializer::SerializePayload(*this);
+    // reuse the retained payload bytes when available, otherwise generate them
+    ConstByteArray payload =
+        payload_.empty() ? ConstByteArray{TransactionSerializer::SerializePayload(*this)} : payload_;
 
     // ensure that there are some signatories (otherwise it is invalid)
     if (!signatories_.empty())
@@ -137,7 +137,8 @@ TransactionBuilder::TransactionPtr TransactionBuilder::Sealer::Build()
   if (valid)
   {
     // generate the final transaction
-    partial_transaction_->digest_ = hash_function.Final();
+    partial_transaction_->digest_  = hash_function.Final();
+    partial_transaction_->payload_ = serialized_payload_;
 
     tx = std::move(partial_transaction_);
   }
@@ -0,0 +1,467 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/constants.hpp"
+#include "ledger/chain/transaction_index.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+std::size_t const HEAD_LENGTH = 32;
+
+storage::ResourceAddress ExpiryKey(uint64_t valid_until)
+{
+  return storage::ResourceAddress{"tx_index.expiry." + std::to_string(valid_until)};
+}
+
+}  // namespace
+
+TransactionIndex::~TransactionIndex()
+{
+  Flush();
+}
+
+/**
+ * Create a new (empty) persistent index, clearing any existing contents
+ *
+ * @param prefix The path prefix of the files of the index
+ */
+void TransactionIndex::New(std::string const &prefix)
+{
+  Open(prefix, true);
+}
+
+/**
+ * Load a persistent index from disk. Only the block numbers at which the indexed transactions
+ * expire are read into memory.
+ *
+ * @param prefix The path prefix of the files of the index
+ */
+void TransactionIndex::Load(std::string const &prefix)
+{
+  Open(prefix, false);
+}
+
+/**
+ * Write the changes made since the last flush to the persistent index (if present). The head is
+ * cleared while the changes are written, so that an interrupted flush is detected as a stale index.
+ */
+void TransactionIndex::Flush()
+{
+  if (!store_)
+  {
+    return;
+  }
+
+  WriteHead(Block::Hash{});
+
+  for (auto const &element : records_)
+  {
+    if (element.second.locations.empty())
+    {
+      store_->Erase(storage::ResourceID{element.first});
+    }
+    else
+    {
+      store_->Set(storage::ResourceID{element.first}, element.second);
+    }
+  }
+
+  for (auto const valid_until : removed_expiry_)
+  {
+    expiry_store_->Erase(ExpiryKey(valid_until));
+  }
+
+  // merge the new digests into those already stored for each block number
+  for (auto const &element : expiry_)
+  {
+    TransactionIndexExpiry expiry{};
+    expiry_store_->Get(ExpiryKey(element.first), expiry);
+
+    DigestSet digests{expiry.digests.begin(), expiry.digests.end()};
+    digests.insert(element.second.begin(), element.second.end());
+
+    expiry.valid_until = element.first;
+    expiry.digests.assign(digests.begin(), digests.end());
+    expiry_store_->Set(ExpiryKey(element.first), expiry);
+
+    stored_expiry_.insert(element.first);
+  }
+
+  records_.clear();
+  expiry_.clear();
+  removed_expiry_.clear();
+
+  store_->Flush(false);
+  expiry_store_->Flush(false);
+
+  WriteHead(head_);
+}
+
+/**
+ * Set the chain head which the index corresponds to, recorded by the next flush
+ *
+ * @param hash The hash of the head block
+ */
+void TransactionIndex::SetHead(Block::Hash const &hash)
+{
+  head_ = hash;
+}
+
+/**
+ * Get the chain head which the index corresponds to. This is empty when the index has not been
+ * flushed completely.
+ *
+ * @return The hash of the head block
+ */
+Block::Hash const &TransactionIndex::head() const
+{
+  return head_;
+}
+
+/**
+ * Add all the transactions of the specified block to the index
+ *
+ * @param block The block to be indexed
+ */
+void TransactionIndex::Add(Block const &block)
+{
+  Location const location{block.body.hash, block.body.block_number};
+
+  for (auto const &slice : block.body.slices)
+  {
+    for (auto const &tx : slice)
+    {
+      Record record{};
+      if (!Get(tx.digest(), record))
+      {
+        record.digest      = tx.digest();
+        record.valid_until = tx.valid_until();
+        record.locations.push_back(location);
+
+        Put(record);
+        expiry_[record.valid_until].insert(record.digest);
+        ++count_;
+        continue;
+      }
+
+      auto      &locations = record.locations;
+
+      bool const present =
+          std::any_of(locations.begin(), locations.end(),
+                      [&location](Location const &other) { return other.hash == location.hash; });
+
+      if (!present)
+      {
+        locations.push_back(location);
+        Put(record);
+      }
+    }
+  }
+}
+
+/**
+ * Remove all the references to the specified block from the index
+ *
+ * @param block The block to be removed
+ */
+void TransactionIndex::Remove(Block const &block)
+{
+  for (auto const &slice : block.body.slices)
+  {
+    for (auto const &tx : slice)
+    {
+      Record record{};
+      if (!Get(tx.digest(), record))
+      {
+        continue;
+      }
+
+      auto      &locations = record.locations;
+      auto const original  = locations.size();
+
+      locations.erase(std::remove_if(locations.begin(), locations.end(),
+                                     [&block](Location const &location) {
+                                       return location.hash == block.body.hash;
+                                     }),
+                      locations.end());
+
+      if (locations.empty())
+      {
+        Drop(record.digest);
+        --count_;
+      }
+      else if (locations.size() != original)
+      {
+        Put(record);
+      }
+    }
+  }
+}
+
+/**
+ * Lookup the blocks which contain the specified transaction
+ *
+ * @param digest The digest of the transaction
+ * @param locations The locations of the transaction to be populated
+ * @return true if the transaction is present, otherwise false
+ */
+bool TransactionIndex::Lookup(Digest const &digest, Locations &locations) const
+{
+  Record record{};
+  if (!Get(digest, record))
+  {
+    return false;
+  }
+
+  locations = std::move(record.locations);
+  return true;
+}
+
+/**
+ * Remove all the transactions which can no longer be included in a block on any fork of the chain.
+ *
+ * A transaction is retained until the chain has progressed beyond its valid until block number by
+ * more than the finality period. This relies on the executor rejecting every transaction which is
+ * not valid for the block, otherwise a pruned transaction could be included again.
+ *
+ * @param block_number The current block number of the heaviest chain
+ * @return The number of transactions which have been removed
+ */
+std::size_t TransactionIndex::Prune(uint64_t block_number)
+{
+  if (block_number < FINALITY_PERIOD)
+  {
+    return 0;
+  }
+
+  uint64_t const threshold = block_number - FINALITY_PERIOD;
+
+  std::size_t count{0};
+  uint64_t    valid_until{0};
+  while (NextExpiry(valid_until) && (valid_until <= threshold))
+  {
+    for (auto const &digest : TakeExpiry(valid_until))
+    {
+      // the transaction might have been removed (and added again) since it was recorded
+      Record record{};
+      if (Get(digest, record) && (record.valid_until == valid_until))
+      {
+        Drop(digest);
+        --count_;
+        ++count;
+      }
+    }
+  }
+
+  return count;
+}
+
+/**
+ * Remove all the contents of the in memory index. The persistent index is not modified.
+ */
+void TransactionIndex::Clear()
+{
+  records_.clear();
+  expiry_.clear();
+  stored_expiry_.clear();
+  removed_expiry_.clear();
+  count_ = 0;
+  head_  = Block::Hash{};
+}
+
+std::size_t TransactionIndex::size() const
+{
+  return count_;
+}
+
+void TransactionIndex::Open(std::string const &prefix, bool create)
+{
+  Clear();
+
+  store_        = std::make_unique<Store>();
+  expiry_store_ = std::make_unique<ExpiryStore>();
+
+  std::string const head_file = prefix + ".head.db";
+
+  if (create)
+  {
+    store_->New(prefix + ".db", prefix + ".index.db");
+    expiry_store_->New(prefix + ".expiry.db", prefix + ".expiry.index.db");
+    head_file_ = std::fstream(head_file, std::ios::binary | std::ios::in | std::ios::out |
+                                             std::ios::trunc);
+    return;
+  }
+
+  store_->Load(prefix + ".db", prefix + ".index.db");
+  expiry_store_->Load(prefix + ".expiry.db", prefix + ".expiry.index.db");
+
+  for (auto it = expiry_store_->begin(), end = expiry_store_->end(); it != end; ++it)
+  {
+    stored_expiry_.insert((*it).valid_until);
+  }
+
+  count_ = store_->size();
+
+  // an index created by a previous version has no head, and is therefore treated as stale
+  head_file_ = std::fstream(head_file, std::ios::binary | std::ios::in | std::ios::out);
+  if (!head_file_)
+  {
+    head_file_ = std::fstream(head_file, std::ios::binary | std::ios::in | std::ios::out |
+                                             std::ios::trunc);
+    return;
+  }
+
+  byte_array::ByteArray buffer;
+  buffer.Resize(HEAD_LENGTH);
+
+  bool const read = static_cast<bool>(head_file_.read(
+      reinterpret_cast<char *>(buffer.pointer()), static_cast<std::streamsize>(buffer.size())));
+
+  // an interrupted flush leaves the head cleared
+  if (read && std::any_of(buffer.pointer(), buffer.pointer() + HEAD_LENGTH,
+                          [](uint8_t value) { return value != 0; }))
+  {
+    head_ = buffer;
+  }
+
+  head_file_.clear();
+}
+
+bool TransactionIndex::Get(Digest const &digest, Record &record) const
+{
+  auto const it = records_.find(digest);
+  if (it != records_.end())
+  {
+    record = it->second;
+
+    // removals which have not been flushed are recorded without any locations
+    return !record.locations.empty();
+  }
+
+  return store_ && store_->Get(storage::ResourceID{digest}, record);
+}
+
+void TransactionIndex::Put(Record const &record)
+{
+  records_[record.digest] = record;
+}
+
+void TransactionIndex::Drop(Digest const &digest)
+{
+  // records which have never been flushed do not need to be removed from the store
+  if (store_ && store_->Has(storage::ResourceID{digest}))
+  {
+    Record removed{};
+    removed.digest   = digest;
+    records_[digest] = removed;
+  }
+  else
+  {
+    records_.erase(digest);
+  }
+}
+
+/**
+ * Determine the lowest block number at which any of the indexed transactions expire
+ *
+ * @param valid_until The block number to be populated
+ * @return true if there are any transactions, otherwise false
+ */
+bool TransactionIndex::NextExpiry(uint64_t &valid_until) const
+{
+  if (expiry_.empty() && stored_expiry_.empty())
+  {
+    return false;
+  }
+
+  if (expiry_.empty())
+  {
+    valid_until = *stored_expiry_.begin();
+  }
+  else if (stored_expiry_.empty())
+  {
+    valid_until = expiry_.begin()->first;
+  }
+  else
+  {
+    valid_until = std::min(expiry_.begin()->first, *stored_expiry_.begin());
+  }
+
+  return true;
+}
+
+/**
+ * Remove the digests of the transactions which expire at the specified block number from the
+ * expiry index
+ *
+ * @param valid_until The block number
+ * @return The digests of the transactions
+ */
+DigestSet TransactionIndex::TakeExpiry(uint64_t valid_until)
+{
+  DigestSet digests{};
+
+  auto const it = expiry_.find(valid_until);
+  if (it != expiry_.end())
+  {
+    digests = std::move(it->second);
+    expiry_.erase(it);
+  }
+
+  if (stored_expiry_.erase(valid_until) != 0)
+  {
+    TransactionIndexExpiry expiry{};
+    if (expiry_store_->Get(ExpiryKey(valid_until), expiry))
+    {
+      digests.insert(expiry.digests.begin(), expiry.digests.end());
+    }
+
+    removed_expiry_.insert(valid_until);
+  }
+
+  return digests;
+}
+
+void TransactionIndex::WriteHead(Block::Hash const &hash)
+{
+  byte_array::ByteArray buffer;
+  buffer.Resize(HEAD_LENGTH);
+  std::fill(buffer.pointer(), buffer.pointer() + HEAD_LENGTH, uint8_t{0});
+
+  if (hash.size() == HEAD_LENGTH)
+  {
+    std::copy(hash.pointer(), hash.pointer() + HEAD_LENGTH, buffer.pointer());
+  }
+
+  head_file_.seekp(0);
+  head_file_.write(reinterpret_cast<char const *>(buffer.pointer()),
+                   static_cast<std::streamsize>(buffer.size()));
+  head_file_.flush();
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -333,10 +333,28 @@ ByteArray TransactionSerializer::SerializePayload(Transaction const &tx)
   return buffer;
 }
 
+/**
+ * Serialize the specified transaction into the internal buffer
+ *
+ * When the transaction has retained the bytes of its payload (because it was built or deserialized
+ * locally) these are copied directly rather than encoding the transaction fields again.
+ *
+ * @param tx The transaction to be serialized
+ * @return true if successful, otherwise false
+ */
 bool TransactionSerializer::Serialize(Transaction const &tx)
 {
-  // serialize the actual buffer
-  auto buffer = SerializePayload(tx);
+  ByteArray buffer;
+  if (tx.payload_.empty())
+  {
+    // serialize the actual buffer
+    buffer = SerializePayload(tx);
+  }
+  else
+  {
+    buffer.Reserve(tx.payload_.size() + (tx.signatories().size() * 128u));
+    buffer.Append(tx.payload_);
+  }
 
   for (auto const &signatory : tx.signatories())
   {
@@ -349,7 +367,18 @@ bool TransactionSerializer::Serialize(Transaction const &tx)
   return true;
 }
 
-bool TransactionSerializer::Deserialize(Transaction &tx) const
+/**
+ * Deserialize a transaction from the internal buffer
+ *
+ * When requested, the transaction retains a zero-copy view of the payload region of the buffer. This
+ * allows subsequent verification and re-serialization to avoid encoding the payload again, at the
+ * cost of keeping the underlying buffer alive for the lifetime of the transaction.
+ *
+ * @param tx The output transaction to be populated
+ * @param retain_payload Flag to signal that the payload bytes should be retained in the transaction
+ * @return true if successful, otherwise false
+ */
+bool TransactionSerializer::Deserialize(Transaction &tx, bool retain_payload) const
 {
   serializers::MsgPackSerializer buffer{serial_data_};
 
@@ -545,8 +574,10 @@ bool TransactionSerializer::Deserialize(Transaction &tx) const
   std::size_t const payload_end  = buffer.tell();
   std::size_t const payload_size = payload_end - payload_start;
 
+  ConstByteArray const payload = buffer.data().SubArray(payload_start, payload_size);
+
   crypto::SHA256 hash_function{};
-  hash_function.Update(buffer.data().SubArray(payload_start, payload_size));
+  hash_function.Update(payload);
 
   for (std::size_t i = 0; i < num_signatures; ++i)
   {
@@ -557,7 +588,8 @@ bool TransactionSerializer::Deserialize(Transaction &tx) const
   }
 
   // compute the hash function
-  tx.digest_ = hash_function.Final();
+  tx.digest_  = hash_function.Final();
+  tx.payload_ = retain_payload ? payload : ConstByteArray{};
 
   return true;
 }
@@ -34,6 +34,7 @@
 #include "vm/function_decorators.hpp"
 #include "vm/module.hpp"
 #include "vm/string.hpp"
+#include "vm/vm.hpp"
 #include "vm_modules/vm_factory.hpp"
 
 #include <algorithm>
@@ -89,6 +90,44 @@ constexpr char const *LOGGING_NAME = "SmartContract";
 
 }  // namespace
 
+/**
+ * Scoped ownership of a VM instance from the contract's pool. The instance is reset and returned
+ * to the pool when the lease goes out of scope.
+ */
+class SmartContract::VMLease
+{
+public:
+  // Construction / Destruction
+  explicit VMLease(SmartContract &contract)
+    : contract_{contract}
+    , vm_{contract.AcquireVM()}
+  {}
+  VMLease(VMLease const &) = delete;
+  VMLease(VMLease &&)      = delete;
+  ~VMLease()
+  {
+    contract_.ReleaseVM(std::move(vm_));
+  }
+
+  vm::VM *get() const
+  {
+    return vm_.get();
+  }
+
+  vm::VM *operator->() const
+  {
+    return vm_.get();
+  }
+
+  // Operators
+  VMLease &operator=(VMLease const &) = delete;
+  VMLease &operator=(VMLease &&) = delete;
+
+private:
+  SmartContract &contract_;
+  VMPtr          vm_;
+};
+
 /**
  * Construct a smart contract from the specified source
  *
@@ -174,6 +213,8 @@ SmartContract::SmartContract(std::string const &source)
   }
 }
 
+SmartContract::~SmartContract() = default;
+
 /**
  * Extract the a given type from the container type and insert it into the parameter pack
  *
@@ -483,7 +524,7 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, Transactio
   }
 
   // Get clean VM instance
-  auto vm = std::make_unique<vm::VM>(module_.get());
+  VMLease vm{*this};
 
   // TODO(WK) inject charge limit
   // vm->SetChargeLimit(123);
@@ -557,7 +598,7 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, Transactio
 Contract::Result SmartContract::InvokeInit(Address const &owner)
 {
   // Get clean VM instance
-  auto vm = std::make_unique<vm::VM>(module_.get());
+  VMLease vm{*this};
 
   // TODO(WK) inject charge limit
   // vm->SetChargeLimit(123);
@@ -619,7 +660,7 @@ SmartContract::Status SmartContract::InvokeQuery(std::string const &name, Query
                                                  Query &response)
 {
   // get clean VM instance
-  auto vm = std::make_unique<vm::VM>(module_.get());
+  VMLease vm{*this};
   vm->SetIOObserver(state());
 
   // lookup the executable
@@ -772,5 +813,45 @@ SmartContract::Status SmartContract::InvokeQuery(std::string const &name, Query
   return Status::OK;
 }
 
+/**
+ * Take an idle VM instance from the pool, or create a new one if the pool is empty
+ *
+ * @return The VM instance
+ */
+SmartContract::VMPtr SmartContract::AcquireVM()
+{
+  {
+    FETCH_LOCK(vm_pool_lock_);
+
+    if (!vm_pool_.empty())
+    {
+      VMPtr vm = std::move(vm_pool_.back());
+      vm_pool_.pop_back();
+
+      return vm;
+    }
+  }
+
+  return std::make_unique<vm::VM>(module_.get());
+}
+
+/**
+ * Reset the VM instance and return it to the pool for later reuse
+ *
+ * @param vm The VM instance
+ */
+void SmartContract::ReleaseVM(VMPtr vm)
+{
+  vm->Reset();
+
+  FETCH_LOCK(vm_pool_lock_);
+
+  // the pool is bounded, any excess instances are simply discarded
+  if (vm_pool_.size() < MAX_POOLED_VMS)
+  {
+    vm_pool_.emplace_back(std::move(vm));
+  }
+}
+
 }  // namespace ledger
 }  // namespace fetch
@@ -57,6 +57,7 @@ ExecutionManager::ExecutionManager(std::size_t num_executors, uint32_t log2_num_
                                    TransactionStatusCache::ShrdPtr tx_status_cache)
   : log2_num_lanes_{log2_num_lanes}
   , storage_{std::move(storage)}
+  , slice_state_{*storage_}
   , thread_pool_{network::MakeThreadPool(num_executors, "Executor")}
   , tx_status_cache_{std::move(tx_status_cache)}
   , tx_executed_count_(Registry::Instance().CreateCounter(
@@ -67,6 +68,12 @@ ExecutionManager::ExecutionManager(std::size_t num_executors, uint32_t log2_num_
         "ledger_exec_mgr_fees_settled_total", "The total number of settle fees rounds"))
   , blocks_completed_count_(Registry::Instance().CreateCounter(
         "ledger_exec_mgr_blocks_completed_total", "The total number of settle fees rounds"))
+  , tx_speculative_count_(Registry::Instance().CreateCounter(
+        "ledger_exec_mgr_tx_speculative_total",
+        "The total number of transactions executed speculatively"))
+  , tx_conflicts_count_(Registry::Instance().CreateCounter(
+        "ledger_exec_mgr_tx_conflicts_total",
+        "The total number of speculatively executed transactions which had to be re-executed"))
   , execution_duration_(Registry::Instance().CreateHistogram(
         {0.000001, 0.000002, 0.000003, 0.000004, 0.000005, 0.000006, 0.000007, 0.000008, 0.000009,
          0.00001,  0.00002,  0.00003,  0.00004,  0.00005,  0.00006,  0.00007,  0.00008,  0.00009,
@@ -191,23 +198,76 @@ ExecutionManager::ScheduleStatus ExecutionManager::Execute(Block::Body const &bl
 
 /**
  * Given a input block, plan the execution of the transactions across the lanes
- * and slices
+ * and slices. If the block has already been planned by PrepareExecution then that plan is used.
  *
  * @param block The input block to plan
  * @return true if successful, otherwise false
  */
 bool ExecutionManager::PlanExecution(Block::Body const &block)
 {
+  ExecutionPlan plan{};
+
+  // lookup the plan if it has been prepared in advance
+  bool prepared{false};
+  {
+    FETCH_LOCK(prepared_plan_lock_);
+
+    if (!prepared_block_.empty() && (prepared_block_ == block.hash))
+    {
+      plan     = std::move(prepared_plan_);
+      prepared = true;
+    }
+
+    prepared_plan_.clear();
+    prepared_block_ = Digest{};
+  }
+
+  if (!prepared)
+  {
+    BuildExecutionPlan(block, plan);
+  }
+
   FETCH_LOCK(execution_plan_lock_);
+  execution_plan_ = std::move(plan);
 
+  return true;
+}
+
+/**
+ * Plan the execution of a block ahead of it being scheduled for execution. This allows the
+ * planning to overlap with other work, for example the commit of the previous block.
+ *
+ * @param block The input block to plan
+ * @return true if successful, otherwise false
+ */
+bool ExecutionManager::PrepareExecution(Block::Body const &block)
+{
+  ExecutionPlan plan{};
+  BuildExecutionPlan(block, plan);
+
+  FETCH_LOCK(prepared_plan_lock_);
+  prepared_plan_  = std::move(plan);
+  prepared_block_ = block.hash;
+
+  return true;
+}
+
+/**
+ * Build the execution plan for the transactions of a block across the lanes and slices
+ *
+ * @param block The input block to plan
+ * @param plan The output execution plan
+ */
+void ExecutionManager::BuildExecutionPlan(Block::Body const &block, ExecutionPlan &plan) const
+{
   // clear and resize the execution plan
-  execution_plan_.clear();
-  execution_plan_.resize(block.slices.size());
+  plan.clear();
+  plan.resize(block.slices.size());
 
   uint64_t slice_index = 0;
   for (auto const &slice : block.slices)
   {
-    auto &slice_plan = execution_plan_[slice_index];
+    auto &slice_plan = plan[slice_index];
 
     // process the transactions
     for (auto const &tx : slice)
@@ -223,8 +283,6 @@ bool ExecutionManager::PlanExecution(Block::Body const &block)
 
     ++slice_index;
   }
-
-  return true;
 }
 
 /**
@@ -233,8 +291,9 @@ bool ExecutionManager::PlanExecution(Block::Body const &block)
  * This function should be called from a context of a thread pool
  *
  * @param item The execution item to dispatch
+ * @param speculative Whether the changes should be held back until the slice is committed
  */
-void ExecutionManager::DispatchExecution(ExecutionItem &item)
+void ExecutionManager::DispatchExecution(ExecutionItem &item, bool speculative)
 {
   ExecutorPtr executor;
 
@@ -258,23 +317,24 @@ void ExecutionManager::DispatchExecution(ExecutionItem &item)
     counters_.ApplyVoid([](auto &counters) { ++counters.active; });
 
     // execute the item
-    item.Execute(*executor);
-    auto const &result{item.result()};
-
-    // determine what the status is
-    if (ExecutorInterface::Status::SUCCESS != result.status)
+    if (speculative)
     {
-      FETCH_LOG_WARN(LOGGING_NAME, "Error executing tx: 0x", item.digest().ToHex(),
-                     " status: ", ledger::ToString(result.status));
+      item.ExecuteSpeculatively(*executor, slice_state_);
+      tx_speculative_count_->increment();
+    }
+    else
+    {
+      item.Execute(*executor);
     }
 
+    RecordExecution(item);
+
     counters_.ApplyVoid([](auto &counters) {
       --counters.active;
       --counters.remaining;
     });
 
     ++completed_executions_;
-    tx_executed_count_->increment();
 
     {
       FETCH_LOCK(idle_executors_lock_);
@@ -287,6 +347,145 @@ void ExecutionManager::DispatchExecution(ExecutionItem &item)
   }
 }
 
+/**
+ * Apply the changes from a speculatively executed slice in the order given by the execution plan.
+ *
+ * All the items in the slice were executed against the state at the start of the slice. If an item
+ * read any resource that was modified by an earlier item in the slice it is executed again, now
+ * against the updated state, before its changes are applied. The resulting state is therefore
+ * identical to executing the items one after another.
+ *
+ * The changes are collected in the slice overlay, which serves them to the re-executed items, and
+ * are written to the storage engine in a single batch at the end of the slice.
+ *
+ * @param items The items of the slice
+ * @return true if successful, otherwise false
+ */
+bool ExecutionManager::CommitSpeculativeExecution(ExecutionItemList &items)
+{
+  ResourceSet modified{};
+  ExecutorPtr executor{};
+  bool        success{true};
+
+  for (auto &item : items)
+  {
+    assert(item);
+
+    if (item->ConflictsWith(modified))
+    {
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Re-executing conflicting tx: 0x", item->digest().ToHex());
+
+      if (!executor)
+      {
+        executor = AcquireIdleExecutor();
+
+        if (!executor)
+        {
+          FETCH_LOG_WARN(LOGGING_NAME, "Unable to locate free executor to re-execute tx");
+          success = false;
+          break;
+        }
+      }
+
+      // the result of the first execution is replaced, the slice accounting uses the new one
+      item->ExecuteSpeculatively(*executor, slice_state_);
+      RecordExecution(*item);
+      tx_conflicts_count_->increment();
+    }
+
+    item->ApplyChanges(modified);
+  }
+
+  if (executor)
+  {
+    ReleaseExecutor(std::move(executor));
+  }
+
+  if (success)
+  {
+    // write the changes that have been applied, at most one request per lane
+    slice_state_.Flush();
+  }
+  else
+  {
+    // never write a partially applied slice
+    slice_state_.Clear();
+  }
+
+  return success;
+}
+
+/**
+ * Record the outcome of an execution of an item
+ *
+ * @param item The item which has just been executed
+ */
+void ExecutionManager::RecordExecution(ExecutionItem const &item)
+{
+  auto const &result{item.result()};
+
+  // determine what the status is
+  if (ExecutorInterface::Status::SUCCESS != result.status)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Error executing tx: 0x", item.digest().ToHex(),
+                   " status: ", ledger::ToString(result.status));
+  }
+
+  tx_executed_count_->increment();
+}
+
+/**
+ * Take an executor from the idle pool, waiting a short period if required
+ *
+ * @return The executor if successful, otherwise an empty pointer
+ */
+ExecutionManager::ExecutorPtr ExecutionManager::AcquireIdleExecutor()
+{
+  moment::DeadlineTimer executor_deadline("ExecMgr");
+  executor_deadline.Restart(1000u);
+
+  // In rare cases due to scheduling, no executors might have been returned to the idle queue.
+  while (!executor_deadline.HasExpired())
+  {
+    {
+      FETCH_LOCK(idle_executors_lock_);
+      if (!idle_executors_.empty())
+      {
+        ExecutorPtr executor = idle_executors_.back();
+        idle_executors_.pop_back();
+        return executor;
+      }
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{2});
+  }
+
+  return {};
+}
+
+/**
+ * Return an executor to the idle pool
+ *
+ * @param executor The executor to be returned
+ */
+void ExecutionManager::ReleaseExecutor(ExecutorPtr executor)
+{
+  FETCH_LOCK(idle_executors_lock_);
+  idle_executors_.push_back(std::move(executor));
+}
+
+/**
+ * Enable or disable the optimistic execution of slices. When enabled the transactions in a slice
+ * are allowed to access the same resources, any conflicts are resolved when the slice is committed.
+ * The change takes effect from the next block to be executed.
+ *
+ * @param enabled The flag to signal optimistic execution
+ */
+void ExecutionManager::SetOptimisticExecution(bool enabled)
+{
+  optimistic_ = enabled;
+}
+
 /**
  * Starts the execution manager running
  */
@@ -359,6 +558,9 @@ ExecutionManager::State ExecutionManager::GetState()
 
 bool ExecutionManager::Abort()
 {
+  // discard any changes buffered for the slice being executed
+  slice_state_.Clear();
+
   // TODO(private issue 533): Implement user execution abort
   return false;
 }
@@ -383,6 +585,7 @@ void ExecutionManager::MonitorThreadEntrypoint()
 
   std::size_t current_slice        = 0;
   uint64_t    aggregate_block_fees = 0;
+  bool        speculative          = false;
 
   Digest current_block;
 
@@ -395,6 +598,9 @@ void ExecutionManager::MonitorThreadEntrypoint()
     case MonitorState::FAILED:
       FETCH_LOG_WARN(LOGGING_NAME, "Execution Engine experience fatal error");
 
+      // the changes buffered for the failed slice must not reach the next block
+      slice_state_.Clear();
+
       state_.ApplyVoid([](auto &state) { state = State::EXECUTION_FAILED; });
       monitor_state = MonitorState::IDLE;
       break;
@@ -438,6 +644,10 @@ void ExecutionManager::MonitorThreadEntrypoint()
         monitor_state        = MonitorState::SCHEDULE_NEXT_SLICE;
         current_slice        = 0;
         aggregate_block_fees = 0;
+        speculative          = optimistic_;
+
+        // start the block from the state in the storage engine
+        slice_state_.Clear();
       }
 
       break;
@@ -449,6 +659,9 @@ void ExecutionManager::MonitorThreadEntrypoint()
 
       slices_executed_count_->increment();
 
+      // each slice starts from the state in the storage engine
+      slice_state_.Clear();
+
       if (execution_plan_.empty())
       {
         monitor_state = MonitorState::SETTLE_FEES;
@@ -467,9 +680,9 @@ void ExecutionManager::MonitorThreadEntrypoint()
         for (auto &item : slice_plan)
         {
           // create the closure and dispatch to the thread pool
-          thread_pool_->Post([self, &item]() {
+          thread_pool_->Post([self, &item, speculative]() {
             telemetry::FunctionTimer const timer{*(self->execution_duration_)};
-            self->DispatchExecution(*item);
+            self->DispatchExecution(*item, speculative);
           });
         }
 
@@ -492,6 +705,10 @@ void ExecutionManager::MonitorThreadEntrypoint()
           FETCH_LOG_WARN(LOGGING_NAME, "### Extra long execution: remaining: ", counters.remaining);
         });
       }
+      else if (speculative && !CommitSpeculativeExecution(execution_plan_[current_slice]))
+      {
+        monitor_state = MonitorState::FAILED;
+      }
       else
       {
         // evaluate the status of the executions
@@ -23,6 +23,7 @@
 #include "core/mutex.hpp"
 #include "ledger/chain/transaction.hpp"
 #include "ledger/chaincode/contract.hpp"
+#include "ledger/chaincode/smart_contract_manager.hpp"
 #include "ledger/chaincode/token_contract.hpp"
 #include "ledger/consensus/stake_update_interface.hpp"
 #include "ledger/executor.hpp"
@@ -90,6 +91,63 @@ bool IsCreateWealth(Transaction const &tx)
          (tx.chain_code() == "fetch.token") && (tx.action() == "wealth");
 }
 
+void ApplyStakeUpdates(StakeUpdateInterface *stake_updates,
+                       TokenContract::StakeUpdates const &updates)
+{
+  if (stake_updates == nullptr)
+  {
+    return;
+  }
+
+  for (auto const &update : updates)
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Applying stake update from block: ", update.from,
+                   " for: ", update.identity.identifier().ToBase64(), " amount: ", update.amount);
+
+    stake_updates->AddStakeUpdate(update.from, update.identity, update.amount);
+  }
+}
+
+/**
+ * The changes generated by a speculatively executed transaction, held in its storage cache
+ */
+class CachedChanges : public PendingChanges
+{
+public:
+  using CachedStorageAdapterPtr = std::shared_ptr<CachedStorageAdapter>;
+  using StakeUpdates            = TokenContract::StakeUpdates;
+
+  CachedChanges(CachedStorageAdapterPtr cache, StakeUpdateInterface *stake_updates,
+                StakeUpdates updates)
+    : cache_{std::move(cache)}
+    , stake_updates_{stake_updates}
+    , updates_{std::move(updates)}
+  {}
+
+  ~CachedChanges() override = default;
+
+  ResourceSet const &read_set() const override
+  {
+    return cache_->read_set();
+  }
+
+  ResourceSet const &write_set() const override
+  {
+    return cache_->write_set();
+  }
+
+  void Apply() override
+  {
+    cache_->Flush();
+    ApplyStakeUpdates(stake_updates_, updates_);
+  }
+
+private:
+  CachedStorageAdapterPtr cache_;
+  StakeUpdateInterface *  stake_updates_;
+  StakeUpdates            updates_;
+};
+
 }  // namespace
 
 /**
@@ -131,15 +189,79 @@ Executor::Result Executor::Execute(Digest const &digest, BlockIndex block, Slice
 {
   telemetry::FunctionTimer const timer{*overall_duration_};
 
+  Result const result = ExecuteTransaction(digest, block, slice, shards, *storage_, true);
+
+  if (storage_cache_)
+  {
+    // flush the storage so that all changes are now persistent
+    storage_cache_->Flush();
+    ApplyStakeUpdates(stake_updates_, pending_stake_updates_);
+
+    storage_cache_.reset();
+  }
+
+  return result;
+}
+
+/**
+ * Executes a given transaction without applying any of the changes to the state database. The
+ * changes along with the resources that have been accessed are returned to the caller.
+ *
+ * @param digest The transaction digest to be executed
+ * @param block The current block index
+ * @param slice The current slice index
+ * @param shards The bit vector outlining the shards in use by this transaction
+ * @param state The state to read from, the pending changes are applied to the same state
+ * @param changes The output pending changes, empty if the transaction could not be retrieved
+ * @return The status code for the operation
+ */
+Executor::Result Executor::ExecuteSpeculatively(Digest const &digest, BlockIndex block,
+                                                SliceIndex slice, BitVector const &shards,
+                                                StorageInterface &state, PendingChangesPtr &changes)
+{
+  telemetry::FunctionTimer const timer{*overall_duration_};
+
+  // no changes are written during the execution so the shards do not need to be locked
+  Result const result = ExecuteTransaction(digest, block, slice, shards, state, false);
+
+  changes.reset();
+  if (storage_cache_)
+  {
+    changes = std::make_unique<CachedChanges>(std::move(storage_cache_), stake_updates_,
+                                              std::move(pending_stake_updates_));
+  }
+
+  return result;
+}
+
+/**
+ * Executes a given transaction leaving the changes in the storage cache
+ *
+ * @param digest The transaction digest to be executed
+ * @param block The current block index
+ * @param slice The current slice index
+ * @param shards The bit vector outlining the shards in use by this transaction
+ * @param state The state the transaction is executed against
+ * @param forward_locks Whether the shards should be locked on the storage engine
+ * @return The status code for the operation
+ */
+Executor::Result Executor::ExecuteTransaction(Digest const &digest, BlockIndex block,
+                                              SliceIndex slice, BitVector const &shards,
+                                              StorageInterface &state, bool forward_locks)
+{
   FETCH_LOG_DEBUG(LOGGING_NAME, "Executing tx ", byte_array::ToBase64(digest));
 
   Result result{Status::INEXPLICABLE_FAILURE};
 
+  storage_cache_.reset();
+  pending_stake_updates_.clear();
+
   // cache the state for the current transaction
   block_          = block;
   slice_          = slice;
   allowed_shards_ = shards;
   log2_num_lanes_ = shards.log2_size();
+  state_          = &state;
 
   // attempt to retrieve the transaction from the storage
   if (!RetrieveTransaction(digest))
@@ -154,7 +276,10 @@ Executor::Result Executor::Execute(Digest const &digest, BlockIndex block, Slice
     result.charge_limit = current_tx_->charge_limit();
 
     // create the storage cache
-    storage_cache_ = std::make_shared<CachedStorageAdapter>(*storage_);
+    storage_cache_ = std::make_shared<CachedStorageAdapter>(state, forward_locks);
+
+    // load the resources that are known to be accessed by this transaction in one go
+    PrefetchResources();
 
     // follow the three step process for executing a transaction
     //
@@ -175,9 +300,6 @@ Executor::Result Executor::Execute(Digest const &digest, BlockIndex block, Slice
 
     // deduct the fees from the originator
     DeductFees(result);
-
-    // flush the storage so that all changes are now persistent
-    storage_cache_->Flush();
   }
 
   return result;
@@ -207,6 +329,25 @@ void Executor::SettleFees(Address const &miner, TokenAmount amount, uint32_t log
   }
 }
 
+void Executor::PrefetchResources()
+{
+  Identifier const token_scope{"fetch.token"};
+
+  StorageInterface::Addresses keys{};
+  keys.reserve(current_tx_->transfers().size() + 1u);
+
+  // the balance of the originator is always required for the validation checks and fees
+  keys.emplace_back(StateAdapter::CreateAddress(token_scope, current_tx_->from().display()));
+
+  // as is the balance of all the transfer recipients
+  for (auto const &transfer : current_tx_->transfers())
+  {
+    keys.emplace_back(StateAdapter::CreateAddress(token_scope, transfer.to.display()));
+  }
+
+  storage_cache_->Prefetch(keys);
+}
+
 bool Executor::RetrieveTransaction(Digest const &digest)
 {
   telemetry::FunctionTimer const timer{*tx_retrieve_duration_};
@@ -233,15 +374,8 @@ bool Executor::ValidationChecks(Result &result)
 {
   telemetry::FunctionTimer const timer{*validation_checks_duration_};
 
-  // SHORT TERM EXEMPTION - While no state file exists (and the wealth endpoint is still present)
-  // this and only this contract is exempt from the pre-validation checks
-  if (IsCreateWealth(*current_tx_))
-  {
-    result.status = Status::SUCCESS;
-    return true;
-  }
-
-  // CHECK: Determine if the transaction is valid for the given block
+  // CHECK: Determine if the transaction is valid for the given block. This applies to every
+  //        transaction, since the transaction index only prevents duplicates while they are valid
   auto const tx_validity = current_tx_->GetValidity(block_);
   if (Transaction::Validity::VALID != tx_validity)
   {
@@ -249,6 +383,14 @@ bool Executor::ValidationChecks(Result &result)
     return false;
   }
 
+  // SHORT TERM EXEMPTION - While no state file exists (and the wealth endpoint is still present)
+  // this and only this contract is exempt from the funds checks
+  if (IsCreateWealth(*current_tx_))
+  {
+    result.status = Status::SUCCESS;
+    return true;
+  }
+
   // attach the token contract to the storage engine
   StateAdapter storage_adapter{*storage_cache_, Identifier{"fetch.token"}};
   token_contract_->Attach(storage_adapter);
@@ -306,9 +448,17 @@ bool Executor::ExecuteTransactionContract(Result &result)
     // lookup or create the instance of the contract as is needed
     auto const is_token_contract = (contract_id.GetParent().full_name() == "fetch.token");
 
+    // the contract instance might be served from the chain code cache, but the execution still
+    // depends on the contract source so it is always recorded as a read of the transaction
+    if (Identifier::Type::SMART_OR_SYNERGETIC_CONTRACT == contract_id.GetParent().type())
+    {
+      storage_cache_->Prefetch(
+          {SmartContractManager::CreateAddressForContract(contract_id.GetParent().qualifier())});
+    }
+
     auto contract = is_token_contract
                         ? token_contract_
-                        : chain_code_cache_.Lookup(contract_id.GetParent(), *storage_);
+                        : chain_code_cache_.Lookup(contract_id.GetParent(), *state_);
     if (!contract)
     {
       FETCH_LOG_WARN(LOGGING_NAME, "Contract lookup failure: ", contract_id.full_name());
@@ -375,16 +525,10 @@ bool Executor::ExecuteTransactionContract(Result &result)
         success       = false;
       }
 
-      if (success && (stake_updates_ != nullptr))
+      // stake updates are only applied along with the rest of the changes
+      if (success)
       {
-        for (auto const &update : token_contract_->stake_updates())
-        {
-          FETCH_LOG_INFO(LOGGING_NAME, "Applying stake update from block: ", update.from,
-                         " for: ", update.identity.identifier().ToBase64(),
-                         " amount: ", update.amount);
-
-          stake_updates_->AddStakeUpdate(update.from, update.identity, update.amount);
-        }
+        pending_stake_updates_ = token_contract_->stake_updates();
       }
 
       token_contract_->ClearStakeUpdates();
@@ -19,6 +19,7 @@
 #include "ledger/storage_unit/cached_storage_adapter.hpp"
 
 #include <cassert>
+#include <unordered_set>
 
 namespace fetch {
 namespace ledger {
@@ -27,9 +28,12 @@ namespace ledger {
  * Construct the Cache Adpater
  *
  * @param storage The reference to the underlying storage engine
+ * @param forward_locks Whether shard lock requests should be made on the storage engine. This is
+ * not required when the changes are not flushed as part of the execution
  */
-CachedStorageAdapter::CachedStorageAdapter(StorageInterface &storage)
+CachedStorageAdapter::CachedStorageAdapter(StorageInterface &storage, bool forward_locks)
   : storage_{storage}
+  , forward_locks_{forward_locks}
 {}
 
 /**
@@ -38,7 +42,9 @@ CachedStorageAdapter::CachedStorageAdapter(StorageInterface &storage)
 CachedStorageAdapter::~CachedStorageAdapter() = default;
 
 /**
- * Trigger a flush of the cached entries to the storage engine
+ * Trigger a flush of the cached entries to the storage engine. Only the resources in the write set
+ * are sent, values which have only been read are unchanged. The values are written with a single
+ * batched request.
  */
 void CachedStorageAdapter::Flush()
 {
@@ -46,34 +52,122 @@ void CachedStorageAdapter::Flush()
 
   if (flush_required_)
   {
+    KeyValues values{};
+    values.reserve(write_set_.size());
+
     for (auto &entry : cache_)
     {
       if (!entry.second.flushed)
       {
-        // set the value on the storage engine
-        storage_.Set(entry.first, entry.second.value);
+        if (write_set_.find(entry.first) != write_set_.end())
+        {
+          values.emplace_back(entry.first, entry.second.value);
+        }
 
         // signal the entry as flushed
         entry.second.flushed = true;
       }
     }
 
+    // set the values on the storage engine
+    if (!values.empty())
+    {
+      storage_.SetMany(values);
+    }
+
     // reset the top level flush flag
     flush_required_ = false;
   }
 }
 
 /**
- * Clear any cached values
+ * Clear any cached values. The resources which have been read are still recorded since they might
+ * have influenced the decision to discard the changes.
  */
 void CachedStorageAdapter::Clear()
 {
   FETCH_LOCK(lock_);
 
   cache_.clear();
+  write_set_.clear();
   flush_required_ = false;
 }
 
+/**
+ * Populate the cache with a series of resources in a single request to the storage engine.
+ *
+ * Only the resources which are not already present in the cache are requested. Prefetched entries
+ * are considered clean i.e. they will not be written back to the storage engine unless they are
+ * subsequently updated. Every requested resource is recorded in the read set, including those
+ * which do not exist.
+ *
+ * @param keys The keys to be loaded into the cache
+ */
+void CachedStorageAdapter::Prefetch(Addresses const &keys)
+{
+  Addresses missing{};
+
+  {
+    FETCH_LOCK(lock_);
+
+    std::unordered_set<ResourceAddress> requested{};
+    for (auto const &key : keys)
+    {
+      if ((cache_.find(key) == cache_.end()) && requested.insert(key).second)
+      {
+        missing.emplace_back(key);
+      }
+    }
+  }
+
+  if (missing.empty())
+  {
+    return;
+  }
+
+  // make a single batched request for all the missing resources
+  auto const documents = storage_.GetMany(missing);
+  assert(documents.size() == missing.size());
+
+  FETCH_LOCK(lock_);
+
+  for (std::size_t i = 0; i < missing.size(); ++i)
+  {
+    // failed lookups are left to the normal Get / GetOrCreate paths, however the absence of the
+    // resource has still been observed
+    if (documents[i].failed)
+    {
+      read_set_.insert(missing[i]);
+    }
+    // do not overwrite any value that has been written to the cache in the meantime
+    else if (cache_.emplace(missing[i], CacheEntry{documents[i].document, true}).second)
+    {
+      read_set_.insert(missing[i]);
+    }
+  }
+}
+
+/**
+ * Get the set of resources which have been loaded from the storage engine
+ *
+ * @return The set of resource addresses
+ */
+CachedStorageAdapter::ResourceSet const &CachedStorageAdapter::read_set() const
+{
+  return read_set_;
+}
+
+/**
+ * Get the set of resources whose values in the storage engine will be changed by a flush. Values
+ * that are only read are not included unless the read created the resource.
+ *
+ * @return The set of resource addresses
+ */
+CachedStorageAdapter::ResourceSet const &CachedStorageAdapter::write_set() const
+{
+  return write_set_;
+}
+
 /**
  * Get a resource from the storage engine or cache
  *
@@ -99,6 +193,7 @@ CachedStorageAdapter::Document CachedStorageAdapter::Get(ResourceAddress const &
     {
       // update the result
       AddCacheEntry(key, storage_result.document);
+      RecordRead(key, storage_result);
 
       // update the result
       result = storage_result;
@@ -126,17 +221,19 @@ CachedStorageAdapter::Document CachedStorageAdapter::GetOrCreate(ResourceAddress
   }
   else
   {
-    // not in the cache need to retrieve
-    auto const storage_result = storage_.GetOrCreate(key);
+    // not in the cache need to retrieve, the resource is not created on the storage engine since
+    // the changes of the transaction might never be applied
+    result = storage_.Get(key);
 
-    if (!result.failed)
+    if (result.failed)
     {
-      // update the result
-      AddCacheEntry(key, storage_result.document);
-
-      // update the result
-      result = storage_result;
+      // create the resource in the cache only, it is written to the storage engine on flush
+      result             = Document{};
+      result.was_created = true;
     }
+
+    AddCacheEntry(key, result.document);
+    RecordRead(key, result);
   }
 
   return result;
@@ -152,6 +249,9 @@ void CachedStorageAdapter::Set(ResourceAddress const &key, StateValue const &val
 {
   // set the value directly into the cache
   AddCacheEntry(key, value);
+
+  FETCH_LOCK(lock_);
+  write_set_.insert(key);
 }
 
 /**
@@ -163,7 +263,7 @@ void CachedStorageAdapter::Set(ResourceAddress const &key, StateValue const &val
 bool CachedStorageAdapter::Lock(ShardIndex index)
 {
   // proxy this call directly to the underlying storage engine
-  return storage_.Lock(index);
+  return forward_locks_ ? storage_.Lock(index) : true;
 }
 
 /**
@@ -175,7 +275,7 @@ bool CachedStorageAdapter::Lock(ShardIndex index)
 bool CachedStorageAdapter::Unlock(ShardIndex index)
 {
   // proxy this call directly to the underlying storage engine
-  return storage_.Unlock(index);
+  return forward_locks_ ? storage_.Unlock(index) : true;
 }
 
 /**
@@ -193,6 +293,25 @@ void CachedStorageAdapter::AddCacheEntry(ResourceAddress const &address, StateVa
   flush_required_ = true;
 }
 
+/**
+ * Record that a resource has been loaded from the storage engine
+ *
+ * @param address The address of the resource
+ * @param document The document returned by the storage engine
+ */
+void CachedStorageAdapter::RecordRead(ResourceAddress const &address, Document const &document)
+{
+  FETCH_LOCK(lock_);
+
+  read_set_.insert(address);
+
+  // when the resource did not previously exist the subsequent flush will create it
+  if (document.failed || document.was_created)
+  {
+    write_set_.insert(address);
+  }
+}
+
 /**
  * Get a value being stored in the cache
  *
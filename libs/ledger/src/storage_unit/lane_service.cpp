@@ -116,6 +116,8 @@ LaneService::LaneService(NetworkManager const &nm, ShardConfig config, Mode mode
 
   // State DB
   state_db_ = std::make_shared<StateDb>();
+  state_db_->SetSnapshotPolicy(cfg_.state_snapshot_interval, cfg_.state_snapshot_retention);
+  state_db_->SetCacheSize(cfg_.state_cache_size);
   switch (mode)
   {
   case Mode::CREATE_DATABASE:
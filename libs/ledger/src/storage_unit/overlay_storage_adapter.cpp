@@ -0,0 +1,253 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/storage_unit/overlay_storage_adapter.hpp"
+
+#include <cassert>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Construct the overlay
+ *
+ * @param storage The reference to the underlying storage engine
+ */
+OverlayStorageAdapter::OverlayStorageAdapter(StorageInterface &storage)
+  : storage_{storage}
+{}
+
+/**
+ * Write all the buffered values to the storage engine in a single batched request
+ */
+void OverlayStorageAdapter::Flush()
+{
+  KeyValues values{};
+
+  {
+    FETCH_LOCK(lock_);
+
+    values.reserve(values_.size());
+    for (auto &entry : values_)
+    {
+      values.emplace_back(entry.first, std::move(entry.second));
+    }
+
+    values_.clear();
+  }
+
+  if (!values.empty())
+  {
+    storage_.SetMany(values);
+  }
+}
+
+/**
+ * Discard all the buffered values
+ */
+void OverlayStorageAdapter::Clear()
+{
+  FETCH_LOCK(lock_);
+  values_.clear();
+}
+
+/**
+ * Get the number of resources which are waiting to be flushed
+ *
+ * @return The number of buffered values
+ */
+std::size_t OverlayStorageAdapter::size() const
+{
+  FETCH_LOCK(lock_);
+  return values_.size();
+}
+
+/**
+ * Get a resource from the overlay or the storage engine
+ *
+ * @param key The key to be accessed
+ * @return The document containing the result
+ */
+OverlayStorageAdapter::Document OverlayStorageAdapter::Get(ResourceAddress const &key)
+{
+  Document document;
+  if (!Lookup(key, document))
+  {
+    document = storage_.Get(key);
+  }
+
+  return document;
+}
+
+/**
+ * Get or Create a resource in the overlay or the storage engine
+ *
+ * @param key The key to be accessed
+ * @return The document containing the result
+ */
+OverlayStorageAdapter::Document OverlayStorageAdapter::GetOrCreate(ResourceAddress const &key)
+{
+  Document document;
+  if (!Lookup(key, document))
+  {
+    document = storage_.Get(key);
+
+    if (document.failed)
+    {
+      // like any other change the resource is only created on the storage engine on flush
+      document             = Document{};
+      document.was_created = true;
+
+      FETCH_LOCK(lock_);
+      values_.emplace(key, document.document);
+    }
+  }
+
+  return document;
+}
+
+/**
+ * Set a value in the overlay, it will be written to the storage engine on the next flush
+ *
+ * @param key The key of the value
+ * @param value The value being set
+ */
+void OverlayStorageAdapter::Set(ResourceAddress const &key, StateValue const &value)
+{
+  FETCH_LOCK(lock_);
+  values_[key] = value;
+}
+
+/**
+ * Lock a resource on the storage engine
+ *
+ * @param index The shard index to be locked
+ * @return true if successful, otherwise false
+ */
+bool OverlayStorageAdapter::Lock(ShardIndex index)
+{
+  return storage_.Lock(index);
+}
+
+/**
+ * Unlock a resource on the storage engine
+ *
+ * @param index The shard index to be unlocked
+ * @return true if successful, otherwise false
+ */
+bool OverlayStorageAdapter::Unlock(ShardIndex index)
+{
+  return storage_.Unlock(index);
+}
+
+/**
+ * Return all valid keys of the storage engine. Buffered values are not included.
+ */
+OverlayStorageAdapter::Keys OverlayStorageAdapter::KeyDump() const
+{
+  return storage_.KeyDump();
+}
+
+/**
+ * Reset the database, discarding any buffered values
+ */
+void OverlayStorageAdapter::Reset()
+{
+  Clear();
+  storage_.Reset();
+}
+
+/**
+ * Get a series of resources. The resources which are not present in the overlay are requested from
+ * the storage engine in a single batch.
+ *
+ * @param keys The keys to be accessed
+ * @return The documents in the same order as the keys
+ */
+OverlayStorageAdapter::Documents OverlayStorageAdapter::GetMany(Addresses const &keys)
+{
+  Documents   documents(keys.size());
+  Addresses   missing{};
+  std::size_t num_missing{0};
+
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    if (!Lookup(keys[i], documents[i]))
+    {
+      missing.emplace_back(keys[i]);
+      documents[i].failed = true;
+    }
+  }
+
+  if (!missing.empty())
+  {
+    auto const loaded = storage_.GetMany(missing);
+    assert(loaded.size() == missing.size());
+
+    // fill in the gaps in the original order
+    for (auto &document : documents)
+    {
+      if (document.failed)
+      {
+        document = loaded[num_missing++];
+      }
+    }
+  }
+
+  return documents;
+}
+
+/**
+ * Set a series of values in the overlay
+ *
+ * @param values The key value pairs to be written
+ */
+void OverlayStorageAdapter::SetMany(KeyValues const &values)
+{
+  FETCH_LOCK(lock_);
+
+  for (auto const &entry : values)
+  {
+    values_[entry.first] = entry.second;
+  }
+}
+
+/**
+ * Lookup a buffered value
+ *
+ * @param key The key to be accessed
+ * @param document The output document, populated when the value is present
+ * @return true if the value is buffered in the overlay, otherwise false
+ */
+bool OverlayStorageAdapter::Lookup(ResourceAddress const &key, Document &document) const
+{
+  FETCH_LOCK(lock_);
+
+  auto const it = values_.find(key);
+  if (it == values_.end())
+  {
+    return false;
+  }
+
+  document.document = it->second;
+  return true;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -28,6 +28,7 @@
 #include <map>
 #include <memory>
 #include <stdexcept>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
@@ -55,6 +56,19 @@ AddressList GenerateAddressList(ShardConfigs const &shards)
   return addresses;
 }
 
+/**
+ * The set of resources being requested from a single lane as part of a batched operation
+ */
+struct LaneGetRequest
+{
+  RevertibleDocumentStoreProtocol::ResourceIDs resources{};
+  std::vector<std::size_t>                     positions{};  ///< Position in the original request
+  Promise                                      promise{};
+};
+
+using LaneGetRequests = std::unordered_map<uint32_t, LaneGetRequest>;
+using LaneSetRequests = std::unordered_map<uint32_t, RevertibleDocumentStoreProtocol::KeyValues>;
+
 constexpr char const *MERKLE_FILENAME_DOC   = "merkle_stack.db";
 constexpr char const *MERKLE_FILENAME_INDEX = "merkle_stack_index.db";
 
@@ -514,6 +528,134 @@ StorageUnitClient::Document StorageUnitClient::Get(ResourceAddress const &key)
   return doc;
 }
 
+/**
+ * Retrieve a series of documents from the lanes.
+ *
+ * The keys are grouped by the lane that owns them and a single request is made to each of the
+ * lanes involved. All the requests are dispatched before any of the responses are waited on so
+ * that the lanes service them in parallel.
+ *
+ * @param keys The keys to be looked up
+ * @return The documents, in the same order as the requested keys
+ */
+StorageUnitClient::Documents StorageUnitClient::GetMany(Addresses const &keys)
+{
+  Documents docs(keys.size());
+
+  // group all the resources by the lane that owns them
+  LaneGetRequests requests{};
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    auto &request = requests[keys[i].lane(log2_num_lanes_)];
+    request.resources.emplace_back(keys[i].as_resource_id());
+    request.positions.emplace_back(i);
+  }
+
+  // make one request to each of the lanes
+  for (auto &request : requests)
+  {
+    try
+    {
+      request.second.promise = rpc_client_->CallSpecificAddress(
+          LookupAddress(request.first), RPC_STATE, RevertibleDocumentStoreProtocol::GET_MANY,
+          request.second.resources);
+    }
+    catch (std::runtime_error const &e)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to request documents from lane ", request.first,
+                     ", because: ", e.what());
+    }
+  }
+
+  // collect the responses and scatter them back into request order
+  for (auto const &request : requests)
+  {
+    auto const &positions = request.second.positions;
+
+    bool success{false};
+    try
+    {
+      if (request.second.promise)
+      {
+        auto lane_docs = request.second.promise->As<Documents>();
+
+        if (lane_docs.size() == positions.size())
+        {
+          for (std::size_t i = 0; i < positions.size(); ++i)
+          {
+            docs[positions[i]] = std::move(lane_docs[i]);
+          }
+
+          success = true;
+        }
+        else
+        {
+          FETCH_LOG_WARN(LOGGING_NAME, "Lane ", request.first, " returned ", lane_docs.size(),
+                         " documents, expected ", positions.size());
+        }
+      }
+    }
+    catch (std::runtime_error const &e)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to get documents, because: ", e.what());
+    }
+
+    // signal the failure for all the documents requested from this lane
+    if (!success)
+    {
+      for (auto const position : positions)
+      {
+        docs[position].failed = true;
+      }
+    }
+  }
+
+  return docs;
+}
+
+/**
+ * Set a series of values on the lanes.
+ *
+ * The values are grouped by the lane that owns them and a single request is made to each of the
+ * lanes involved. The ordering of the values inside each lane is preserved.
+ *
+ * @param values The key value pairs to be written
+ */
+void StorageUnitClient::SetMany(KeyValues const &values)
+{
+  // group all the values by the lane that owns them
+  LaneSetRequests requests{};
+  for (auto const &entry : values)
+  {
+    requests[entry.first.lane(log2_num_lanes_)].emplace_back(entry.first.as_resource_id(),
+                                                             entry.second);
+  }
+
+  std::vector<service::Promise> promises;
+  promises.reserve(requests.size());
+
+  try
+  {
+    // make one request to each of the lanes
+    for (auto const &request : requests)
+    {
+      promises.emplace_back(rpc_client_->CallSpecificAddress(
+          LookupAddress(request.first), RPC_STATE, RevertibleDocumentStoreProtocol::SET_MANY,
+          request.second));
+    }
+
+    // wait for all the responses
+    for (auto &p : promises)
+    {
+      p->Wait();
+    }
+  }
+  catch (std::runtime_error const &e)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to call SET_MANY (store documents), because: ", e.what());
+  }
+}
+
 void StorageUnitClient::Set(ResourceAddress const &key, StateValue const &value)
 {
   try
@@ -0,0 +1,62 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/storage_unit/storage_unit_interface.hpp"
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Retrieve a series of documents from the storage engine.
+ *
+ * The default implementation simply makes one Get call per key. Storage engines which are able to
+ * service multiple keys more efficiently (for example remote ones) are expected to override it.
+ *
+ * @param keys The keys to be looked up
+ * @return The documents, in the same order as the requested keys
+ */
+StorageInterface::Documents StorageInterface::GetMany(Addresses const &keys)
+{
+  Documents documents{};
+  documents.reserve(keys.size());
+
+  for (auto const &key : keys)
+  {
+    documents.emplace_back(Get(key));
+  }
+
+  return documents;
+}
+
+/**
+ * Set a series of values on the storage engine.
+ *
+ * The default implementation simply makes one Set call per entry, in order.
+ *
+ * @param values The key value pairs to be written
+ */
+void StorageInterface::SetMany(KeyValues const &values)
+{
+  for (auto const &entry : values)
+  {
+    Set(entry.first, entry.second);
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -25,6 +25,7 @@
 #include "network/generics/milli_timer.hpp"
 #include "telemetry/counter.hpp"
 #include "telemetry/gauge.hpp"
+#include "telemetry/histogram.hpp"
 #include "telemetry/registry.hpp"
 
 #include <algorithm>
@@ -32,6 +33,7 @@
 #include <string>
 
 static const std::chrono::milliseconds POP_TIMEOUT{300};
+static const std::chrono::milliseconds DRAIN_TIMEOUT{0};
 
 namespace fetch {
 namespace ledger {
@@ -72,6 +74,14 @@ telemetry::CounterPtr CreateCounter(std::string const &prefix, std::string const
   return Registry::Instance().CreateCounter(std::move(metric_name), description);
 }
 
+telemetry::HistogramPtr CreateHistogram(std::initializer_list<double> const &buckets,
+                                        std::string const &prefix, std::string const &name,
+                                        std::string const &description)
+{
+  std::string metric_name = CreateMetricName(prefix, name);
+  return Registry::Instance().CreateHistogram(buckets, std::move(metric_name), description);
+}
+
 }  // namespace
 
 /**
@@ -80,10 +90,12 @@ telemetry::CounterPtr CreateCounter(std::string const &prefix, std::string const
  * @param sink The destination for verified transactions
  * @param verifying_threads The number of verifying threads to be used
  * @param name The name of the verifier
+ * @param batch_size The maximum number of transactions verified per wake up of a verifying thread
  */
 TransactionVerifier::TransactionVerifier(TransactionSink &sink, std::size_t verifying_threads,
-                                         std::string const &name)
+                                         std::string const &name, std::size_t batch_size)
   : verifying_threads_(verifying_threads)
+  , batch_size_(std::max(batch_size, std::size_t{1}))
   , name_(name)
   , sink_(sink)
   , unverified_queue_length_(
@@ -103,6 +115,8 @@ TransactionVerifier::TransactionVerifier(TransactionSink &sink, std::size_t veri
   , dispatched_tx_total_(CreateCounter(name, "dispatched_transactions_total",
                                        "The total number of verified that have been dispatched"))
   , num_threads_(CreateGauge(name, "threads", "The current number of processing threads in use"))
+  , batch_sizes_(CreateHistogram({1, 2, 4, 8, 16, 32, 64, 128, 256, 512}, name, "batch_size",
+                                 "The number of transactions verified in each batch"))
 {
   // since these lengths are fixed
   unverified_queue_max_length_->increment(std::size_t{QUEUE_SIZE});
@@ -179,46 +193,89 @@ void TransactionVerifier::AddTransaction(TransactionPtr &&tx)
 }
 
 /**
- * Internal: Thread process for the verification of
+ * Internal: Thread process for the verification of transactions. On each wake up the thread drains
+ * up to a batch of transactions from the queue and verifies them together.
  */
 void TransactionVerifier::Verifier()
 {
-  TransactionPtr tx;
+  TransactionList batch{};
+  batch.reserve(batch_size_);
 
   while (active_)
   {
     try
     {
+      TransactionPtr tx;
+
       // wait for a mutable transaction to be available
       if (unverified_queue_.Pop(tx, POP_TIMEOUT))
       {
-        unverified_queue_length_->decrement();
-
-        FETCH_LOG_DEBUG(LOGGING_NAME, "Verifying TX: 0x", tx->digest().ToHex());
+        batch.emplace_back(std::move(tx));
 
-        // check the status
-        if (tx->Verify())
+        // collect any further transactions that are already waiting
+        while ((batch.size() < batch_size_) && unverified_queue_.Pop(tx, DRAIN_TIMEOUT))
         {
-          FETCH_LOG_DEBUG(LOGGING_NAME, "TX Verify Complete: 0x", tx->digest().ToHex());
-
-          verified_queue_.Push(std::move(tx));
-          verified_queue_length_->increment();
-          verified_tx_total_->increment();
+          batch.emplace_back(std::move(tx));
         }
-        else
-        {
-          FETCH_LOG_WARN(LOGGING_NAME, name_ + " Unable to verify transaction: 0x",
-                         tx->digest().ToHex());
 
-          discarded_tx_total_->increment();
-        }
+        unverified_queue_length_->decrement(batch.size());
+
+        VerifyBatch(batch);
       }
     }
     catch (std::exception const &e)
     {
       FETCH_LOG_WARN(LOGGING_NAME, name_ + " Exception caught: ", e.what());
     }
+
+    batch.clear();
+  }
+}
+
+/**
+ * Internal: Verify a batch of transactions, forwarding the valid ones to the dispatcher. Each
+ * transaction is checked in isolation so that a bad signature (or a failure while checking it)
+ * only results in the offending transaction being discarded. The transaction totals are updated
+ * once for the whole batch.
+ *
+ * @param batch The transactions to be verified
+ */
+void TransactionVerifier::VerifyBatch(TransactionList &batch)
+{
+  batch_sizes_->Add(static_cast<double>(batch.size()));
+
+  std::size_t num_verified{0};
+  for (auto &tx : batch)
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Verifying TX: 0x", tx->digest().ToHex());
+
+    bool valid{false};
+    try
+    {
+      valid = tx->Verify();
+    }
+    catch (std::exception const &e)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, name_ + " Exception caught: ", e.what());
+    }
+
+    if (valid)
+    {
+      FETCH_LOG_DEBUG(LOGGING_NAME, "TX Verify Complete: 0x", tx->digest().ToHex());
+
+      verified_queue_.Push(std::move(tx));
+      verified_queue_length_->increment();
+      ++num_verified;
+    }
+    else
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, name_ + " Unable to verify transaction: 0x",
+                     tx->digest().ToHex());
+    }
   }
+
+  verified_tx_total_->add(num_verified);
+  discarded_tx_total_->add(batch.size() - num_verified);
 }
 
 /**
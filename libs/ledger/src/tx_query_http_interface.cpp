@@ -43,6 +43,9 @@ namespace ledger {
 TxQueryHttpInterface::TxQueryHttpInterface(StorageUnitInterface &storage_unit)
   : storage_unit_{storage_unit}
 {
+  // the views of this module are read only and can be served concurrently
+  SetThreadSafe(true);
+
   Get("/api/tx/(digest=[a-fA-F0-9]{64})/", "Retrieves a transaction.",
       {
           {"digest", "The transaction hash.", http::validators::StringValue()},
@@ -116,6 +116,9 @@ TxStatusHttpInterface::TxStatusHttpInterface(TxStatusCachePtr status_cache)
 {
   assert(status_cache_);
 
+  // the views of this module are read only and can be served concurrently
+  SetThreadSafe(true);
+
   Get("/api/status/tx/(digest=[a-fA-F0-9]{64})", "Retrieves a transaction status.",
       {
           {"digest", "The transaction hash.", http::validators::StringValue()},
@@ -40,6 +40,7 @@
 #include <cstdint>
 #include <memory>
 #include <ostream>
+#include <thread>
 
 namespace {
 
@@ -1037,4 +1038,55 @@ TEST_F(NiceMockBlockCoordinatorTests, UnknownTransactionDoesNotBlockForever)
   Tock(State::WAIT_FOR_TRANSACTIONS, State::SYNCHRONISED);
 }
 
+TEST_F(NiceMockBlockCoordinatorTests, PipelinedCommitOverlapsWithNextBlock)
+{
+  using ::testing::Invoke;
+
+  block_coordinator_->EnablePipelining();
+
+  // slow down the commits so that the overlap with the next block can be observed
+  ON_CALL(*storage_unit_, Commit(_)).WillByDefault(Invoke([this](uint64_t index) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    return storage_unit_->fake.Commit(index);
+  }));
+
+  auto genesis = block_generator_();
+  auto b1      = block_generator_(genesis);
+  auto b2      = block_generator_(b1);
+  auto b3      = block_generator_(b2);
+  auto b4      = block_generator_(b3);
+
+  for (auto const &block : {b1, b2, b3, b4})
+  {
+    ASSERT_EQ(BlockStatus::ADDED, main_chain_->AddBlock(*block));
+  }
+
+  auto const &state_machine = block_coordinator_->GetStateMachine();
+
+  bool overlapped{false};
+  for (std::size_t i = 0; i < 2000; ++i)
+  {
+    block_coordinator_->GetRunnable().Execute();
+
+    auto const state                  = state_machine.state();
+    bool const next_block_in_progress = (State::PRE_EXEC_BLOCK_VALIDATION == state) ||
+                                        (State::WAIT_FOR_TRANSACTIONS == state) ||
+                                        (State::SYNERGETIC_EXECUTION == state);
+
+    overlapped |= next_block_in_progress && block_coordinator_->IsCommitInProgress();
+
+    if ((State::SYNCHRONISED == state) && !block_coordinator_->IsCommitInProgress())
+    {
+      break;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+
+  EXPECT_TRUE(overlapped);
+  EXPECT_EQ(State::SYNCHRONISED, state_machine.state());
+  EXPECT_EQ(b4->body.hash, block_coordinator_->GetLastExecutedBlock());
+  EXPECT_EQ(b4->body.merkle_hash, storage_unit_->fake.LastCommitHash());
+}
+
 }  // namespace
@@ -0,0 +1,206 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/storage_unit/cached_storage_adapter.hpp"
+#include "mock_storage_unit.hpp"
+#include "recording_storage.hpp"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <unordered_set>
+
+using fetch::ledger::CachedStorageAdapter;
+using fetch::storage::ResourceAddress;
+using ::testing::_;
+using ::testing::StrictMock;
+
+using MockStorageUnitPtr = std::unique_ptr<StrictMock<MockStorageUnit>>;
+using CachePtr           = std::unique_ptr<CachedStorageAdapter>;
+
+class CachedStorageAdapterTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    storage_ = std::make_unique<StrictMock<MockStorageUnit>>();
+    cache_   = std::make_unique<CachedStorageAdapter>(*storage_);
+
+    storage_->fake.Set(ResourceAddress{"key 1"}, "value 1");
+    storage_->fake.Set(ResourceAddress{"key 2"}, "value 2");
+  }
+
+  void TearDown() override
+  {
+    cache_.reset();
+    storage_.reset();
+  }
+
+  MockStorageUnitPtr storage_;
+  CachePtr           cache_;
+};
+
+TEST_F(CachedStorageAdapterTests, PrefetchedValuesAreServedFromTheCache)
+{
+  EXPECT_CALL(*storage_, Get(_)).Times(2);
+
+  cache_->Prefetch({ResourceAddress{"key 1"}, ResourceAddress{"key 2"}, ResourceAddress{"key 1"}});
+
+  // subsequent lookups should not hit the storage engine
+  EXPECT_EQ(cache_->Get(ResourceAddress{"key 1"}).document, "value 1");
+  EXPECT_EQ(cache_->Get(ResourceAddress{"key 2"}).document, "value 2");
+
+  // prefetched values are clean and should not be written back
+  EXPECT_CALL(*storage_, Set(_, _)).Times(0);
+  cache_->Flush();
+}
+
+TEST_F(CachedStorageAdapterTests, PrefetchDoesNotOverwriteCachedValues)
+{
+  cache_->Set(ResourceAddress{"key 1"}, "updated");
+
+  // only the key not present in the cache should be requested
+  EXPECT_CALL(*storage_, Get(ResourceAddress{"key 2"})).Times(1);
+  cache_->Prefetch({ResourceAddress{"key 1"}, ResourceAddress{"key 2"}});
+
+  EXPECT_EQ(cache_->Get(ResourceAddress{"key 1"}).document, "updated");
+
+  // only the updated value should be flushed
+  EXPECT_CALL(*storage_, Set(ResourceAddress{"key 1"}, _)).Times(1);
+  cache_->Flush();
+
+  EXPECT_EQ(storage_->fake.Get(ResourceAddress{"key 1"}).document, "updated");
+}
+
+TEST_F(CachedStorageAdapterTests, FailedPrefetchIsNotCached)
+{
+  EXPECT_CALL(*storage_, Get(ResourceAddress{"missing"})).Times(2);
+
+  cache_->Prefetch({ResourceAddress{"missing"}});
+
+  // the failed lookup should be retried through the normal path
+  cache_->Get(ResourceAddress{"missing"});
+}
+
+TEST_F(CachedStorageAdapterTests, AccessedResourcesAreTracked)
+{
+  EXPECT_CALL(*storage_, Get(_)).Times(3);
+  EXPECT_CALL(*storage_, GetOrCreate(_)).Times(0);
+
+  cache_->Prefetch({ResourceAddress{"key 1"}});
+  cache_->Get(ResourceAddress{"key 2"});
+  cache_->GetOrCreate(ResourceAddress{"created"});
+  cache_->Set(ResourceAddress{"written"}, "value");
+
+  CachedStorageAdapter::ResourceSet const expected_reads{
+      ResourceAddress{"key 1"}, ResourceAddress{"key 2"}, ResourceAddress{"created"}};
+  CachedStorageAdapter::ResourceSet const expected_writes{ResourceAddress{"created"},
+                                                          ResourceAddress{"written"}};
+
+  EXPECT_EQ(cache_->read_set(), expected_reads);
+  EXPECT_EQ(cache_->write_set(), expected_writes);
+
+  // discarding the changes must keep the record of what was read
+  cache_->Clear();
+
+  EXPECT_EQ(cache_->read_set(), expected_reads);
+  EXPECT_TRUE(cache_->write_set().empty());
+}
+
+TEST_F(CachedStorageAdapterTests, MissingPrefetchedResourcesAreRecordedAsRead)
+{
+  EXPECT_CALL(*storage_, Get(_)).Times(2);
+
+  cache_->Prefetch({ResourceAddress{"key 1"}, ResourceAddress{"missing"}});
+
+  CachedStorageAdapter::ResourceSet const expected_reads{ResourceAddress{"key 1"},
+                                                         ResourceAddress{"missing"}};
+
+  EXPECT_EQ(cache_->read_set(), expected_reads);
+  EXPECT_TRUE(cache_->write_set().empty());
+}
+
+TEST_F(CachedStorageAdapterTests, ResourcesAreOnlyCreatedOnFlush)
+{
+  EXPECT_CALL(*storage_, Get(_)).Times(2);
+  EXPECT_CALL(*storage_, GetOrCreate(_)).Times(0);
+
+  auto const created = cache_->GetOrCreate(ResourceAddress{"created"});
+  EXPECT_FALSE(created.failed);
+  EXPECT_TRUE(created.was_created);
+  EXPECT_TRUE(cache_->GetOrCreate(ResourceAddress{"created"}).document.empty());
+
+  // nothing has reached the storage engine yet
+  EXPECT_TRUE(storage_->fake.Get(ResourceAddress{"created"}).failed);
+
+  // discarded changes never create the resource
+  cache_->Clear();
+  cache_->Flush();
+  EXPECT_TRUE(storage_->fake.Get(ResourceAddress{"created"}).failed);
+
+  cache_->GetOrCreate(ResourceAddress{"created"});
+
+  EXPECT_CALL(*storage_, Set(ResourceAddress{"created"}, _)).Times(1);
+  cache_->Flush();
+
+  EXPECT_FALSE(storage_->fake.Get(ResourceAddress{"created"}).failed);
+}
+
+TEST_F(CachedStorageAdapterTests, LocksAreNotForwardedWhenDisabled)
+{
+  CachedStorageAdapter cache{*storage_, false};
+
+  EXPECT_CALL(*storage_, Lock(_)).Times(0);
+  EXPECT_CALL(*storage_, Unlock(_)).Times(0);
+
+  EXPECT_TRUE(cache.Lock(0));
+  EXPECT_TRUE(cache.Unlock(0));
+}
+
+TEST(CachedStorageAdapterFlushTests, OnlyTheWriteSetIsFlushedInASingleBatch)
+{
+  RecordingStorage storage;
+  storage.fake.Set(ResourceAddress{"key 1"}, "value 1");
+
+  CachedStorageAdapter cache{storage};
+  cache.Get(ResourceAddress{"key 1"});
+  cache.GetOrCreate(ResourceAddress{"created"});
+  cache.Set(ResourceAddress{"key 2"}, "value 2");
+  cache.Set(ResourceAddress{"key 3"}, "value 3");
+
+  cache.Flush();
+
+  EXPECT_EQ(1, storage.num_set_batches);
+  EXPECT_EQ(0, storage.num_sets);
+
+  // the value which was only read is not written back
+  std::unordered_set<ResourceAddress> flushed{};
+  for (auto const &entry : storage.last_set_batch)
+  {
+    flushed.insert(entry.first);
+  }
+
+  EXPECT_EQ(cache.write_set(), flushed);
+  EXPECT_EQ(storage.fake.Get(ResourceAddress{"key 2"}).document, "value 2");
+  EXPECT_EQ(storage.fake.Get(ResourceAddress{"key 3"}).document, "value 3");
+
+  // there is nothing left to be written
+  cache.Flush();
+  EXPECT_EQ(1, storage.num_set_batches);
+}
@@ -19,8 +19,11 @@
 #include "core/bloom_filter.hpp"
 #include "core/byte_array/byte_array.hpp"
 #include "core/containers/set_difference.hpp"
+#include "core/bitvector.hpp"
 #include "ledger/chain/block.hpp"
+#include "ledger/chain/constants.hpp"
 #include "ledger/chain/main_chain.hpp"
+#include "ledger/chain/transaction_index.hpp"
 #include "ledger/chain/transaction_layout_rpc_serializers.hpp"
 #include "ledger/chain/transaction_rpc_serializers.hpp"
 #include "ledger/testing/block_generator.hpp"
@@ -38,6 +41,7 @@ using namespace fetch;
 
 using fetch::ledger::Block;
 using fetch::ledger::MainChain;
+using fetch::ledger::TransactionIndex;
 using fetch::ledger::BlockStatus;
 using fetch::ledger::testing::BlockGenerator;
 using fetch::ledger::Address;
@@ -869,3 +873,47 @@ TEST_P(MainChainTests, CheckResolvedLooseWeight)
 INSTANTIATE_TEST_CASE_P(ParamBased, MainChainTests,
                         ::testing::Values(MainChain::Mode::CREATE_PERSISTENT_DB,
                                           MainChain::Mode::IN_MEMORY_DB), );
+
+TEST(MainChainPersistenceTests, CheckStaleTransactionIndexIsRebuiltOnLoad)
+{
+  static constexpr std::size_t NUM_BLOCKS = 3 * fetch::ledger::FINALITY_PERIOD;
+
+  BlockGenerator generator{1, 2};
+
+  auto const genesis = generator.Generate();
+
+  // the first block contains a transaction which is still valid at the end of the chain
+  auto block = generator.Generate(genesis);
+  block->body.slices[0].emplace_back(generator.Generate()->body.hash, BitVector{}, 0, 0, 1000);
+  block->UpdateDigest();
+
+  Digest const digest = block->body.slices[0].front().digest();
+
+  {
+    MainChain chain{false, MainChain::Mode::CREATE_PERSISTENT_DB};
+    ASSERT_EQ(BlockStatus::ADDED, chain.AddBlock(*block));
+
+    for (std::size_t i = 1; i < NUM_BLOCKS; ++i)
+    {
+      block = generator.Generate(block);
+      ASSERT_EQ(BlockStatus::ADDED, chain.AddBlock(*block));
+    }
+  }
+
+  // replace the transaction index with one which does not correspond to the stored chain
+  {
+    auto other = generator.Generate(genesis);
+    other->body.slices[0].emplace_back(generator.Generate()->body.hash, BitVector{}, 0, 0, 1000);
+    other->UpdateDigest();
+
+    TransactionIndex index{};
+    index.New("chain.tx_index");
+    index.Add(*other);
+  }
+
+  MainChain chain{false, MainChain::Mode::LOAD_PERSISTENT_DB};
+
+  auto const duplicates = chain.DetectDuplicateTransactions(chain.GetHeaviestBlockHash(), {digest});
+  ASSERT_EQ(1u, duplicates.size());
+  EXPECT_EQ(digest, *duplicates.begin());
+}
@@ -0,0 +1,160 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/storage_unit/cached_storage_adapter.hpp"
+#include "ledger/storage_unit/overlay_storage_adapter.hpp"
+#include "recording_storage.hpp"
+
+#include "gtest/gtest.h"
+
+using fetch::ledger::CachedStorageAdapter;
+using fetch::ledger::OverlayStorageAdapter;
+using fetch::storage::ResourceAddress;
+
+class OverlayStorageAdapterTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    storage_.fake.Set(ResourceAddress{"key 1"}, "value 1");
+    storage_.fake.Set(ResourceAddress{"key 2"}, "value 2");
+  }
+
+  RecordingStorage      storage_;
+  OverlayStorageAdapter overlay_{storage_};
+};
+
+TEST_F(OverlayStorageAdapterTests, WrittenValuesAreVisibleBeforeFlush)
+{
+  overlay_.Set(ResourceAddress{"key 1"}, "updated");
+  overlay_.Set(ResourceAddress{"key 3"}, "value 3");
+
+  EXPECT_EQ(overlay_.Get(ResourceAddress{"key 1"}).document, "updated");
+  EXPECT_EQ(overlay_.GetOrCreate(ResourceAddress{"key 3"}).document, "value 3");
+  EXPECT_EQ(0, storage_.num_gets);
+
+  // nothing has reached the storage engine yet
+  EXPECT_EQ(storage_.fake.Get(ResourceAddress{"key 1"}).document, "value 1");
+  EXPECT_TRUE(storage_.fake.Get(ResourceAddress{"key 3"}).failed);
+  EXPECT_EQ(2, overlay_.size());
+
+  overlay_.Flush();
+
+  EXPECT_EQ(1, storage_.num_set_batches);
+  EXPECT_EQ(0, storage_.num_sets);
+  EXPECT_EQ(0, overlay_.size());
+  EXPECT_EQ(storage_.fake.Get(ResourceAddress{"key 1"}).document, "updated");
+  EXPECT_EQ(storage_.fake.Get(ResourceAddress{"key 3"}).document, "value 3");
+
+  // an empty overlay does not make a request
+  overlay_.Flush();
+  EXPECT_EQ(1, storage_.num_set_batches);
+}
+
+TEST_F(OverlayStorageAdapterTests, OtherLookupsArePassedThrough)
+{
+  EXPECT_EQ(overlay_.Get(ResourceAddress{"key 1"}).document, "value 1");
+  EXPECT_EQ(overlay_.Get(ResourceAddress{"key 1"}).document, "value 1");
+  EXPECT_TRUE(overlay_.Get(ResourceAddress{"missing"}).failed);
+
+  // lookups are not cached
+  EXPECT_EQ(3, storage_.num_gets);
+  EXPECT_EQ(0, overlay_.size());
+
+  auto const created = overlay_.GetOrCreate(ResourceAddress{"created"});
+  EXPECT_TRUE(created.was_created);
+  EXPECT_FALSE(overlay_.GetOrCreate(ResourceAddress{"created"}).was_created);
+}
+
+TEST_F(OverlayStorageAdapterTests, ResourcesAreOnlyCreatedOnFlush)
+{
+  EXPECT_TRUE(overlay_.GetOrCreate(ResourceAddress{"created"}).was_created);
+  EXPECT_EQ(1, overlay_.size());
+
+  // nothing has reached the storage engine yet
+  EXPECT_TRUE(storage_.fake.Get(ResourceAddress{"created"}).failed);
+
+  overlay_.Flush();
+
+  EXPECT_EQ(1, storage_.num_set_batches);
+  EXPECT_FALSE(storage_.fake.Get(ResourceAddress{"created"}).failed);
+}
+
+TEST_F(OverlayStorageAdapterTests, BatchedLookupsOnlyRequestMissingValues)
+{
+  overlay_.Set(ResourceAddress{"key 2"}, "updated");
+
+  auto const documents = overlay_.GetMany(
+      {ResourceAddress{"key 1"}, ResourceAddress{"key 2"}, ResourceAddress{"missing"}});
+
+  ASSERT_EQ(3, documents.size());
+  EXPECT_EQ(documents[0].document, "value 1");
+  EXPECT_EQ(documents[1].document, "updated");
+  EXPECT_FALSE(documents[1].failed);
+  EXPECT_TRUE(documents[2].failed);
+  EXPECT_EQ(1, storage_.num_get_batches);
+
+  // no request is made when all the values are present
+  overlay_.GetMany({ResourceAddress{"key 2"}});
+  EXPECT_EQ(1, storage_.num_get_batches);
+}
+
+TEST_F(OverlayStorageAdapterTests, TransactionChangesAreMergedIntoASingleFlush)
+{
+  {
+    CachedStorageAdapter cache{overlay_, false};
+    cache.Set(ResourceAddress{"key 1"}, "first");
+    cache.Set(ResourceAddress{"key 3"}, "first");
+    cache.Flush();
+  }
+
+  {
+    // the later transaction sees the changes of the earlier one
+    CachedStorageAdapter cache{overlay_, false};
+    EXPECT_EQ(cache.Get(ResourceAddress{"key 1"}).document, "first");
+    EXPECT_EQ(cache.Get(ResourceAddress{"key 2"}).document, "value 2");
+
+    cache.Set(ResourceAddress{"key 3"}, "second");
+    cache.Flush();
+  }
+
+  EXPECT_EQ(0, storage_.num_set_batches);
+  EXPECT_EQ(2, overlay_.size());
+
+  overlay_.Flush();
+
+  EXPECT_EQ(1, storage_.num_set_batches);
+  EXPECT_EQ(0, storage_.num_sets);
+  EXPECT_EQ(2, storage_.last_set_batch.size());
+  EXPECT_EQ(storage_.fake.Get(ResourceAddress{"key 1"}).document, "first");
+  EXPECT_EQ(storage_.fake.Get(ResourceAddress{"key 2"}).document, "value 2");
+  EXPECT_EQ(storage_.fake.Get(ResourceAddress{"key 3"}).document, "second");
+}
+
+TEST_F(OverlayStorageAdapterTests, ClearedValuesAreNeverWritten)
+{
+  overlay_.Set(ResourceAddress{"key 1"}, "discarded");
+  overlay_.Clear();
+
+  EXPECT_EQ(overlay_.Get(ResourceAddress{"key 1"}).document, "value 1");
+
+  overlay_.Flush();
+
+  EXPECT_EQ(0, storage_.num_set_batches);
+  EXPECT_EQ(storage_.fake.Get(ResourceAddress{"key 1"}).document, "value 1");
+}
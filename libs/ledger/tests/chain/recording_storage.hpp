@@ -0,0 +1,91 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "fake_storage_unit.hpp"
+
+#include "ledger/storage_unit/storage_unit_interface.hpp"
+
+#include <cstddef>
+
+/**
+ * State storage backed by the fake storage unit which records the number of requests made to it,
+ * with the batched requests counted separately from the single resource requests.
+ */
+class RecordingStorage : public fetch::ledger::StorageInterface
+{
+public:
+  Document Get(ResourceAddress const &key) override
+  {
+    ++num_gets;
+    return fake.Get(key);
+  }
+
+  Document GetOrCreate(ResourceAddress const &key) override
+  {
+    ++num_gets;
+    return fake.GetOrCreate(key);
+  }
+
+  void Set(ResourceAddress const &key, StateValue const &value) override
+  {
+    ++num_sets;
+    fake.Set(key, value);
+  }
+
+  bool Lock(ShardIndex index) override
+  {
+    return fake.Lock(index);
+  }
+
+  bool Unlock(ShardIndex index) override
+  {
+    return fake.Unlock(index);
+  }
+
+  Keys KeyDump() const override
+  {
+    return fake.KeyDump();
+  }
+
+  void Reset() override
+  {
+    fake.Reset();
+  }
+
+  Documents GetMany(Addresses const &keys) override
+  {
+    ++num_get_batches;
+    return fake.GetMany(keys);
+  }
+
+  void SetMany(KeyValues const &values) override
+  {
+    ++num_set_batches;
+    last_set_batch = values;
+    fake.SetMany(values);
+  }
+
+  FakeStorageUnit fake;
+
+  std::size_t num_gets{0};
+  std::size_t num_sets{0};
+  std::size_t num_get_batches{0};
+  std::size_t num_set_batches{0};
+  KeyValues   last_set_batch{};
+};
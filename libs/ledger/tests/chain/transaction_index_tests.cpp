@@ -0,0 +1,205 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/constants.hpp"
+#include "ledger/chain/transaction_index.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "testing/common_testing_functionality.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using namespace fetch;
+using namespace fetch::ledger;
+
+using Digests = std::vector<Digest>;
+
+Digests GenerateDigests(uint64_t count)
+{
+  // use a different seed for each call so that the generated sets are distinct
+  static uint64_t seed{0};
+
+  auto const hashes = fetch::testing::GenerateUniqueHashes(count, ++seed);
+  return Digests(hashes.begin(), hashes.end());
+}
+
+Block CreateBlock(uint64_t block_number, Digests const &digests, uint64_t valid_until = 100)
+{
+  Block block{};
+  block.body.block_number = block_number;
+  block.body.slices.resize(1);
+
+  for (auto const &digest : digests)
+  {
+    block.body.slices[0].emplace_back(digest, BitVector{}, 0, 0, valid_until);
+  }
+
+  block.UpdateDigest();
+
+  return block;
+}
+
+TEST(TransactionIndexTests, CheckAddedTransactionsCanBeFound)
+{
+  TransactionIndex index{};
+
+  auto const  digests = GenerateDigests(10);
+  Block const block   = CreateBlock(1, digests);
+
+  index.Add(block);
+  EXPECT_EQ(digests.size(), index.size());
+
+  TransactionIndex::Locations locations{};
+  for (auto const &digest : digests)
+  {
+    ASSERT_TRUE(index.Lookup(digest, locations));
+    ASSERT_EQ(1u, locations.size());
+    EXPECT_EQ(block.body.hash, locations.front().hash);
+    EXPECT_EQ(1u, locations.front().block_number);
+  }
+
+  EXPECT_FALSE(index.Lookup(GenerateDigests(1).front(), locations));
+}
+
+TEST(TransactionIndexTests, CheckTransactionOnCompetingForks)
+{
+  TransactionIndex index{};
+
+  auto const  digests = GenerateDigests(4);
+  Block const fork1   = CreateBlock(5, digests);
+  Block const fork2   = CreateBlock(6, {digests[0]});
+
+  index.Add(fork1);
+  index.Add(fork2);
+
+  // adding the same block again must not duplicate the locations
+  index.Add(fork2);
+
+  TransactionIndex::Locations locations{};
+  ASSERT_TRUE(index.Lookup(digests[0], locations));
+  EXPECT_EQ(2u, locations.size());
+
+  // removing one of the forks retains the other location
+  index.Remove(fork1);
+  EXPECT_EQ(1u, index.size());
+
+  ASSERT_TRUE(index.Lookup(digests[0], locations));
+  ASSERT_EQ(1u, locations.size());
+  EXPECT_EQ(fork2.body.hash, locations.front().hash);
+
+  for (std::size_t i = 1; i < digests.size(); ++i)
+  {
+    EXPECT_FALSE(index.Lookup(digests[i], locations));
+  }
+
+  index.Remove(fork2);
+  EXPECT_EQ(0u, index.size());
+}
+
+TEST(TransactionIndexTests, CheckTransactionsArePrunedAfterTheirValidityWindow)
+{
+  TransactionIndex index{};
+
+  auto const short_lived = GenerateDigests(3);
+  auto const long_lived  = GenerateDigests(5);
+
+  index.Add(CreateBlock(1, short_lived, 20));
+  index.Add(CreateBlock(2, long_lived, 50));
+  EXPECT_EQ(8u, index.size());
+
+  // transactions are retained until the chain has passed the finality period after the expiry
+  EXPECT_EQ(0u, index.Prune(20 + FINALITY_PERIOD - 1));
+  EXPECT_EQ(8u, index.size());
+
+  EXPECT_EQ(short_lived.size(), index.Prune(20 + FINALITY_PERIOD));
+  EXPECT_EQ(long_lived.size(), index.size());
+
+  TransactionIndex::Locations locations{};
+  for (auto const &digest : short_lived)
+  {
+    EXPECT_FALSE(index.Lookup(digest, locations));
+  }
+
+  EXPECT_EQ(long_lived.size(), index.Prune(50 + FINALITY_PERIOD));
+  EXPECT_EQ(0u, index.size());
+}
+
+TEST(TransactionIndexTests, CheckPersistentIndexIsRestoredOnLoad)
+{
+  constexpr char const *PREFIX = "tx_index_test";
+
+  auto const  short_lived = GenerateDigests(3);
+  auto const  long_lived  = GenerateDigests(5);
+  Block const block1      = CreateBlock(1, short_lived, 20);
+  Block const block2      = CreateBlock(2, long_lived, 50);
+
+  {
+    TransactionIndex index{};
+    index.New(PREFIX);
+    EXPECT_TRUE(index.head().empty());
+
+    index.Add(block1);
+    index.Add(block2);
+    index.SetHead(block2.body.hash);
+  }
+
+  TransactionIndex::Locations locations{};
+
+  {
+    TransactionIndex index{};
+    index.Load(PREFIX);
+
+    EXPECT_EQ(block2.body.hash, index.head());
+    EXPECT_EQ(8u, index.size());
+
+    for (auto const &digest : long_lived)
+    {
+      ASSERT_TRUE(index.Lookup(digest, locations));
+      ASSERT_EQ(1u, locations.size());
+      EXPECT_EQ(block2.body.hash, locations.front().hash);
+    }
+
+    // the expiry of the stored transactions is also restored
+    EXPECT_EQ(short_lived.size(), index.Prune(20 + FINALITY_PERIOD));
+    EXPECT_FALSE(index.Lookup(short_lived.front(), locations));
+
+    index.Remove(block2);
+    EXPECT_EQ(0u, index.size());
+  }
+
+  {
+    TransactionIndex index{};
+    index.Load(PREFIX);
+
+    EXPECT_EQ(0u, index.size());
+    EXPECT_FALSE(index.Lookup(long_lived.front(), locations));
+    EXPECT_EQ(0u, index.Prune(50 + FINALITY_PERIOD));
+
+    std::size_t count{0};
+    index.VisitDigests([&count](Digest const &) { ++count; });
+    EXPECT_EQ(0u, count);
+  }
+}
+
+}  // namespace
@@ -1031,4 +1031,51 @@ TEST_F(TransactionSerializerTests, ContractWithLargeShardMask)
   EnsureAreSame(output, *tx);
 }
 
+TEST_F(TransactionSerializerTests, RetainedPayloadReserializesIdentically)
+{
+  // build the transaction
+  auto tx = TransactionBuilder()
+                .From(addresses_[0])
+                .Transfer(addresses_[1], 256u)
+                .Signer(signers_[0]->identity())
+                .Signer(signers_[1]->identity())
+                .ChargeRate(10)
+                .ChargeLimit(500)
+                .TargetChainCode("fetch.token", BitVector{})
+                .Action("transfer")
+                .Data("some data")
+                .Seal()
+                .Sign(*signers_[0])
+                .Sign(*signers_[1])
+                .Build();
+
+  ASSERT_TRUE(static_cast<bool>(tx));
+
+  // serialize the transaction
+  TransactionSerializer serializer;
+  serializer << *tx;
+
+  // deserialize the transaction both retaining and discarding the payload bytes
+  Transaction retained;
+  Transaction discarded;
+  ASSERT_TRUE(serializer.Deserialize(retained, true));
+  ASSERT_TRUE(serializer.Deserialize(discarded, false));
+
+  // both variants must verify and match the original transaction
+  EXPECT_TRUE(retained.Verify());
+  EXPECT_TRUE(discarded.Verify());
+  EnsureAreSame(retained, *tx);
+  EnsureAreSame(discarded, *tx);
+
+  // re-serializing (e.g. for broadcast) must produce exactly the same bytes in both cases
+  TransactionSerializer retained_serializer;
+  retained_serializer << retained;
+
+  TransactionSerializer discarded_serializer;
+  discarded_serializer << discarded;
+
+  EXPECT_EQ(serializer.data(), retained_serializer.data());
+  EXPECT_EQ(serializer.data(), discarded_serializer.data());
+}
+
 }  // namespace
@@ -246,6 +246,27 @@ TEST_F(SmartContractTests, CheckQueryReturnTypes)
   VerifyQuery("get_string", ConstByteArray{"Why hello there"});
 }
 
+TEST_F(SmartContractTests, CheckRepeatedQueriesDoNotObserveModifiedConstants)
+{
+  std::string const contract_source = R"(
+    @query
+    function get_trimmed() : String
+      var value = "  padded  ";
+      value.trim();
+      return value;
+    endfunction
+  )";
+
+  // create the contract
+  CreateContract(contract_source);
+  ASSERT_TRUE(static_cast<bool>(contract_));
+
+  // the VM instances are reused between queries, each query must see the original constant
+  VerifyQuery("get_trimmed", ConstByteArray{"padded"});
+  VerifyQuery("get_trimmed", ConstByteArray{"padded"});
+  VerifyQuery("get_trimmed", ConstByteArray{"padded"});
+}
+
 TEST_F(SmartContractTests, CheckParameterizedActionAndQuery)
 {
   std::string const contract_source = R"(
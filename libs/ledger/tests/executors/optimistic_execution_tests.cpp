@@ -0,0 +1,276 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/macros.hpp"
+#include "core/mutex.hpp"
+#include "ledger/execution_manager.hpp"
+#include "ledger/transaction_status_cache.hpp"
+#include "mock_storage_unit.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+using namespace fetch::ledger;
+
+using fetch::BitVector;
+using fetch::Digest;
+using fetch::storage::ResourceAddress;
+
+constexpr std::size_t NUM_EXECUTORS    = 4;
+constexpr uint32_t    LOG2_NUM_LANES   = 2;
+constexpr std::size_t NUM_TRANSACTIONS = 8;
+
+/**
+ * Simple in memory state of counters shared between all the executors
+ */
+class CounterState
+{
+public:
+  uint64_t Get(ResourceAddress const &address) const
+  {
+    FETCH_LOCK(lock_);
+    auto const it = counters_.find(address);
+    return (it == counters_.end()) ? 0 : it->second;
+  }
+
+  void Set(ResourceAddress const &address, uint64_t value)
+  {
+    FETCH_LOCK(lock_);
+    counters_[address] = value;
+  }
+
+private:
+  mutable fetch::Mutex                          lock_;
+  std::unordered_map<ResourceAddress, uint64_t> counters_;
+};
+
+/**
+ * The change generated by incrementing a counter
+ */
+class IncrementChange : public PendingChanges
+{
+public:
+  IncrementChange(CounterState &state, ResourceAddress const &address, uint64_t value)
+    : state_{state}
+    , address_{address}
+    , value_{value}
+    , accessed_{address}
+  {}
+
+  ResourceSet const &read_set() const override
+  {
+    return accessed_;
+  }
+
+  ResourceSet const &write_set() const override
+  {
+    return accessed_;
+  }
+
+  void Apply() override
+  {
+    state_.Set(address_, value_);
+  }
+
+private:
+  CounterState &  state_;
+  ResourceAddress address_;
+  uint64_t        value_;
+  ResourceSet     accessed_;
+};
+
+/**
+ * Executor where each transaction increments a counter. When the shared flag is set all the
+ * transactions increment the same counter otherwise each transaction has its own counter.
+ */
+class CounterExecutor : public ExecutorInterface
+{
+public:
+  CounterExecutor(CounterState &state, bool shared, std::atomic<std::size_t> &executions)
+    : state_{state}
+    , shared_{shared}
+    , executions_{executions}
+  {}
+
+  Result Execute(Digest const &digest, BlockIndex /*block*/, SliceIndex /*slice*/,
+                 BitVector const & /*shards*/) override
+  {
+    PendingChangesPtr changes;
+    auto const        result = Increment(digest, changes);
+    changes->Apply();
+    return result;
+  }
+
+  Result ExecuteSpeculatively(Digest const &digest, BlockIndex /*block*/, SliceIndex /*slice*/,
+                              BitVector const & /*shards*/, StorageInterface & /*state*/,
+                              PendingChangesPtr &changes) override
+  {
+    return Increment(digest, changes);
+  }
+
+  void SettleFees(Address const & /*miner*/, TokenAmount /*amount*/,
+                  uint32_t /*log2_num_lanes*/) override
+  {}
+
+private:
+  Result Increment(Digest const &digest, PendingChangesPtr &changes)
+  {
+    ++executions_;
+
+    ResourceAddress const address{shared_ ? std::string{"counter"} : digest.ToHex()};
+
+    // delay the update to encourage the executions to overlap
+    uint64_t const value = state_.Get(address);
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+
+    changes = std::make_unique<IncrementChange>(state_, address, value + 1);
+
+    // report the updated counter value as the charge to identify the execution
+    Result result{Status::SUCCESS};
+    result.charge = value + 1;
+
+    return result;
+  }
+
+  CounterState &            state_;
+  bool                      shared_;
+  std::atomic<std::size_t> &executions_;
+};
+
+class OptimisticExecutionTests : public ::testing::Test
+{
+protected:
+  void CreateManager(bool shared)
+  {
+    manager_ = std::make_shared<ExecutionManager>(
+        NUM_EXECUTORS, LOG2_NUM_LANES, std::make_shared<MockStorageUnit>(),
+        [this, shared]() { return std::make_shared<CounterExecutor>(state_, shared, executions_); },
+        status_cache_);
+
+    manager_->SetOptimisticExecution(true);
+    manager_->Start();
+  }
+
+  void TearDown() override
+  {
+    manager_->Stop();
+    manager_.reset();
+  }
+
+  static Block::Body CreateSingleSliceBlock()
+  {
+    Block::Body block;
+    block.hash         = Digest{"block hash"};
+    block.block_number = 1;
+    block.slices.resize(1);
+
+    // every transaction spans all of the lanes
+    BitVector mask{1u << LOG2_NUM_LANES};
+    mask.SetAllOne();
+
+    for (std::size_t i = 0; i < NUM_TRANSACTIONS; ++i)
+    {
+      block.slices[0].emplace_back(
+          TransactionLayout{Digest{"transaction " + std::to_string(i)}, mask, 1, 0, 100});
+    }
+
+    return block;
+  }
+
+  bool ExecuteAndWait(Block::Body const &block)
+  {
+    if (ExecutionManager::ScheduleStatus::SCHEDULED != manager_->Execute(block))
+    {
+      return false;
+    }
+
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{50});
+
+      if ((ExecutionManager::State::IDLE == manager_->GetState()) &&
+          (manager_->completed_executions() >= block.slices[0].size()))
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  CounterState                      state_;
+  std::atomic<std::size_t>          executions_{0};
+  TransactionStatusCache::ShrdPtr   status_cache_{TransactionStatusCache::factory()};
+  std::shared_ptr<ExecutionManager> manager_;
+};
+
+TEST_F(OptimisticExecutionTests, ConflictingTransactionsAreReExecutedInOrder)
+{
+  CreateManager(true);
+
+  ASSERT_TRUE(ExecuteAndWait(CreateSingleSliceBlock()));
+
+  // the result must be the same as executing the transactions one after another
+  EXPECT_EQ(state_.Get(ResourceAddress{"counter"}), NUM_TRANSACTIONS);
+  EXPECT_GT(executions_, NUM_TRANSACTIONS);
+}
+
+TEST_F(OptimisticExecutionTests, ReExecutedTransactionsReportTheirFinalResult)
+{
+  CreateManager(true);
+
+  auto const block = CreateSingleSliceBlock();
+  ASSERT_TRUE(ExecuteAndWait(block));
+
+  // each transaction must report the result of the execution whose changes were applied
+  uint64_t expected_charge{0};
+  for (auto const &layout : block.slices[0])
+  {
+    auto const status = status_cache_->Query(layout.digest());
+
+    EXPECT_EQ(ContractExecutionStatus::SUCCESS, status.contract_exec_result.status);
+    EXPECT_EQ(++expected_charge, status.contract_exec_result.charge);
+  }
+}
+
+TEST_F(OptimisticExecutionTests, IndependentTransactionsAreExecutedOnce)
+{
+  CreateManager(false);
+
+  auto const block = CreateSingleSliceBlock();
+  ASSERT_TRUE(ExecuteAndWait(block));
+
+  for (auto const &layout : block.slices[0])
+  {
+    EXPECT_EQ(state_.Get(ResourceAddress{layout.digest().ToHex()}), 1u);
+  }
+
+  EXPECT_EQ(executions_, NUM_TRANSACTIONS);
+}
+
+}  // namespace
@@ -18,144 +18,145 @@
 //------------------------------------------------------------------------------
 
 #include "core/mutex.hpp"
-#include "crypto/fnv.hpp"
-#include "miner/block_optimiser.hpp"
-#include "miner/miner_interface.hpp"
-#include "miner/transaction_item.hpp"
+#include "ledger/block_packer_interface.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "miner/optimisation/binary_annealer.hpp"
+#include "miner/transaction_layout_queue.hpp"
+#include "telemetry/telemetry.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace fetch {
 namespace miner {
 
-class AnnealerMiner : public MinerInterface
+/**
+ * Block packer which searches for the contents of each slice using simulated annealing.
+ *
+ * For each slice a batch of the highest fee transactions in the pool is formulated as a binary
+ * optimisation problem, where the fee of each transaction is rewarded and every pair of
+ * transactions which share a lane is penalised. Independent annealing runs are executed in
+ * parallel (one per worker thread) until the time budget for the slice has been used. Each
+ * solution is repaired (conflicting transactions are dropped and any free lanes are filled in fee
+ * order) and the solution with the highest fee, and then the highest lane occupancy, is packed.
+ *
+ * The greedy first fit packing of the batch is always one of the candidate solutions, therefore
+ * the annealer never produces a slice with a lower fee than the greedy packing of the same batch.
+ */
+class AnnealerMiner : public ledger::BlockPackerInterface
 {
 public:
-  using TransactionType        = std::shared_ptr<TransactionItem>;
-  using transaction_queue_type = std::vector<TransactionType>;
-  using GeneratorType          = ledger::BlockGenerator;
-
   static constexpr char const *LOGGING_NAME = "AnnealerMiner";
 
-  void EnqueueTransaction(ledger::TransactionSummary const &tx) override
-  {
-    FETCH_LOCK(pending_queue_lock_);
-
-    auto stx = std::make_shared<TransactionItem>(tx, transaction_index_++);
-
-    FETCH_LOG_DEBUG(LOGGING_NAME, "EnqueueTransaction: ", byte_array::ToBase64(tx.transaction_hash),
-                    " (fee: ", tx.fee, ")");
-    pending_queue_.push_back(stx);
-  }
-
-  void GenerateBlock(ledger::BlockBody &block, std::size_t num_lanes,
-                     std::size_t num_slices) override
-  {
-
-    // push the currently pending elements into the generator
-    {
-      FETCH_LOCK(pending_queue_lock_);
-
-      for (auto &tx : pending_queue_)
-      {
-        FETCH_LOG_DEBUG(LOGGING_NAME, "Pushing Transaction: ",
-                        byte_array::ToBase64(tx->summary().transaction_hash));
-        generator_.PushTransactionSummary(tx);
-      }
-      pending_queue_.clear();
-    }
-
-    std::size_t const num_transactions = generator_.unspent_count();
-
-    FETCH_LOG_INFO(LOGGING_NAME, "Starting block packing (Backlog: ", num_transactions, ")");
-
-    if (num_transactions <= num_lanes)
-    {
-      FillBlock(block, num_lanes, num_slices);
-    }
-    else if (num_transactions > 1)
-    {
-      PopulateBlock(block, num_lanes, num_slices);
-    }
-
-    FETCH_LOG_INFO(LOGGING_NAME, "Finished block packing");
-  }
+  using Block             = ledger::Block;
+  using MainChain         = ledger::MainChain;
+  using TransactionLayout = ledger::TransactionLayout;
+  using Duration          = std::chrono::milliseconds;
+
+  static constexpr std::size_t DEFAULT_BATCH_SIZE = 256;
+  static constexpr std::size_t DEFAULT_SWEEPS     = 100;
+
+  // Construction / Destruction
+  AnnealerMiner(uint32_t log2_num_lanes, Duration time_budget,
+                std::size_t num_threads = std::thread::hardware_concurrency(),
+                std::size_t batch_size  = DEFAULT_BATCH_SIZE);
+  AnnealerMiner(AnnealerMiner const &) = delete;
+  AnnealerMiner(AnnealerMiner &&)      = delete;
+  ~AnnealerMiner() override            = default;
+
+  /// @name Miner Interface
+  /// @{
+  void     EnqueueTransaction(ledger::Transaction const &tx) override;
+  void     EnqueueTransaction(ledger::TransactionLayout const &layout) override;
+  void     GenerateBlock(Block &block, std::size_t num_lanes, std::size_t num_slices,
+                         MainChain const &chain) override;
+  uint64_t GetBacklog() const override;
+  /// @}
+
+  // Operators
+  AnnealerMiner &operator=(AnnealerMiner const &) = delete;
+  AnnealerMiner &operator=(AnnealerMiner &&) = delete;
 
 private:
-  void FillBlock(ledger::BlockBody &block, std::size_t num_lanes, std::size_t num_slices)
-  {
-    block.slices.clear();
-    block.slices.resize(num_slices);
-
-    auto &unspent = generator_.unspent();
-
-    for (std::size_t i = 0; (i < num_slices) && (!unspent.empty()); ++i)
-    {
-      block.slices[i].transactions.push_back(unspent.back()->summary());
-      unspent.pop_back();
-    }
-  }
-
-  void PopulateBlock(ledger::BlockBody &block, std::size_t num_lanes, std::size_t num_slices)
+  using Clock       = std::chrono::steady_clock;
+  using Timepoint   = Clock::time_point;
+  using Queue       = TransactionLayoutQueue;
+  using Iterators   = std::vector<Queue::Iterator>;
+  using Annealer    = optimisers::BinaryAnnealer;
+  using Annealers   = std::vector<Annealer>;
+  using State       = Annealer::StateType;
+  using Indices     = std::vector<std::size_t>;
+  using LaneMembers = std::vector<Indices>;
+  using Conflicts   = std::vector<std::pair<std::size_t, std::size_t>>;
+  using ThreadPool  = threading::Pool;
+  using TokenAmount = TransactionLayout::TokenAmount;
+
+  struct Solution
   {
-    using Strategy = GeneratorType::Strategy;
-
-    // configure the solver
-    generator_.ConfigureAnnealer(100, 0.1, 3.0);
-
-    // TODO(issue 7):  Move to configuration variables
-    std::size_t const batch_size =
-        std::min<std::size_t>(std::min(generator_.unspent_count(), num_lanes * num_slices),
-                              2000);  // magic number based on single threaded performance
-    std::size_t const explore  = 1;
-    Strategy const    strategy = Strategy::FEE_OCCUPANCY;
-
-    generator_.Reset();
-    generator_.GenerateBlock(num_lanes, num_slices, strategy, batch_size, explore);
-
-    // DEBUG PRINT OUT SOLUTIONS
-
-    uint64_t total_fee = 0;
-    for (auto const &e : generator_.block_fees())
-    {
-      total_fee += e;
-    }
-
-    auto &staged = generator_.staged();
-
-    block.slices.clear();
-    block.slices.resize(num_slices);
-
-    detailed_assert(block.slices.size() == staged.size());
-    std::size_t slice_index = 0;
-    for (auto const &slice : staged)
-    {
-      for (auto const &tx : slice)
-      {
-        block.slices[slice_index].transactions.push_back(tx->summary());
-      }
-      ++slice_index;
-    }
-
-    staged.clear();
-
-    double const occupancy_pc = (static_cast<double>(generator_.block_occupancy() * 100)) /
-                                static_cast<double>(num_lanes * num_slices);
-
-    FETCH_LOG_INFO(LOGGING_NAME, "Block summary. Fee: ", total_fee,
-                   " Occupancy: ", generator_.block_occupancy(), " (", occupancy_pc, "%)");
-  }
-
-  uint64_t backlog() const override
-  {
-    FETCH_LOCK(pending_queue_lock_);
-    return generator_.unspent().size() + pending_queue_.size();
-  }
-
-  Mutex pending_queue_lock_;  ///< Protects both `pending_queue_` and
-                              ///< `transaction_index_`
-  transaction_queue_type pending_queue_;
-  std::size_t            transaction_index_{0};
-
-  GeneratorType generator_;
+    Indices     indices{};       ///< The indices of the batch transactions in the solution
+    TokenAmount fee{0};          ///< The total fee of the solution
+    std::size_t occupancy{0};    ///< The number of lanes occupied by the solution
+    std::size_t num_anneals{0};  ///< The number of annealing runs which were evaluated
+
+    bool IsBetterThan(Solution const &other) const;
+  };
+
+  using Solutions = std::vector<Solution>;
+
+  /// @name Packing Operations
+  /// @{
+  void     GenerateSlice(Block::Slice &slice, Timepoint const &deadline);
+  void     PrepareBatch();
+  void     Search(std::size_t worker, Timepoint const &deadline);
+  void     Program(Annealer &annealer) const;
+  Solution Repair(State const &state) const;
+  /// @}
+
+  /// @name Configuration
+  /// @{
+  uint32_t const    log2_num_lanes_;  ///< The log2 of the number of lanes
+  std::size_t const num_lanes_;       ///< The number of lanes
+  Duration const    time_budget_;     ///< The time budget for packing a complete block
+  std::size_t const num_threads_;     ///< The number of annealing threads
+  std::size_t const batch_size_;      ///< The max number of transactions considered per slice
+  /// @}
+
+  /// @name Pending Queue
+  /// @{
+  mutable Mutex pending_lock_;  ///< Pending queue lock (priority 1)
+  Queue         pending_;       ///< The queue of newly received transactions
+  /// @}
+
+  /// @name Central Mining Pool Queue
+  /// @{
+  mutable Mutex mining_pool_lock_;  ///< Mining pool lock (priority 0)
+  Queue         mining_pool_;       ///< The main mining queue for the node
+  /// @}
+
+  /// @name Slice Packing State
+  /// @{
+  Iterators   batch_{};         ///< The batch of candidate transactions (ordered by fee)
+  Conflicts   conflicts_{};     ///< The pairs of batch transactions which share a lane
+  LaneMembers lane_members_{};  ///< The batch transactions which use each of the lanes
+  Annealers   annealers_;       ///< The annealer for each of the workers
+  Solutions   solutions_;       ///< The best solution found by each of the workers
+  ThreadPool  thread_pool_;     ///< The pool of annealing workers
+  /// @}
+
+  /// @name Telemetry
+  /// @{
+  telemetry::GaugePtr<uint64_t> mining_pool_size_;
+  telemetry::CounterPtr         duplicate_count_;
+  telemetry::CounterPtr         duplicate_filtered_count_;
+  telemetry::CounterPtr         anneal_count_;
+  telemetry::CounterPtr         improved_slice_count_;
+  /// @}
 };
 
 }  // namespace miner
@@ -0,0 +1,156 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/digest.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "miner/transaction_layout_queue.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace miner {
+
+/**
+ * A pool of transaction layouts indexed by lane, used by the miner to pack slices.
+ *
+ * Each layout is referenced from a fee-priority heap for every lane that it uses. The lane mask of
+ * each layout is stored inline in a flat array of fixed width words. A slice is filled greedily by
+ * repeatedly selecting the highest fee layout among the heads of the heaps of the free lanes. This
+ * gives the same result as scanning the whole pool in fee order (ties resolved by order of arrival)
+ * but only visits the layouts which are packed or blocked by a lane collision.
+ *
+ * Layouts removed from the pool are deleted lazily from the heaps, which are periodically
+ * compacted.
+ */
+class LaneIndexedPool
+{
+public:
+  using TransactionLayout = ledger::TransactionLayout;
+  using Slice             = ledger::Block::Slice;
+
+  // Construction / Destruction
+  explicit LaneIndexedPool(std::size_t num_lanes);
+  LaneIndexedPool(LaneIndexedPool const &) = delete;
+  LaneIndexedPool(LaneIndexedPool &&)      = delete;
+  ~LaneIndexedPool()                       = default;
+
+  /// @name Accessors
+  /// @{
+  std::size_t      num_lanes() const;
+  std::size_t      size() const;
+  bool             empty() const;
+  DigestSet const &digests() const;
+  /// @}
+
+  /// @name Basic Operations
+  /// @{
+  bool        Add(TransactionLayout const &layout);
+  void        Splice(TransactionLayoutQueue &queue);
+  std::size_t Remove(DigestSet const &digests);
+  /// @}
+
+  /// @name Packing
+  /// @{
+  void GenerateSlice(Slice &slice);
+  /// @}
+
+  // Operators
+  LaneIndexedPool &operator=(LaneIndexedPool const &) = delete;
+  LaneIndexedPool &operator=(LaneIndexedPool &&) = delete;
+
+private:
+  using Word        = uint64_t;
+  using Words       = std::vector<Word>;
+  using Slot        = uint32_t;
+  using Slots       = std::vector<Slot>;
+  using TokenAmount = TransactionLayout::TokenAmount;
+
+  static constexpr std::size_t BITS_PER_WORD = sizeof(Word) * 8u;
+
+  struct Entry
+  {
+    TransactionLayout layout{};     ///< The transaction layout
+    uint64_t          sequence{0};   ///< The unique sequence number (0 when the slot is free)
+    std::size_t       num_items{0};  ///< The number of heap items referencing this entry
+  };
+
+  struct Item
+  {
+    TokenAmount charge;    ///< The charge of the layout
+    uint64_t    sequence;  ///< The sequence number of the layout (order of arrival)
+    Slot        slot;      ///< The slot containing the layout
+
+    bool operator<(Item const &other) const;
+  };
+
+  struct Candidate
+  {
+    Item        item;  ///< The head of the lane heap
+    std::size_t lane;  ///< The lane
+
+    bool operator<(Candidate const &other) const;
+  };
+
+  using Entries    = std::vector<Entry>;
+  using Heap       = std::vector<Item>;
+  using Heaps      = std::vector<Heap>;
+  using Candidates = std::vector<Candidate>;
+  using SlotIndex  = DigestMap<Slot>;
+
+  Word const *Mask(Slot slot) const;
+  bool        IsLive(Item const &item) const;
+  bool        IsOccupied(std::size_t lane) const;
+  bool        Collides(Slot slot) const;
+  bool        Prune(std::size_t lane);
+  void        PushCandidate(std::size_t lane);
+  void        Release(Slot slot);
+  void        CompactIfRequired();
+
+  /// @name Configuration
+  /// @{
+  std::size_t const num_lanes_;  ///< The number of lanes
+  std::size_t const num_words_;  ///< The number of words for each lane mask
+  /// @}
+
+  /// @name Pool Contents
+  /// @{
+  Entries     entries_{};         ///< The entries of the pool
+  Words       masks_{};           ///< The inline lane masks, num_words_ words per slot
+  Slots       free_slots_{};      ///< The slots which are available for reuse
+  SlotIndex   slot_index_{};      ///< Map of the digest to the slot
+  DigestSet   digests_{};         ///< The set of digests in the pool
+  Heaps       heaps_{};           ///< Heap per lane (+1 for layouts without lanes)
+  std::size_t heap_items_{0};     ///< The total number of items (including stale) in the heaps
+  std::size_t live_items_{0};     ///< The number of items which reference live entries
+  uint64_t    next_sequence_{1};  ///< The next sequence number
+  /// @}
+
+  /// @name Packing State
+  /// @{
+  Words      slice_state_{};  ///< The lanes occupied in the current slice
+  Candidates frontier_{};     ///< Heap of the heads of the free lanes
+  Candidates deferred_{};     ///< Items blocked in the current slice
+  /// @}
+};
+
+}  // namespace miner
+}  // namespace fetch
@@ -74,6 +74,10 @@ public:
         case 0:
           break;
         case 1:
+          B(0) = s.couplings(0) & state_(0);
+          p    = __builtin_popcountl(B(0));
+          break;
+
         case 2:
           B(0) = s.couplings(0) & state_(0);
           B(1) = s.couplings(1) & state_(1);
@@ -81,7 +85,6 @@ public:
 
           break;
 
-        case 3:
         case 4:
           B(0) = s.couplings(0) & state_(0);
           B(1) = s.couplings(1) & state_(1);
@@ -206,8 +209,9 @@ public:
 
     state_.Resize(n);
     state_.SetAllZero();
-    size_               = n;
-    coupling_magnitude_ = 0;
+    size_                   = n;
+    coupling_magnitude_     = 0;
+    normalisation_constant_ = 1.0;
   }
 
   void Insert(std::size_t i, std::size_t j, CostType const &val)
@@ -263,6 +267,12 @@ public:
     beta1_ = b1;
   }
 
+  void SetSeed(uint64_t seed)
+  {
+    sim_rng_.Seed(seed);
+    init_rng_.Seed(seed);
+  }
+
   void Initialise()
   {
     attempts_ = 0;
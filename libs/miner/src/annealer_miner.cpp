@@ -0,0 +1,465 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/logging.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/main_chain.hpp"
+#include "ledger/chain/transaction.hpp"
+#include "miner/annealer_miner.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/gauge.hpp"
+#include "telemetry/registry.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace fetch {
+namespace miner {
+namespace {
+
+// The annealing schedule (inverse temperatures) used for each of the runs
+constexpr double BETA_START = 0.1;
+constexpr double BETA_END   = 3.0;
+
+}  // namespace
+
+/**
+ * Construct the AnnealerMiner
+ *
+ * @param log2_num_lanes Log2 of the number of lanes
+ * @param time_budget The time budget for packing each block
+ * @param num_threads The number of annealing threads
+ * @param batch_size The max number of transactions considered for each slice
+ */
+AnnealerMiner::AnnealerMiner(uint32_t log2_num_lanes, Duration time_budget,
+                             std::size_t num_threads, std::size_t batch_size)
+  : log2_num_lanes_{log2_num_lanes}
+  , num_lanes_{std::size_t{1} << log2_num_lanes}
+  , time_budget_{time_budget}
+  , num_threads_{std::max<std::size_t>(num_threads, 1)}
+  , batch_size_{std::max<std::size_t>(batch_size, 1)}
+  , lane_members_(num_lanes_)
+  , annealers_(num_threads_)
+  , solutions_(num_threads_)
+  , thread_pool_{num_threads_, "Annealer"}
+  , mining_pool_size_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
+        "ledger_annealer_miner_mining_pool_size", "The current size of the mining pool")}
+  , duplicate_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_annealer_miner_duplicate_total",
+        "The number of duplicate txs on the frontend of the queue")}
+  , duplicate_filtered_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_annealer_miner_duplicate_filtered_total",
+        "The number of duplicate txs on the backend of the queue")}
+  , anneal_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_annealer_miner_anneals_total", "The number of annealing runs performed")}
+  , improved_slice_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_annealer_miner_improved_slices_total",
+        "The number of slices where annealing improved on the greedy packing")}
+{
+  for (std::size_t i = 0; i < annealers_.size(); ++i)
+  {
+    auto &annealer = annealers_[i];
+
+    annealer.SetSweeps(DEFAULT_SWEEPS);
+    annealer.SetBetaStart(BETA_START);
+    annealer.SetBetaEnd(BETA_END);
+
+    // ensure that each of the workers explores a different set of solutions
+    annealer.SetSeed(i + 1);
+  }
+}
+
+/**
+ * Add the specified transaction to the internal queue
+ *
+ * @param tx The reference to the transaction
+ */
+void AnnealerMiner::EnqueueTransaction(ledger::Transaction const &tx)
+{
+  EnqueueTransaction(ledger::TransactionLayout{tx, log2_num_lanes_});
+}
+
+/**
+ * Add the specified transaction layout to the internal queue
+ *
+ * @param layout The reference to the transaction layout
+ */
+void AnnealerMiner::EnqueueTransaction(ledger::TransactionLayout const &layout)
+{
+  FETCH_LOCK(pending_lock_);
+
+  if (layout.mask().size() != num_lanes_)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Disgarding layout due to incompatible mask size");
+    return;
+  }
+
+  if (!pending_.Add(layout))
+  {
+    duplicate_count_->increment();
+  }
+}
+
+/**
+ * Generate a new block based on the current queue of transactions. Not thread safe.
+ *
+ * @param block The reference to the output block to generate
+ * @param num_lanes The number of lanes for the block
+ * @param num_slices The number of slices for the block
+ * @param chain The main chain
+ */
+void AnnealerMiner::GenerateBlock(Block &block, std::size_t num_lanes, std::size_t num_slices,
+                                  MainChain const &chain)
+{
+  FETCH_LOCK(mining_pool_lock_);
+  assert(num_lanes == num_lanes_);
+
+  Timepoint const block_deadline = Clock::now() + time_budget_;
+
+  // splice the contents of the pending queue into the main mining pool
+  {
+    FETCH_LOCK(pending_lock_);
+    mining_pool_.Splice(pending_);
+  }
+
+  // detect and remove the transactions which have already been incorporated into previous blocks
+  auto const duplicates =
+      chain.DetectDuplicateTransactions(block.body.previous_hash, mining_pool_.digests());
+
+  duplicate_filtered_count_->add(duplicates.size());
+  mining_pool_.Remove(duplicates);
+
+  mining_pool_size_->set(mining_pool_.size());
+
+  std::size_t const pool_size_before = mining_pool_.size();
+
+  FETCH_LOG_INFO(LOGGING_NAME, "Starting block packing. Pool Size: ", pool_size_before);
+
+  // the batches for each slice are drawn from the highest fee transactions
+  mining_pool_.Sort([](TransactionLayout const &a, TransactionLayout const &b) {
+    return a.charge() > b.charge();
+  });
+
+  block.body.slices.resize(num_slices);
+  for (std::size_t i = 0; (i < num_slices) && !mining_pool_.empty(); ++i)
+  {
+    // share the remaining time budget equally between the remaining slices
+    Timepoint const now       = Clock::now();
+    auto const      remaining = std::max(block_deadline - now, Clock::duration::zero());
+    auto const      share     = remaining / static_cast<Clock::duration::rep>(num_slices - i);
+
+    GenerateSlice(block.body.slices[i], now + share);
+  }
+
+  block.UpdateTimestamp();
+
+  std::size_t const remaining_transactions = mining_pool_.size();
+  std::size_t const packed_transactions    = pool_size_before - remaining_transactions;
+
+  FETCH_LOG_INFO(LOGGING_NAME, "Finished block packing (packed: ", packed_transactions,
+                 " remaining: ", remaining_transactions, ")");
+}
+
+/**
+ * Get the number of transactions that make up the mining pool
+ *
+ * @return The number of pending transactions
+ */
+uint64_t AnnealerMiner::GetBacklog() const
+{
+  FETCH_LOCK(mining_pool_lock_);
+  return mining_pool_.size();
+}
+
+/**
+ * Determine if this solution should be preferred over the other: the highest fee first and then
+ * the highest lane occupancy
+ *
+ * @param other The other solution
+ * @return true if this solution is better, otherwise false
+ */
+bool AnnealerMiner::Solution::IsBetterThan(Solution const &other) const
+{
+  if (fee != other.fee)
+  {
+    return fee > other.fee;
+  }
+
+  return occupancy > other.occupancy;
+}
+
+/**
+ * Internal: Search for the best contents of the next slice and move them from the mining pool into
+ * the slice
+ *
+ * @param slice The slice to be populated
+ * @param deadline The time by which the annealing search must be completed
+ */
+void AnnealerMiner::GenerateSlice(Block::Slice &slice, Timepoint const &deadline)
+{
+  PrepareBatch();
+
+  // the greedy packing of the batch is always a candidate solution
+  Solution best = Repair(State{});
+
+  // when the batch has no conflicts the greedy solution already contains the whole batch
+  if (!conflicts_.empty())
+  {
+    for (std::size_t worker = 0; worker < num_threads_; ++worker)
+    {
+      thread_pool_.Dispatch([this, worker, &deadline]() { Search(worker, deadline); });
+    }
+
+    thread_pool_.Wait();
+
+    bool        improved{false};
+    std::size_t num_anneals{0};
+    for (auto &solution : solutions_)
+    {
+      num_anneals += solution.num_anneals;
+
+      if (solution.IsBetterThan(best))
+      {
+        best     = std::move(solution);
+        improved = true;
+      }
+    }
+
+    anneal_count_->add(num_anneals);
+
+    if (improved)
+    {
+      improved_slice_count_->increment();
+    }
+  }
+
+  // move the selected transactions into the slice
+  BitVector slice_state{num_lanes_};
+  for (auto const index : best.indices)
+  {
+    auto const &layout = *batch_[index];
+
+    slice_state |= layout.mask();
+    slice.push_back(layout);
+
+    mining_pool_.Erase(batch_[index]);
+  }
+
+  batch_.clear();
+
+  // every remaining transaction from the batch collides with the slice, fill any free lanes from
+  // the remainder of the pool
+  auto it = mining_pool_.begin();
+  while ((it != mining_pool_.end()) && (slice_state.PopCount() < num_lanes_))
+  {
+    BitVector const collisions = slice_state & it->mask();
+
+    if (collisions.PopCount() == 0)
+    {
+      slice_state |= it->mask();
+      slice.push_back(*it);
+
+      it = mining_pool_.Erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+/**
+ * Internal: Select the batch of candidate transactions for the next slice and determine the
+ * conflicts between them
+ */
+void AnnealerMiner::PrepareBatch()
+{
+  batch_.clear();
+  conflicts_.clear();
+
+  for (auto it = mining_pool_.begin();
+       (it != mining_pool_.end()) && (batch_.size() < batch_size_); ++it)
+  {
+    batch_.push_back(it);
+  }
+
+  // group the batch by lane
+  for (auto &members : lane_members_)
+  {
+    members.clear();
+  }
+
+  for (std::size_t index = 0; index < batch_.size(); ++index)
+  {
+    auto const &mask = batch_[index]->mask();
+
+    for (std::size_t lane = 0; lane < num_lanes_; ++lane)
+    {
+      if (mask.bit(lane) != 0u)
+      {
+        lane_members_[lane].push_back(index);
+      }
+    }
+  }
+
+  // every pair of transactions on the same lane conflicts
+  for (auto const &members : lane_members_)
+  {
+    for (std::size_t i = 0; i < members.size(); ++i)
+    {
+      for (std::size_t j = i + 1; j < members.size(); ++j)
+      {
+        conflicts_.emplace_back(members[i], members[j]);
+      }
+    }
+  }
+
+  // transactions which share multiple lanes only need to be penalised once
+  std::sort(conflicts_.begin(), conflicts_.end());
+  conflicts_.erase(std::unique(conflicts_.begin(), conflicts_.end()), conflicts_.end());
+}
+
+/**
+ * Internal: Worker loop, repeatedly annealing the current batch until the deadline
+ *
+ * At least one annealing run is always performed.
+ *
+ * @param worker The index of the worker
+ * @param deadline The time at which the search should stop
+ */
+void AnnealerMiner::Search(std::size_t worker, Timepoint const &deadline)
+{
+  auto &annealer = annealers_[worker];
+  auto &best     = solutions_[worker];
+
+  best = Solution{};
+  Program(annealer);
+
+  State       state{};
+  std::size_t num_anneals{0};
+  do
+  {
+    annealer.FindMinimum(state);
+    ++num_anneals;
+
+    Solution solution = Repair(state);
+    if (solution.IsBetterThan(best))
+    {
+      best = std::move(solution);
+    }
+  } while (Clock::now() < deadline);
+
+  best.num_anneals = num_anneals;
+}
+
+/**
+ * Internal: Program the annealer with the optimisation problem for the current batch
+ *
+ * The fee of each transaction is rewarded (a negative local field) and each conflicting pair of
+ * transactions is penalised by a coupling which outweighs the fees of both transactions.
+ *
+ * @param annealer The annealer to be programmed
+ */
+void AnnealerMiner::Program(Annealer &annealer) const
+{
+  using Cost = Annealer::CostType;
+
+  TokenAmount max_charge{0};
+  for (auto const &it : batch_)
+  {
+    max_charge = std::max(max_charge, it->charge());
+  }
+
+  Cost const penalty = 2.0 * (static_cast<Cost>(max_charge) + 1.0);
+
+  // the annealer is reused for every slice, clear the normalisation of the previous problem so
+  // that it does not compound into the annealing schedule
+  annealer.Reset();
+  annealer.Resize(batch_.size());
+
+  for (std::size_t i = 0; i < batch_.size(); ++i)
+  {
+    annealer.Insert(i, i, -static_cast<Cost>(batch_[i]->charge()));
+  }
+
+  for (auto const &conflict : conflicts_)
+  {
+    annealer.Insert(conflict.first, conflict.second, penalty);
+  }
+
+  annealer.Normalise();
+}
+
+/**
+ * Internal: Convert the state of the annealer into a valid slice
+ *
+ * The selected transactions are added in fee order, dropping any which collide. The free lanes are
+ * then filled from the unselected transactions, also in fee order. An empty state therefore gives
+ * the greedy first fit packing of the batch.
+ *
+ * @param state The state of the annealer (one spin per batch transaction)
+ * @return The corresponding solution
+ */
+AnnealerMiner::Solution AnnealerMiner::Repair(State const &state) const
+{
+  Solution  solution{};
+  BitVector slice_state{num_lanes_};
+
+  auto const add = [this, &solution, &slice_state](std::size_t index) {
+    auto const &layout = *batch_[index];
+
+    BitVector const collisions = slice_state & layout.mask();
+    if (collisions.PopCount() == 0)
+    {
+      slice_state |= layout.mask();
+
+      solution.indices.push_back(index);
+      solution.fee += layout.charge();
+    }
+  };
+
+  auto const is_selected = [&state](std::size_t index) {
+    return (index < state.size()) && (state[index] != 0);
+  };
+
+  for (std::size_t index = 0; index < batch_.size(); ++index)
+  {
+    if (is_selected(index))
+    {
+      add(index);
+    }
+  }
+
+  for (std::size_t index = 0; index < batch_.size(); ++index)
+  {
+    if (!is_selected(index))
+    {
+      add(index);
+    }
+  }
+
+  solution.occupancy = slice_state.PopCount();
+
+  return solution;
+}
+
+}  // namespace miner
+}  // namespace fetch
@@ -0,0 +1,406 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "miner/lane_indexed_pool.hpp"
+#include "vectorise/platform.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace fetch {
+namespace miner {
+namespace {
+
+// The minimum number of stale heap items before the heaps are compacted
+constexpr std::size_t MIN_STALE_ITEMS_BEFORE_COMPACTION = 1024;
+
+}  // namespace
+
+/**
+ * Heap ordering: higher charge first, then the earliest arrival first
+ */
+bool LaneIndexedPool::Item::operator<(Item const &other) const
+{
+  if (charge != other.charge)
+  {
+    return charge < other.charge;
+  }
+
+  return sequence > other.sequence;
+}
+
+bool LaneIndexedPool::Candidate::operator<(Candidate const &other) const
+{
+  return item < other.item;
+}
+
+/**
+ * Construct the pool
+ *
+ * @param num_lanes The number of lanes
+ */
+LaneIndexedPool::LaneIndexedPool(std::size_t num_lanes)
+  : num_lanes_{num_lanes}
+  , num_words_{(num_lanes + BITS_PER_WORD - 1u) / BITS_PER_WORD}
+  , heaps_(num_lanes + 1u)
+  , slice_state_(num_words_, 0)
+{}
+
+std::size_t LaneIndexedPool::num_lanes() const
+{
+  return num_lanes_;
+}
+
+std::size_t LaneIndexedPool::size() const
+{
+  return digests_.size();
+}
+
+bool LaneIndexedPool::empty() const
+{
+  return digests_.empty();
+}
+
+DigestSet const &LaneIndexedPool::digests() const
+{
+  return digests_;
+}
+
+/**
+ * Adds a transaction layout to the pool
+ *
+ * @param layout The transaction layout to be added
+ * @return true if successful, otherwise false (duplicate or incompatible layout)
+ */
+bool LaneIndexedPool::Add(TransactionLayout const &layout)
+{
+  auto const &digest = layout.digest();
+  auto const &mask   = layout.mask();
+
+  if ((mask.size() != num_lanes_) || (digests_.find(digest) != digests_.end()))
+  {
+    return false;
+  }
+
+  // allocate the slot for the layout
+  Slot slot{0};
+  if (free_slots_.empty())
+  {
+    slot = static_cast<Slot>(entries_.size());
+    entries_.emplace_back();
+    masks_.resize(masks_.size() + num_words_, 0);
+  }
+  else
+  {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+  }
+
+  auto &entry    = entries_[slot];
+  entry.layout   = layout;
+  entry.sequence = next_sequence_++;
+
+  // copy the lane mask inline
+  Word *words = &masks_[slot * num_words_];
+  for (std::size_t i = 0; i < num_words_; ++i)
+  {
+    words[i] = (i < mask.blocks()) ? mask(i) : Word{0};
+  }
+
+  // add the layout to the heap of each of the lanes that it uses
+  Item const  item{layout.charge(), entry.sequence, slot};
+  std::size_t num_items{0};
+  for (std::size_t lane = 0; lane < num_lanes_; ++lane)
+  {
+    if ((words[lane / BITS_PER_WORD] >> (lane % BITS_PER_WORD)) & 1u)
+    {
+      heaps_[lane].push_back(item);
+      std::push_heap(heaps_[lane].begin(), heaps_[lane].end());
+      ++num_items;
+    }
+  }
+
+  // layouts which do not use any lanes are kept in a separate heap
+  if (num_items == 0)
+  {
+    heaps_[num_lanes_].push_back(item);
+    std::push_heap(heaps_[num_lanes_].begin(), heaps_[num_lanes_].end());
+    ++num_items;
+  }
+
+  entry.num_items = num_items;
+  heap_items_ += num_items;
+  live_items_ += num_items;
+
+  slot_index_.emplace(digest, slot);
+  digests_.insert(digest);
+
+  return true;
+}
+
+/**
+ * Move the contents of the specified queue into the pool
+ *
+ * After the operation the input queue will be empty
+ *
+ * @param queue The queue to be emptied into the pool
+ */
+void LaneIndexedPool::Splice(TransactionLayoutQueue &queue)
+{
+  auto it = queue.begin();
+  while (it != queue.end())
+  {
+    Add(*it);
+    it = queue.Erase(it);
+  }
+}
+
+/**
+ * Remove a set of transactions from the pool
+ *
+ * @param digests The set of the transaction digests to be removed
+ * @return The number of transaction layouts removed from the pool
+ */
+std::size_t LaneIndexedPool::Remove(DigestSet const &digests)
+{
+  std::size_t count{0};
+
+  for (auto const &digest : digests)
+  {
+    auto const it = slot_index_.find(digest);
+    if (it != slot_index_.end())
+    {
+      Release(it->second);
+      ++count;
+    }
+  }
+
+  CompactIfRequired();
+
+  return count;
+}
+
+/**
+ * Greedily fill a slice with the highest fee transactions which do not collide, removing them from
+ * the pool.
+ *
+ * @param slice The slice to be populated
+ */
+void LaneIndexedPool::GenerateSlice(Slice &slice)
+{
+  std::fill(slice_state_.begin(), slice_state_.end(), Word{0});
+  frontier_.clear();
+  deferred_.clear();
+
+  // seed the frontier with the heads of every lane
+  for (std::size_t lane = 0; lane <= num_lanes_; ++lane)
+  {
+    PushCandidate(lane);
+  }
+
+  std::size_t occupied{0};
+  while (!frontier_.empty() && (occupied < num_lanes_))
+  {
+    std::pop_heap(frontier_.begin(), frontier_.end());
+    Candidate const candidate = frontier_.back();
+    frontier_.pop_back();
+
+    std::size_t const lane = candidate.lane;
+    if (IsOccupied(lane))
+    {
+      continue;
+    }
+
+    // the head of the lane might have been packed or removed via a different lane
+    if (!Prune(lane))
+    {
+      continue;
+    }
+
+    auto &heap = heaps_[lane];
+    if (heap.front().sequence != candidate.item.sequence)
+    {
+      PushCandidate(lane);
+      continue;
+    }
+
+    Item const item = heap.front();
+    std::pop_heap(heap.begin(), heap.end());
+    heap.pop_back();
+    --heap_items_;
+
+    if (Collides(item.slot))
+    {
+      // blocked by another lane in this slice, restored once the slice is complete
+      deferred_.push_back(Candidate{item, lane});
+    }
+    else
+    {
+      Word const *mask = Mask(item.slot);
+      for (std::size_t i = 0; i < num_words_; ++i)
+      {
+        slice_state_[i] |= mask[i];
+        occupied += static_cast<std::size_t>(platform::CountSetBits(mask[i]));
+      }
+
+      slice.push_back(entries_[item.slot].layout);
+
+      // the heap item consumed above no longer references the entry
+      --entries_[item.slot].num_items;
+      --live_items_;
+
+      Release(item.slot);
+    }
+
+    PushCandidate(lane);
+  }
+
+  // restore the blocked items
+  for (auto const &blocked : deferred_)
+  {
+    auto &heap = heaps_[blocked.lane];
+    heap.push_back(blocked.item);
+    std::push_heap(heap.begin(), heap.end());
+    ++heap_items_;
+  }
+
+  CompactIfRequired();
+}
+
+LaneIndexedPool::Word const *LaneIndexedPool::Mask(Slot slot) const
+{
+  return &masks_[slot * num_words_];
+}
+
+bool LaneIndexedPool::IsLive(Item const &item) const
+{
+  return entries_[item.slot].sequence == item.sequence;
+}
+
+bool LaneIndexedPool::IsOccupied(std::size_t lane) const
+{
+  // layouts without lanes are never blocked
+  if (lane == num_lanes_)
+  {
+    return false;
+  }
+
+  return ((slice_state_[lane / BITS_PER_WORD] >> (lane % BITS_PER_WORD)) & 1u) != 0;
+}
+
+bool LaneIndexedPool::Collides(Slot slot) const
+{
+  Word const *mask = Mask(slot);
+  for (std::size_t i = 0; i < num_words_; ++i)
+  {
+    if ((slice_state_[i] & mask[i]) != 0)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Remove all the stale items from the head of the lane heap
+ *
+ * @param lane The lane to be pruned
+ * @return true if the heap still contains items, otherwise false
+ */
+bool LaneIndexedPool::Prune(std::size_t lane)
+{
+  auto &heap = heaps_[lane];
+  while (!heap.empty() && !IsLive(heap.front()))
+  {
+    std::pop_heap(heap.begin(), heap.end());
+    heap.pop_back();
+    --heap_items_;
+  }
+
+  return !heap.empty();
+}
+
+/**
+ * Add the (live) head of the lane heap to the packing frontier, if there is one
+ *
+ * @param lane The lane to be considered
+ */
+void LaneIndexedPool::PushCandidate(std::size_t lane)
+{
+  if (!IsOccupied(lane) && Prune(lane))
+  {
+    frontier_.push_back(Candidate{heaps_[lane].front(), lane});
+    std::push_heap(frontier_.begin(), frontier_.end());
+  }
+}
+
+/**
+ * Release the entry in the specified slot. The items in the lane heaps which reference it become
+ * stale and are removed lazily.
+ *
+ * @param slot The slot to be released
+ */
+void LaneIndexedPool::Release(Slot slot)
+{
+  auto &entry = entries_[slot];
+  assert(entry.sequence != 0);
+
+  auto const &digest = entry.layout.digest();
+  slot_index_.erase(digest);
+  digests_.erase(digest);
+
+  live_items_ -= entry.num_items;
+
+  entry.layout    = TransactionLayout{};
+  entry.sequence  = 0;
+  entry.num_items = 0;
+
+  free_slots_.push_back(slot);
+}
+
+/**
+ * Rebuild the lane heaps once the number of stale items dominates
+ */
+void LaneIndexedPool::CompactIfRequired()
+{
+  std::size_t const stale_items = heap_items_ - live_items_;
+  if ((stale_items < MIN_STALE_ITEMS_BEFORE_COMPACTION) || (stale_items < live_items_))
+  {
+    return;
+  }
+
+  heap_items_ = 0;
+  for (auto &heap : heaps_)
+  {
+    heap.erase(std::remove_if(heap.begin(), heap.end(),
+                              [this](Item const &item) { return !IsLive(item); }),
+               heap.end());
+    std::make_heap(heap.begin(), heap.end());
+
+    heap_items_ += heap.size();
+  }
+
+  assert(heap_items_ == live_items_);
+}
+
+}  // namespace miner
+}  // namespace fetch
@@ -0,0 +1,157 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/digest.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/main_chain.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "miner/annealer_miner.hpp"
+#include "miner/basic_miner.hpp"
+#include "tx_generator.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::DigestSet;
+using fetch::ledger::Block;
+using fetch::ledger::BlockPackerInterface;
+using fetch::ledger::MainChain;
+using fetch::ledger::TransactionLayout;
+using fetch::miner::AnnealerMiner;
+using fetch::miner::BasicMiner;
+
+constexpr uint32_t    LOG2_NUM_LANES = 3;
+constexpr uint32_t    NUM_LANES      = 1u << LOG2_NUM_LANES;
+constexpr std::size_t NUM_SLICES     = 4;
+
+using Layouts = std::vector<TransactionLayout>;
+
+class AnnealerMinerTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    rng_.seed(42);
+    generator_.Seed(42);
+  }
+
+  Layouts GenerateLayouts(std::size_t count)
+  {
+    std::uniform_int_distribution<uint32_t> resources(1, 3);
+    std::uniform_int_distribution<uint64_t> charges(1, 1000);
+
+    Layouts layouts{};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      auto const tx = generator_(resources(rng_));
+      layouts.emplace_back(tx.digest(), tx.mask(), charges(rng_), tx.valid_from(),
+                           tx.valid_until());
+    }
+
+    return layouts;
+  }
+
+  static uint64_t PackBlock(BlockPackerInterface &packer, Layouts const &layouts, Block &block,
+                            std::size_t num_slices = NUM_SLICES)
+  {
+    MainChain chain{false, MainChain::Mode::IN_MEMORY_DB};
+
+    for (auto const &layout : layouts)
+    {
+      packer.EnqueueTransaction(layout);
+    }
+
+    block.body.previous_hash = chain.GetHeaviestBlockHash();
+    packer.GenerateBlock(block, NUM_LANES, num_slices, chain);
+
+    uint64_t fee{0};
+    for (auto const &slice : block.body.slices)
+    {
+      for (auto const &layout : slice)
+      {
+        fee += layout.charge();
+      }
+    }
+
+    return fee;
+  }
+
+  std::mt19937_64      rng_{};
+  TransactionGenerator generator_{LOG2_NUM_LANES};
+};
+
+TEST_F(AnnealerMinerTests, CheckSlicesAreValid)
+{
+  auto const layouts = GenerateLayouts(200);
+
+  AnnealerMiner miner{LOG2_NUM_LANES, std::chrono::milliseconds{20}, 2};
+
+  Block block{};
+  PackBlock(miner, layouts, block);
+
+  ASSERT_EQ(block.body.slices.size(), NUM_SLICES);
+
+  DigestSet packed{};
+  for (auto const &slice : block.body.slices)
+  {
+    EXPECT_FALSE(slice.empty());
+
+    BitVector lanes{NUM_LANES};
+    for (auto const &layout : slice)
+    {
+      // no lane can be used twice in the same slice
+      BitVector const collisions = lanes & layout.mask();
+      EXPECT_EQ(collisions.PopCount(), 0);
+      lanes |= layout.mask();
+
+      // no transaction can be packed twice
+      EXPECT_TRUE(packed.insert(layout.digest()).second);
+    }
+  }
+
+  EXPECT_EQ(miner.GetBacklog(), layouts.size() - packed.size());
+}
+
+TEST_F(AnnealerMinerTests, CheckSliceFeeIsAtLeastGreedy)
+{
+  auto const layouts = GenerateLayouts(100);
+
+  // with a single batch covering the whole pool the greedy packing is always a candidate for the
+  // slice (the slices are optimised in turn, so this does not hold for the block as a whole)
+  BasicMiner    basic{LOG2_NUM_LANES};
+  AnnealerMiner annealer{LOG2_NUM_LANES, std::chrono::milliseconds{20}, 2, layouts.size()};
+
+  Block basic_block{};
+  Block annealer_block{};
+
+  uint64_t const basic_fee    = PackBlock(basic, layouts, basic_block, 1);
+  uint64_t const annealer_fee = PackBlock(annealer, layouts, annealer_block, 1);
+
+  EXPECT_GE(annealer_fee, basic_fee);
+}
+
+}  // namespace
@@ -0,0 +1,177 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "miner/optimisation/binary_annealer.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using fetch::optimisers::BinaryAnnealer;
+
+using Cost      = BinaryAnnealer::CostType;
+using State     = BinaryAnnealer::StateType;
+using Charges   = std::vector<uint64_t>;
+using Conflicts = std::vector<std::pair<std::size_t, std::size_t>>;
+
+constexpr std::size_t NUM_SLICES = 8;
+constexpr std::size_t SWEEPS     = 100;
+constexpr uint64_t    SEED       = 7;
+
+struct Problem
+{
+  Charges   charges{};
+  Conflicts conflicts{};
+};
+
+class BinaryAnnealerTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    rng_.seed(42);
+  }
+
+  Problem GenerateProblem()
+  {
+    std::uniform_int_distribution<std::size_t> sizes(20, 100);
+    std::uniform_int_distribution<uint64_t>    charges(1, 1000);
+    std::bernoulli_distribution                conflict(0.1);
+
+    Problem problem{};
+
+    std::size_t const size = sizes(rng_);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      problem.charges.push_back(charges(rng_));
+
+      for (std::size_t j = 0; j < i; ++j)
+      {
+        if (conflict(rng_))
+        {
+          problem.conflicts.emplace_back(j, i);
+        }
+      }
+    }
+
+    return problem;
+  }
+
+  // programs the annealer in the same way as the annealer miner programs a slice
+  static void Program(BinaryAnnealer &annealer, Problem const &problem)
+  {
+    uint64_t const max_charge = *std::max_element(problem.charges.begin(), problem.charges.end());
+    Cost const     penalty    = 2.0 * (static_cast<Cost>(max_charge) + 1.0);
+
+    annealer.Resize(problem.charges.size());
+
+    for (std::size_t i = 0; i < problem.charges.size(); ++i)
+    {
+      annealer.Insert(i, i, -static_cast<Cost>(problem.charges[i]));
+    }
+
+    for (auto const &conflict : problem.conflicts)
+    {
+      annealer.Insert(conflict.first, conflict.second, penalty);
+    }
+
+    annealer.Normalise();
+  }
+
+  static void Configure(BinaryAnnealer &annealer)
+  {
+    annealer.SetSweeps(SWEEPS);
+    annealer.SetBetaStart(0.1);
+    annealer.SetBetaEnd(3.0);
+  }
+
+  std::mt19937_64 rng_{};
+};
+
+TEST_F(BinaryAnnealerTests, CheckReusedAnnealerMatchesFreshAnnealer)
+{
+  BinaryAnnealer reused{};
+  Configure(reused);
+
+  for (std::size_t slice = 0; slice < NUM_SLICES; ++slice)
+  {
+    auto const problem = GenerateProblem();
+
+    BinaryAnnealer fresh{};
+    Configure(fresh);
+
+    Program(reused, problem);
+    Program(fresh, problem);
+
+    // with the same random sequence the schedules (and so the results) must be identical
+    reused.SetSeed(SEED);
+    fresh.SetSeed(SEED);
+
+    State      reused_state{};
+    State      fresh_state{};
+    Cost const reused_energy = reused.FindMinimum(reused_state);
+    Cost const fresh_energy  = fresh.FindMinimum(fresh_state);
+
+    EXPECT_TRUE(std::isfinite(reused_energy));
+    EXPECT_EQ(reused_state, fresh_state);
+    EXPECT_DOUBLE_EQ(reused_energy, fresh_energy);
+  }
+}
+
+TEST_F(BinaryAnnealerTests, CheckEnergyIsInProblemUnits)
+{
+  BinaryAnnealer annealer{};
+  Configure(annealer);
+
+  for (std::size_t slice = 0; slice < NUM_SLICES; ++slice)
+  {
+    auto const problem = GenerateProblem();
+
+    Program(annealer, problem);
+
+    State      state{};
+    Cost const energy = annealer.FindMinimum(state);
+
+    // recompute the cost of the state directly from the problem
+    uint64_t const max_charge = *std::max_element(problem.charges.begin(), problem.charges.end());
+    Cost const     penalty    = 2.0 * (static_cast<Cost>(max_charge) + 1.0);
+
+    Cost expected{0};
+    for (std::size_t i = 0; i < problem.charges.size(); ++i)
+    {
+      expected -= static_cast<Cost>(state[i]) * static_cast<Cost>(problem.charges[i]);
+    }
+
+    for (auto const &conflict : problem.conflicts)
+    {
+      expected += static_cast<Cost>(state[conflict.first] * state[conflict.second]) * penalty;
+    }
+
+    EXPECT_NEAR(energy, expected, 1e-6 * std::max(1.0, std::fabs(expected)));
+  }
+}
+
+}  // namespace
@@ -0,0 +1,230 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/digest.hpp"
+#include "core/random/lcg.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "miner/lane_indexed_pool.hpp"
+#include "miner/transaction_layout_queue.hpp"
+#include "tx_generator.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::DigestSet;
+using fetch::ledger::Block;
+using fetch::ledger::TransactionLayout;
+using fetch::miner::LaneIndexedPool;
+using fetch::miner::TransactionLayoutQueue;
+using fetch::random::LinearCongruentialGenerator;
+
+constexpr uint32_t LOG2_NUM_LANES = 4;
+constexpr uint32_t NUM_LANES      = 1u << LOG2_NUM_LANES;
+
+using Layouts = std::vector<TransactionLayout>;
+using Slice   = Block::Slice;
+using Slices  = std::vector<Slice>;
+
+/**
+ * The reference packing algorithm: scan the whole pool in fee order, packing every transaction
+ * which does not collide with those already in the slice until the slice is full
+ */
+Slices ReferencePacking(Layouts const &layouts, std::size_t num_slices)
+{
+  std::list<TransactionLayout> pool(layouts.begin(), layouts.end());
+  pool.sort([](TransactionLayout const &a, TransactionLayout const &b) {
+    return a.charge() > b.charge();
+  });
+
+  Slices slices(num_slices);
+  for (auto &slice : slices)
+  {
+    BitVector slice_state{NUM_LANES};
+
+    auto it = pool.begin();
+    while ((it != pool.end()) && (slice_state.PopCount() < NUM_LANES))
+    {
+      BitVector collisions{slice_state};
+      collisions &= it->mask();
+
+      if (collisions.PopCount() == 0)
+      {
+        slice_state |= it->mask();
+        slice.push_back(*it);
+        it = pool.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  return slices;
+}
+
+class LaneIndexedPoolTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    generator_.Seed();
+    rng_.Seed(42);
+  }
+
+  Layouts GenerateLayouts(std::size_t count, uint64_t max_charge)
+  {
+    Layouts layouts{};
+    layouts.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      // between 0 and 3 resources, with a small range of charges to exercise the tie breaking
+      auto const tx     = generator_(static_cast<uint32_t>(rng_() % 4u));
+      auto const charge = 1u + (rng_() % max_charge);
+
+      layouts.emplace_back(tx.digest(), tx.mask(), charge, tx.valid_from(), tx.valid_until());
+    }
+
+    return layouts;
+  }
+
+  TransactionGenerator        generator_{LOG2_NUM_LANES};
+  LinearCongruentialGenerator rng_{};
+  LaneIndexedPool             pool_{NUM_LANES};
+};
+
+TEST_F(LaneIndexedPoolTests, CheckDuplicatesAreRejected)
+{
+  auto const tx1 = generator_(2);
+  auto const tx2 = generator_(1);
+
+  EXPECT_TRUE(pool_.Add(tx1));
+  EXPECT_TRUE(pool_.Add(tx2));
+  EXPECT_FALSE(pool_.Add(tx1));
+  EXPECT_EQ(pool_.size(), 2);
+
+  // layouts with the incorrect number of lanes are also rejected
+  EXPECT_FALSE(pool_.Add(TransactionLayout{tx1.digest(), BitVector{NUM_LANES * 2}, 1, 0, 100}));
+  EXPECT_EQ(pool_.size(), 2);
+}
+
+TEST_F(LaneIndexedPoolTests, CheckSpliceEmptiesQueue)
+{
+  TransactionLayoutQueue queue{};
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    queue.Add(generator_(2));
+  }
+
+  pool_.Splice(queue);
+
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(pool_.size(), 10);
+}
+
+TEST_F(LaneIndexedPoolTests, CheckRemovedLayoutsAreNotPacked)
+{
+  auto const layouts = GenerateLayouts(200, 1000);
+
+  DigestSet removed{};
+  for (std::size_t i = 0; i < layouts.size(); ++i)
+  {
+    ASSERT_TRUE(pool_.Add(layouts[i]));
+
+    if ((i % 3) == 0)
+    {
+      removed.insert(layouts[i].digest());
+    }
+  }
+
+  EXPECT_EQ(pool_.Remove(removed), removed.size());
+  EXPECT_EQ(pool_.size(), layouts.size() - removed.size());
+
+  // removing a second time has no effect
+  EXPECT_EQ(pool_.Remove(removed), 0);
+
+  std::size_t packed{0};
+  while (!pool_.empty())
+  {
+    Slice slice{};
+    pool_.GenerateSlice(slice);
+    ASSERT_FALSE(slice.empty());
+
+    for (auto const &layout : slice)
+    {
+      EXPECT_EQ(removed.find(layout.digest()), removed.end());
+      ++packed;
+    }
+  }
+
+  EXPECT_EQ(packed, layouts.size() - removed.size());
+}
+
+TEST_F(LaneIndexedPoolTests, CheckPackingMatchesReference)
+{
+  static constexpr std::size_t NUM_SLICES = 8;
+
+  for (uint64_t max_charge : {3u, 1000u})
+  {
+    auto const layouts  = GenerateLayouts(1000, max_charge);
+    auto const expected = ReferencePacking(layouts, NUM_SLICES);
+
+    LaneIndexedPool pool{NUM_LANES};
+    for (auto const &layout : layouts)
+    {
+      ASSERT_TRUE(pool.Add(layout));
+    }
+
+    std::size_t packed{0};
+    for (auto const &expected_slice : expected)
+    {
+      Slice slice{};
+      pool.GenerateSlice(slice);
+
+      // the packing order may differ, but the contents of the slice must be identical
+      DigestSet expected_digests{};
+      for (auto const &layout : expected_slice)
+      {
+        expected_digests.insert(layout.digest());
+      }
+
+      DigestSet actual_digests{};
+      for (auto const &layout : slice)
+      {
+        actual_digests.insert(layout.digest());
+      }
+
+      EXPECT_EQ(actual_digests, expected_digests);
+      packed += slice.size();
+    }
+
+    EXPECT_EQ(pool.size(), layouts.size() - packed);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "dispatcher.hpp"
+#include "muddle_register.hpp"
+#include "router.hpp"
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "crypto/ecdsa.hpp"
+#include "muddle/network_id.hpp"
+#include "muddle/packet.hpp"
+#include "muddle/subscription.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::ECDSASigner;
+using fetch::muddle::Dispatcher;
+using fetch::muddle::MuddleRegister;
+using fetch::muddle::NetworkId;
+using fetch::muddle::Packet;
+using fetch::muddle::Router;
+
+namespace {
+
+using PacketPtr       = Router::PacketPtr;
+using PacketList      = std::vector<PacketPtr>;
+using SignerPtr       = std::unique_ptr<ECDSASigner>;
+using SubscriptionPtr = Router::SubscriptionPtr;
+using Subscriptions   = std::vector<SubscriptionPtr>;
+
+constexpr uint16_t    SERVICE              = 1;
+constexpr uint8_t     TTL                  = 40;
+constexpr std::size_t PACKETS_PER_CHANNEL  = 32;
+constexpr std::size_t PAYLOAD_LENGTH       = 256;
+constexpr char const *BENCHMARK_NETWORK_ID = "Test";
+
+SignerPtr CreateSigner()
+{
+  auto signer = std::make_unique<ECDSASigner>();
+  signer->GenerateKeys();
+
+  return signer;
+}
+
+/**
+ * Stress the router dispatch with signed packets from a number of senders over a number of
+ * channels, all addressed to the router under test.
+ *
+ * Arguments: number of senders, number of channels
+ */
+void Router_DispatchSignedPackets(benchmark::State &state)
+{
+  auto const num_senders  = static_cast<std::size_t>(state.range(0));
+  auto const num_channels = static_cast<std::size_t>(state.range(1));
+
+  NetworkId const network_id{BENCHMARK_NETWORK_ID};
+
+  auto const     identity = CreateSigner();
+  auto const     address  = identity->identity().identifier();
+  MuddleRegister reg{network_id};
+  Dispatcher     dispatcher{network_id, address};
+  Router         router{network_id, address, reg, dispatcher, identity.get()};
+
+  // subscribe to all the channels counting the messages received
+  std::atomic<std::size_t> received{0};
+  Subscriptions            subscriptions{};
+  for (std::size_t channel = 0; channel < num_channels; ++channel)
+  {
+    auto subscription = router.Subscribe(SERVICE, static_cast<uint16_t>(channel));
+    subscription->SetMessageHandler(
+        [&received](Packet::Address const &, ConstByteArray const &) { ++received; });
+
+    subscriptions.emplace_back(std::move(subscription));
+  }
+
+  // generate the signed packets
+  ConstByteArray const payload{std::string(PAYLOAD_LENGTH, 'x')};
+
+  PacketList packets{};
+  for (std::size_t sender = 0; sender < num_senders; ++sender)
+  {
+    auto const signer = CreateSigner();
+
+    for (std::size_t channel = 0; channel < num_channels; ++channel)
+    {
+      for (std::size_t i = 0; i < PACKETS_PER_CHANNEL; ++i)
+      {
+        auto packet = std::make_shared<Packet>(signer->identity().identifier(), network_id.value());
+        packet->SetService(SERVICE);
+        packet->SetChannel(static_cast<uint16_t>(channel));
+        packet->SetMessageNum(static_cast<uint16_t>(i));
+        packet->SetTTL(TTL);
+        packet->SetPayload(payload);
+        packet->SetTarget(address);
+        packet->Sign(*signer);
+
+        packets.emplace_back(std::move(packet));
+      }
+    }
+  }
+
+  router.Start();
+
+  for (auto _ : state)
+  {
+    received = 0;
+
+    for (auto const &packet : packets)
+    {
+      router.Route(1, packet);
+    }
+
+    // wait for all the packets to be dispatched
+    while (received < packets.size())
+    {
+      std::this_thread::sleep_for(std::chrono::microseconds{50});
+    }
+  }
+
+  router.Stop();
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(packets.size()));
+}
+
+}  // namespace
+
+BENCHMARK(Router_DispatchSignedPackets)
+    ->Args({1, 1})
+    ->Args({1, 8})
+    ->Args({8, 1})
+    ->Args({8, 8})
+    ->Args({32, 4})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,78 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "muddle/packet.hpp"
+#include "network/management/abstract_connection.hpp"
+
+#include <array>
+#include <cstddef>
+#include <map>
+
+namespace fetch {
+namespace muddle {
+
+/**
+ * Kademlia style routing table of the directly connected peers of a node.
+ *
+ * Peers are placed into buckets based on their (logarithmic) XOR distance from the address of the
+ * node. Within a bucket the peers are kept in address order, which means that the peer sharing the
+ * longest prefix with a target address is always adjacent to the target's position in the bucket.
+ * This allows the closest peer to any address to be found in logarithmic time.
+ *
+ * Since the table only contains peers that the node is directly connected to (which are already
+ * bounded by the peer selection) the buckets are not capped.
+ *
+ * The table is not thread safe, the owner is responsible for locking.
+ */
+class KademliaTable
+{
+public:
+  using RawAddress = Packet::RawAddress;
+  using Handle     = network::AbstractConnection::ConnectionHandleType;
+
+  static constexpr std::size_t ADDRESS_BITS = Packet::ADDRESS_SIZE * 8;
+
+  // Construction / Destruction
+  explicit KademliaTable(RawAddress const &own_address);
+  KademliaTable(KademliaTable const &) = delete;
+  KademliaTable(KademliaTable &&)      = delete;
+  ~KademliaTable()                     = default;
+
+  void        Update(RawAddress const &address, Handle handle);
+  bool        Remove(RawAddress const &address);
+  Handle      FindClosest(RawAddress const &address) const;
+  std::size_t size() const;
+
+  // Operators
+  KademliaTable &operator=(KademliaTable const &) = delete;
+  KademliaTable &operator=(KademliaTable &&) = delete;
+
+private:
+  using Bucket  = std::map<RawAddress, Handle>;
+  using Buckets = std::array<Bucket, ADDRESS_BITS + 1>;
+
+  std::size_t BucketIndex(RawAddress const &address) const;
+
+  RawAddress const own_address_;
+  Buckets          buckets_{};  ///< Peers indexed by their log distance from this node
+  std::size_t      size_{0};
+};
+
+}  // namespace muddle
+}  // namespace fetch
@@ -18,6 +18,7 @@
 //------------------------------------------------------------------------------
 
 #include "blacklist.hpp"
+#include "kademlia_table.hpp"
 #include "subscription_registrar.hpp"
 
 #include "core/mutex.hpp"
@@ -27,6 +28,7 @@
 #include "muddle/packet.hpp"
 #include "network/details/thread_pool.hpp"
 #include "network/management/abstract_connection.hpp"
+#include "telemetry/telemetry.hpp"
 
 #include <chrono>
 #include <cstddef>
@@ -35,6 +37,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace fetch {
 namespace muddle {
@@ -154,19 +157,33 @@ private:
     UPDATED
   };
 
-  static constexpr std::size_t NUMBER_OF_ROUTER_THREADS = 1;
+  /**
+   * Each dispatch shard is serviced by a single thread. Packets are assigned to a shard based on
+   * their sender, service and channel so that the ordering of messages within a channel is
+   * preserved while different peers and services are dispatched in parallel.
+   */
+  struct DispatchShard
+  {
+    ThreadPool                    thread_pool;
+    telemetry::GaugePtr<uint64_t> queue_depth;
+  };
+
+  using DispatchShards = std::vector<DispatchShard>;
+
+  static constexpr std::size_t NUMBER_OF_ROUTER_THREADS = 4;
 
   UpdateStatus AssociateHandleWithAddress(Handle handle, Packet::RawAddress const &address,
                                           bool direct, bool broadcast);
 
   Handle LookupRandomHandle(Packet::RawAddress const &address) const;
-  Handle LookupKademliaClosestHandle(Address const &address) const;
+  Handle LookupKademliaClosestHandle(Packet::RawAddress const &address) const;
 
   void SendToConnection(Handle handle, PacketPtr const &packet);
   void RoutePacket(PacketPtr const &packet, bool external = true);
   void DispatchDirect(Handle handle, PacketPtr packet);
 
-  void DispatchPacket(PacketPtr const &packet, Address const &transmitter);
+  void DispatchPacket(PacketPtr const &packet, Address const &transmitter, bool verify = false);
+  void DispatchPacketOnShard(PacketPtr const &packet, Address const &transmitter, bool verify);
 
   bool IsEcho(Packet const &packet, bool register_echo = true);
   void CleanEchoCache();
@@ -190,11 +207,12 @@ private:
 
   mutable Mutex routing_table_lock_;
   RoutingTable  routing_table_;  ///< The map routing table from address to handle (Protected by
+  KademliaTable kademlia_table_;  ///< Direct peers by distance (Protected by routing_table_lock_)
 
   mutable Mutex echo_cache_lock_;
   EchoCache     echo_cache_;
 
-  ThreadPool dispatch_thread_pool_;
+  DispatchShards dispatch_shards_;
 
   friend class DirectMessageService;
 };
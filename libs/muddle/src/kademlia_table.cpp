@@ -0,0 +1,147 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "kademlia_table.hpp"
+#include "xor_metric.hpp"
+
+#include <cstddef>
+#include <iterator>
+
+namespace fetch {
+namespace muddle {
+
+KademliaTable::KademliaTable(RawAddress const &own_address)
+  : own_address_{own_address}
+{}
+
+/**
+ * Add or update the handle of a directly connected peer
+ *
+ * @param address The address of the peer
+ * @param handle The handle of the connection to the peer
+ */
+void KademliaTable::Update(RawAddress const &address, Handle handle)
+{
+  // the node never routes to itself
+  if (address == own_address_)
+  {
+    return;
+  }
+
+  auto &bucket = buckets_[BucketIndex(address)];
+
+  auto const result = bucket.emplace(address, handle);
+  if (result.second)
+  {
+    ++size_;
+  }
+  else
+  {
+    result.first->second = handle;
+  }
+}
+
+/**
+ * Remove a peer from the table
+ *
+ * @param address The address of the peer
+ * @return true if the peer was present, otherwise false
+ */
+bool KademliaTable::Remove(RawAddress const &address)
+{
+  if (buckets_[BucketIndex(address)].erase(address) == 0)
+  {
+    return false;
+  }
+
+  --size_;
+  return true;
+}
+
+/**
+ * Find the handle of the directly connected peer which is closest to the specified address
+ *
+ * @param address The target address
+ * @return The handle of the closest peer, or zero if the table is empty
+ */
+KademliaTable::Handle KademliaTable::FindClosest(RawAddress const &address) const
+{
+  if (size_ == 0)
+  {
+    return 0;
+  }
+
+  std::size_t const index = BucketIndex(address);
+
+  // The peers in the same bucket as the target share a longer prefix with it than with this node.
+  // They are the closest candidates, and the best of them is adjacent to the target in address
+  // order
+  auto const &bucket = buckets_[index];
+  if (!bucket.empty())
+  {
+    auto it = bucket.lower_bound(address);
+    if (it == bucket.end())
+    {
+      return std::prev(it)->second;
+    }
+
+    if (it != bucket.begin())
+    {
+      auto const prev = std::prev(it);
+      if (CalculateDistance(prev->first, address) < CalculateDistance(it->first, address))
+      {
+        return prev->second;
+      }
+    }
+
+    return it->second;
+  }
+
+  // The peers in the closer buckets are all exactly the same distance from the target as this
+  // node, whereas the peers in the further buckets are further away in proportion to the bucket
+  for (std::size_t i = 0; i < index; ++i)
+  {
+    if (!buckets_[i].empty())
+    {
+      return buckets_[i].begin()->second;
+    }
+  }
+
+  for (std::size_t i = index + 1; i < buckets_.size(); ++i)
+  {
+    if (!buckets_[i].empty())
+    {
+      return buckets_[i].begin()->second;
+    }
+  }
+
+  return 0;
+}
+
+std::size_t KademliaTable::size() const
+{
+  return size_;
+}
+
+std::size_t KademliaTable::BucketIndex(RawAddress const &address) const
+{
+  return static_cast<std::size_t>(CalculateDistance(own_address_, address));
+}
+
+}  // namespace muddle
+}  // namespace fetch
@@ -21,7 +21,6 @@
 #include "muddle_register.hpp"
 #include "router.hpp"
 #include "routing_message.hpp"
-#include "xor_metric.hpp"
 
 #include "core/byte_array/encoders.hpp"
 #include "core/containers/set_intersection.hpp"
@@ -31,6 +30,8 @@
 #include "core/service_ids.hpp"
 #include "crypto/fnv.hpp"
 #include "muddle/packet.hpp"
+#include "telemetry/gauge.hpp"
+#include "telemetry/registry.hpp"
 
 #include <algorithm>
 #include <array>
@@ -43,6 +44,7 @@
 #include <random>
 #include <sstream>
 #include <stdexcept>
+#include <string>
 #include <utility>
 
 static constexpr uint8_t DEFAULT_TTL = 40;
@@ -50,6 +52,7 @@ static constexpr uint8_t DEFAULT_TTL = 40;
 using fetch::byte_array::ByteArray;
 using fetch::byte_array::ConstByteArray;
 using fetch::byte_array::ToBase64;
+using fetch::telemetry::Registry;
 
 namespace fetch {
 namespace muddle {
@@ -86,6 +89,34 @@ std::size_t GenerateEchoId(Packet const &packet)
   return out;
 }
 
+/**
+ * Generate the key used to assign a packet to one of the dispatch shards. Packets from the same
+ * sender on the same service and channel always map to the same key.
+ *
+ * @param packet The input packet to generate the key for
+ * @return The dispatch key
+ */
+std::size_t GenerateDispatchKey(Packet const &packet)
+{
+  crypto::FNV hash;
+  hash.Reset();
+
+  auto const service = packet.GetService();
+  auto const channel = packet.GetChannel();
+
+  hash.Update(packet.GetSenderRaw().data(), packet.GetSenderRaw().size());
+  hash.Update(reinterpret_cast<uint8_t const *>(&service), sizeof(service));
+  hash.Update(reinterpret_cast<uint8_t const *>(&channel), sizeof(channel));
+
+  std::size_t out = 0;
+
+  static_assert(sizeof(out) == decltype(hash)::size_in_bytes,
+                "Output type has incorrect size to contain hash");
+  hash.Final(reinterpret_cast<uint8_t *>(&out));
+
+  return out;
+}
+
 /**
  * Internal; Function used to compare two fixed size addresses
  *
@@ -236,23 +267,44 @@ Router::Router(NetworkId network_id, Address address, MuddleRegister &reg, Dispa
   , network_id_(network_id)
   , prover_(prover)
   , sign_broadcasts_((prover != nullptr) && sign_broadcasts)
-  , dispatch_thread_pool_(network::MakeThreadPool(NUMBER_OF_ROUTER_THREADS, "Router"))
-{}
+  , kademlia_table_(address_raw_)
+{
+  dispatch_shards_.reserve(NUMBER_OF_ROUTER_THREADS);
+  for (std::size_t i = 0; i < NUMBER_OF_ROUTER_THREADS; ++i)
+  {
+    DispatchShard shard{};
+    shard.thread_pool = network::MakeThreadPool(1, "Router-" + std::to_string(i));
+    shard.queue_depth = Registry::Instance().CreateGauge<uint64_t>(
+        "ledger_muddle_router_dispatch_queue_depth",
+        "The number of packets waiting to be dispatched on a router shard",
+        {{"network_id", network_id_.ToString()},
+         {"address", static_cast<std::string>(address_.ToBase64())},
+         {"shard", std::to_string(i)}});
+
+    dispatch_shards_.emplace_back(std::move(shard));
+  }
+}
 
 /**
- * Starts the routers internal dispatch thread pool
+ * Starts the routers internal dispatch thread pools
  */
 void Router::Start()
 {
-  dispatch_thread_pool_->Start();
+  for (auto &shard : dispatch_shards_)
+  {
+    shard.thread_pool->Start();
+  }
 }
 
 /**
- * Stops the routers internal dispatch thread pool
+ * Stops the routers internal dispatch thread pools
  */
 void Router::Stop()
 {
-  dispatch_thread_pool_->Stop();
+  for (auto &shard : dispatch_shards_)
+  {
+    shard.thread_pool->Stop();
+  }
 }
 
 bool Router::Genuine(PacketPtr const &p) const
@@ -298,21 +350,26 @@ void Router::Route(Handle handle, PacketPtr const &packet)
     return;
   }
 
-  if (!Genuine(packet))
+  bool const is_direct = packet->IsDirect();
+  bool const is_local  = !is_direct && (packet->GetTargetRaw() == address_);
+
+  // packets addressed to this node are verified on their dispatch shard, all others must be
+  // verified before they are handled or routed any further
+  if (!is_local && !Genuine(packet))
   {
     FETCH_LOG_WARN(logging_name_, "Packet's authenticity not verified:", DescribePacket(*packet));
     return;
   }
 
-  if (packet->IsDirect())
+  if (is_direct)
   {
     // when it is a direct message we must handle this
     DispatchDirect(handle, packet);
   }
-  else if (packet->GetTargetRaw() == address_)
+  else if (is_local)
   {
     // we do not care about the transmitter, since this was an addition for the trust system.
-    DispatchPacket(packet, packet->GetSender());
+    DispatchPacket(packet, packet->GetSender(), true);
   }
   else
   {
@@ -334,6 +391,7 @@ void Router::ConnectionDropped(Handle handle)
   {
     if (it->second.handle == handle)
     {
+      kademlia_table_.Remove(it->first);
       it = routing_table_.erase(it);
     }
     else
@@ -597,6 +655,16 @@ Router::UpdateStatus Router::AssociateHandleWithAddress(Handle
       FETCH_LOG_TRACE(logging_name_, "Handle was: ", prev_handle, " now: ", handle,
                       " direct: ", direct, "-", routing_data.direct);
       FETCH_LOG_VARIABLE(prev_handle);
+
+      // only direct peers can be used as the next hop for kademlia routing
+      if (routing_data.direct)
+      {
+        kademlia_table_.Update(address, handle);
+      }
+      else
+      {
+        kademlia_table_.Remove(address);
+      }
     }
   }
 
@@ -676,34 +744,13 @@ Router::Handle Router::LookupRandomHandle(Packet::RawAddress const & /*address*/
 /**
  * Lookup the closest directly connected handle to route the packet to
  *
- * @param address The address
- * @return
+ * @param address The target address
+ * @return The handle of the closest peer, or zero if there are no direct peers
  */
-Router::Handle Router::LookupKademliaClosestHandle(Address const &address) const
+Router::Handle Router::LookupKademliaClosestHandle(Packet::RawAddress const &address) const
 {
-  Handle handle{0};
-
-  auto const directly_connected = GetDirectlyConnectedPeerSet();
-  if (!directly_connected.empty())
-  {
-    auto it   = directly_connected.begin();
-    auto node = *it++;
-
-    uint64_t best_distance = CalculateDistance(address, node);
-    for (; it != directly_connected.end(); ++it)
-    {
-      uint64_t const distance = CalculateDistance(address, *it);
-
-      if (distance < best_distance)
-      {
-        node = *it;
-      }
-    }
-
-    handle = LookupHandle(ConvertAddress(node));
-  }
-
-  return handle;
+  FETCH_LOCK(routing_table_lock_);
+  return kademlia_table_.FindClosest(address);
 }
 
 /**
@@ -823,7 +870,7 @@ void Router::RoutePacket(PacketPtr const &packet, bool external)
     // if kad routing is enabled we should use this to route packets
     if (kademlia_routing_)
     {
-      handle = LookupKademliaClosestHandle(packet->GetTarget());
+      handle = LookupKademliaClosestHandle(packet->GetTargetRaw());
       if (handle != 0u)
       {
         SendToConnection(handle, packet);
@@ -863,30 +910,55 @@ void Router::DispatchDirect(Handle handle, PacketPtr packet)
  * Dispatch / Handle a normally (routed) packet
  *
  * @param packet The packet that was received
+ * @param transmitter The address of the node which transmitted the packet
+ * @param verify Flag to signal that the authenticity of the packet has not yet been checked
  */
-void Router::DispatchPacket(PacketPtr const &packet, Address const &transmitter)
+void Router::DispatchPacket(PacketPtr const &packet, Address const &transmitter, bool verify)
 {
-  dispatch_thread_pool_->Post([this, packet, transmitter]() {
-    bool const isPossibleExchangeResponse = !packet->IsExchange();
+  auto &shard = dispatch_shards_[GenerateDispatchKey(*packet) % dispatch_shards_.size()];
 
-    // determine if this was an exchange based node
-    if (isPossibleExchangeResponse && dispatcher_.Dispatch(packet))
-    {
-      // the dispatcher has "claimed" this packet as there was an outstanding promise waiting for it
-      return;
-    }
+  shard.queue_depth->increment();
+  shard.thread_pool->Post([this, &shard, packet, transmitter, verify]() {
+    DispatchPacketOnShard(packet, transmitter, verify);
+    shard.queue_depth->decrement();
+  });
+}
 
-    // If no exchange message has claimed this then attempt to dispatch it through our normal system
-    // of message subscriptions.
-    if (registrar_.Dispatch(packet, transmitter))
-    {
-      return;
-    }
+/**
+ * Internal: Handle a routed packet on the dispatch shard thread
+ *
+ * @param packet The packet that was received
+ * @param transmitter The address of the node which transmitted the packet
+ * @param verify Flag to signal that the authenticity of the packet has not yet been checked
+ */
+void Router::DispatchPacketOnShard(PacketPtr const &packet, Address const &transmitter,
+                                   bool verify)
+{
+  if (verify && !Genuine(packet))
+  {
+    FETCH_LOG_WARN(logging_name_, "Packet's authenticity not verified:", DescribePacket(*packet));
+    return;
+  }
 
-    FETCH_LOG_WARN(logging_name_,
-                   "Unable to locate handler for routed message. Net: ", packet->GetNetworkId(),
-                   " Service: ", packet->GetService(), " Channel: ", packet->GetChannel());
-  });
+  bool const isPossibleExchangeResponse = !packet->IsExchange();
+
+  // determine if this was an exchange based node
+  if (isPossibleExchangeResponse && dispatcher_.Dispatch(packet))
+  {
+    // the dispatcher has "claimed" this packet as there was an outstanding promise waiting for it
+    return;
+  }
+
+  // If no exchange message has claimed this then attempt to dispatch it through our normal system
+  // of message subscriptions.
+  if (registrar_.Dispatch(packet, transmitter))
+  {
+    return;
+  }
+
+  FETCH_LOG_WARN(logging_name_,
+                 "Unable to locate handler for routed message. Net: ", packet->GetNetworkId(),
+                 " Service: ", packet->GetService(), " Channel: ", packet->GetChannel());
 }
 
 /**
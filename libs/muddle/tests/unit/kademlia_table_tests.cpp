@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "kademlia_table.hpp"
+#include "xor_metric.hpp"
+
+#include "core/random/lcg.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+using fetch::muddle::CalculateDistance;
+using fetch::muddle::KademliaTable;
+using fetch::random::LinearCongruentialGenerator;
+
+using RawAddress = KademliaTable::RawAddress;
+using Handle     = KademliaTable::Handle;
+using Addresses  = std::vector<RawAddress>;
+
+RawAddress GenerateAddress(LinearCongruentialGenerator &rng)
+{
+  RawAddress address{};
+  for (auto &byte : address)
+  {
+    byte = static_cast<uint8_t>(rng() >> 56u);
+  }
+
+  return address;
+}
+
+Handle FindClosestByScan(Addresses const &peers, RawAddress const &target)
+{
+  Handle   best_handle{0};
+  uint64_t best_distance = std::numeric_limits<uint64_t>::max();
+
+  for (std::size_t i = 0; i < peers.size(); ++i)
+  {
+    uint64_t const distance = CalculateDistance(peers[i], target);
+    if (distance < best_distance)
+    {
+      best_distance = distance;
+      best_handle   = static_cast<Handle>(i + 1);
+    }
+  }
+
+  return best_handle;
+}
+
+TEST(KademliaTableTests, CheckEmptyTable)
+{
+  LinearCongruentialGenerator rng;
+
+  KademliaTable table{GenerateAddress(rng)};
+  EXPECT_EQ(0u, table.size());
+  EXPECT_EQ(0u, table.FindClosest(GenerateAddress(rng)));
+}
+
+TEST(KademliaTableTests, CheckOwnAddressIsNeverAdded)
+{
+  LinearCongruentialGenerator rng;
+
+  auto const    own_address = GenerateAddress(rng);
+  KademliaTable table{own_address};
+
+  table.Update(own_address, 1);
+  EXPECT_EQ(0u, table.size());
+}
+
+TEST(KademliaTableTests, CheckUpdateAndRemove)
+{
+  LinearCongruentialGenerator rng;
+
+  KademliaTable table{GenerateAddress(rng)};
+
+  auto const peer = GenerateAddress(rng);
+
+  table.Update(peer, 1);
+  table.Update(peer, 2);
+  EXPECT_EQ(1u, table.size());
+  EXPECT_EQ(2u, table.FindClosest(peer));
+
+  EXPECT_TRUE(table.Remove(peer));
+  EXPECT_FALSE(table.Remove(peer));
+  EXPECT_EQ(0u, table.size());
+}
+
+TEST(KademliaTableTests, CheckClosestPeerMatchesFullScan)
+{
+  static constexpr std::size_t NUM_PEERS   = 200;
+  static constexpr std::size_t NUM_TARGETS = 1000;
+
+  LinearCongruentialGenerator rng;
+
+  KademliaTable table{GenerateAddress(rng)};
+
+  Addresses peers{};
+  for (std::size_t i = 0; i < NUM_PEERS; ++i)
+  {
+    peers.emplace_back(GenerateAddress(rng));
+    table.Update(peers.back(), static_cast<Handle>(i + 1));
+  }
+
+  for (std::size_t i = 0; i < NUM_TARGETS; ++i)
+  {
+    auto const target = GenerateAddress(rng);
+
+    // several peers can be at the same distance, so compare the distances rather than the handles
+    auto const expected = FindClosestByScan(peers, target);
+    auto const actual   = table.FindClosest(target);
+    ASSERT_NE(0u, actual);
+
+    EXPECT_EQ(CalculateDistance(peers[expected - 1], target),
+              CalculateDistance(peers[actual - 1], target));
+  }
+
+  // a peer is always the closest to itself
+  for (std::size_t i = 0; i < NUM_PEERS; ++i)
+  {
+    EXPECT_EQ(static_cast<Handle>(i + 1), table.FindClosest(peers[i]));
+  }
+}
+
+}  // namespace
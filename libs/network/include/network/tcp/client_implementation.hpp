@@ -29,9 +29,12 @@
 #include "network/message.hpp"
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 namespace fetch {
 namespace network {
@@ -49,6 +52,20 @@ public:
 
   static constexpr char const *LOGGING_NAME = "TCPClientImpl";
 
+  /// @name Write Batching
+  /// Up to the configured number of queued messages (or bytes) are coalesced into a single
+  /// gather write
+  /// @{
+  static constexpr std::size_t DEFAULT_MAX_WRITE_BATCH_MESSAGES = 64;
+  static constexpr std::size_t DEFAULT_MAX_WRITE_BATCH_BYTES    = 256 * 1024;
+  /// @}
+
+  /// The size of the buffer frames are read into. Frames which are larger are read directly
+  static constexpr std::size_t READ_BUFFER_SIZE = 64 * 1024;
+
+  /// The largest message which will be accepted, the connection is closed if a peer exceeds it
+  static constexpr std::size_t MAX_MESSAGE_SIZE = 256 * 1024 * 1024;
+
   explicit TCPClientImplementation(NetworkManagerType const &network_manager) noexcept;
   TCPClientImplementation(TCPClientImplementation const &rhs) = delete;
   TCPClientImplementation(TCPClientImplementation &&rhs)      = delete;
@@ -68,11 +85,17 @@ public:
 
   bool Closed() const override;
 
+  void SetWriteBatchLimits(std::size_t max_messages, std::size_t max_bytes);
+
   TCPClientImplementation &operator=(TCPClientImplementation const &rhs) = delete;
   TCPClientImplementation &operator=(TCPClientImplementation &&rhs) = delete;
 
 private:
-  static const uint64_t networkMagic_ = 0xFE7C80A1FE7C80A1;
+  using ConstBuffers = std::vector<asio::const_buffer>;
+  using Messages     = std::vector<MessageType>;
+
+  static const uint64_t        networkMagic_ = 0xFE7C80A1FE7C80A1;
+  static constexpr std::size_t HEADER_SIZE   = 2 * sizeof(uint64_t);
 
   NetworkManagerType networkManager_;
   // IO objects should be guaranteed to have lifetime less than the
@@ -88,13 +111,22 @@ private:
   bool              can_write_{true};
   bool              posted_close_ = false;
 
+  std::atomic<std::size_t> max_write_batch_messages_{DEFAULT_MAX_WRITE_BATCH_MESSAGES};
+  std::atomic<std::size_t> max_write_batch_bytes_{DEFAULT_MAX_WRITE_BATCH_BYTES};
+
+  // Only accessed in the strand
+  byte_array::ByteArray read_buffer_;
+  std::size_t           read_length_{0};
+
   mutable MutexType callback_mutex_;
   std::atomic<bool> connected_{false};
 
-  void ReadHeader() noexcept;
-  void ReadBody(byte_array::ByteArray const &header) noexcept;
+  void ReadNext() noexcept;
+  void ReadBody(byte_array::ByteArray message, std::size_t offset) noexcept;
+  bool ProcessReadBuffer() noexcept;
 
   static void SetHeader(byte_array::ByteArray &header, uint64_t bufSize);
+  static void SetHeader(uint8_t *header, uint64_t bufSize);
 
   // Always executed in a run(), in a strand
   void WriteNext(SharedSelfType const &selfLock);
@@ -109,6 +109,11 @@ public:
     pointer_->Send(msg);
   }
 
+  void SetWriteBatchLimits(std::size_t max_messages, std::size_t max_bytes)
+  {
+    pointer_->SetWriteBatchLimits(max_messages, max_bytes);
+  }
+
   HandleType handle() const noexcept
   {
     return pointer_->handle();
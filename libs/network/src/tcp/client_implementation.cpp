@@ -18,12 +18,17 @@
 
 #include "network/tcp/client_implementation.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 namespace fetch {
 namespace network {
 
 TCPClientImplementation::TCPClientImplementation(NetworkManagerType const &network_manager) noexcept
   : networkManager_(network_manager)
-{}
+{
+  read_buffer_.Resize(READ_BUFFER_SIZE);
+}
 
 TCPClientImplementation::~TCPClientImplementation()
 {
@@ -104,7 +109,7 @@ void TCPClientImplementation::Connect(byte_array::ConstByteArray const &host,
           {
             this->SetAddress(endpoint.address().to_string());
             this->SetPort(uint16_t(port.AsInt()));
-            ReadHeader();
+            ReadNext();
           }
           else
           {
@@ -212,7 +217,24 @@ bool TCPClientImplementation::Closed() const
   return socket_.expired();
 }
 
-void TCPClientImplementation::ReadHeader() noexcept
+/**
+ * Configure the limits of the number of queued messages (and bytes) which are coalesced into a
+ * single write. A single message is always written, even if it exceeds the byte limit
+ *
+ * @param max_messages The maximum number of messages in a write
+ * @param max_bytes The maximum number of payload bytes in a write
+ */
+void TCPClientImplementation::SetWriteBatchLimits(std::size_t max_messages, std::size_t max_bytes)
+{
+  max_write_batch_messages_ = std::max<std::size_t>(max_messages, 1);
+  max_write_batch_bytes_    = max_bytes;
+}
+
+/**
+ * Read the next block of available data from the socket into the read buffer. Several frames (or a
+ * header and its body) can be received in a single read
+ */
+void TCPClientImplementation::ReadNext() noexcept
 {
   auto strand = strand_.lock();
   if (!strand)
@@ -221,12 +243,10 @@ void TCPClientImplementation::ReadHeader() noexcept
   }
   assert(strand->running_in_this_thread());
 
-  SelfType              self   = shared_from_this();
-  auto                  socket = socket_.lock();
-  byte_array::ByteArray header;
-  header.Resize(2 * sizeof(uint64_t));
+  SelfType self   = shared_from_this();
+  auto     socket = socket_.lock();
 
-  auto cb = [this, self, socket, header, strand](std::error_code ec, std::size_t) {
+  auto cb = [this, self, socket, strand](std::error_code ec, std::size_t len) {
     SharedSelfType selfLock = self.lock();
     if (!selfLock)
     {
@@ -235,13 +255,18 @@ void TCPClientImplementation::ReadHeader() noexcept
 
     if (!ec)
     {
-      FETCH_LOG_DEBUG(LOGGING_NAME, "Read message header.");
-      ReadBody(header);
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Read ", len, " bytes.");
+      read_length_ += len;
+
+      if (ProcessReadBuffer())
+      {
+        ReadNext();
+      }
     }
     else if (!posted_close_)
     {
       // We expect to get an ec here when the socked is closed via a post
-      FETCH_LOG_INFO(LOGGING_NAME, "Socket closed inside ReadHeader: ", ec.message());
+      FETCH_LOG_INFO(LOGGING_NAME, "Socket closed inside ReadNext: ", ec.message());
       SignalLeave();
     }
   };
@@ -249,7 +274,13 @@ void TCPClientImplementation::ReadHeader() noexcept
   if (socket)
   {
     assert(strand->running_in_this_thread());
-    asio::async_read(*socket, asio::buffer(header.pointer(), header.size()), strand->wrap(cb));
+
+    // a partial frame always fits in the buffer, so there is always space for the next read
+    assert(read_length_ < read_buffer_.size());
+
+    socket->async_read_some(
+        asio::buffer(read_buffer_.pointer() + read_length_, read_buffer_.size() - read_length_),
+        strand->wrap(cb));
 
     bool const previously_connected = connected_.exchange(true);
 
@@ -260,34 +291,98 @@ void TCPClientImplementation::ReadHeader() noexcept
   }
   else
   {
-    FETCH_LOG_INFO(LOGGING_NAME, "Socket no longer valid in ReadHeader");
+    FETCH_LOG_INFO(LOGGING_NAME, "Socket no longer valid in ReadNext");
     connected_ = false;
     SignalLeave();
   }
 }
 
-void TCPClientImplementation::ReadBody(byte_array::ByteArray const &header) noexcept
+/**
+ * Extract and dispatch all the complete frames in the read buffer. The remaining partial frame (if
+ * any) is moved to the start of the buffer.
+ *
+ * @return true if reading should continue into the read buffer, otherwise false
+ */
+bool TCPClientImplementation::ProcessReadBuffer() noexcept
 {
-  auto strand = strand_.lock();
-  assert(strand->running_in_this_thread());
-
-  assert(header.size() >= sizeof(networkMagic_));
-  uint64_t magic = *reinterpret_cast<const uint64_t *>(header.pointer());
-  uint64_t size  = *reinterpret_cast<const uint64_t *>(header.pointer() + sizeof(uint64_t));
+  uint8_t const *data   = read_buffer_.pointer();
+  std::size_t    offset = 0;
 
-  if (magic != networkMagic_)
+  while ((read_length_ - offset) >= HEADER_SIZE)
   {
-    byte_array::ByteArray dummy;
-    SetHeader(dummy, 0);
-    dummy.Resize(16);
+    uint64_t magic{0};
+    uint64_t size{0};
+    std::memcpy(&magic, data + offset, sizeof(magic));
+    std::memcpy(&size, data + offset + sizeof(magic), sizeof(size));
 
-    FETCH_LOG_ERROR(LOGGING_NAME, "Magic incorrect during network read:\ngot:      ", ToHex(header),
-                    "\nExpected: ", ToHex(byte_array::ByteArray(dummy)));
-    return;
+    if (magic != networkMagic_)
+    {
+      byte_array::ByteArray dummy;
+      SetHeader(dummy, 0);
+
+      FETCH_LOG_ERROR(LOGGING_NAME, "Magic incorrect during network read:\ngot:      ",
+                      ToHex(byte_array::ByteArray(data + offset, HEADER_SIZE)),
+                      "\nExpected: ", ToHex(dummy));
+      return false;
+    }
+
+    if (size > MAX_MESSAGE_SIZE)
+    {
+      FETCH_LOG_ERROR(LOGGING_NAME, "Message size of ", size,
+                      " bytes exceeds the maximum, closing connection");
+
+      SignalLeave();
+      Close();
+      return false;
+    }
+
+    std::size_t const available = read_length_ - offset - HEADER_SIZE;
+
+    if (available >= size)
+    {
+      // the complete frame is present in the buffer
+      SignalMessage(byte_array::ByteArray(data + offset + HEADER_SIZE, size));
+      offset += HEADER_SIZE + size;
+    }
+    else if (size > (read_buffer_.size() - HEADER_SIZE))
+    {
+      // the frame is larger than the read buffer, the remainder of it is read directly
+      byte_array::ByteArray message;
+      message.Resize(size);
+      std::memcpy(message.pointer(), data + offset + HEADER_SIZE, available);
+
+      read_length_ = 0;
+      ReadBody(message, available);
+
+      return false;
+    }
+    else
+    {
+      // wait for the remainder of the frame
+      break;
+    }
+  }
+
+  // move the incomplete frame to the start of the buffer
+  read_length_ -= offset;
+  if ((offset != 0) && (read_length_ != 0))
+  {
+    std::memmove(read_buffer_.pointer(), data + offset, read_length_);
   }
 
-  byte_array::ByteArray message;
-  message.Resize(size);
+  return true;
+}
+
+/**
+ * Read the remainder of a frame which is too large for the read buffer directly into the message
+ *
+ * @param message The message to be populated
+ * @param offset The number of bytes of the message which have already been received
+ */
+void TCPClientImplementation::ReadBody(byte_array::ByteArray message, std::size_t offset) noexcept
+{
+  auto strand = strand_.lock();
+  assert(strand->running_in_this_thread());
 
   SelfType self   = shared_from_this();
   auto     socket = socket_.lock();
@@ -303,7 +398,7 @@ void TCPClientImplementation::ReadBody(byte_array::ByteArray const &header) noex
     if (!ec)
     {
       SignalMessage(message);
-      ReadHeader();
+      ReadNext();
     }
     else
     {
@@ -315,7 +410,8 @@ void TCPClientImplementation::ReadBody(byte_array::ByteArray const &header) noex
   if (socket)
   {
     assert(strand->running_in_this_thread());
-    asio::async_read(*socket, asio::buffer(message.pointer(), message.size()), strand->wrap(cb));
+    asio::async_read(*socket, asio::buffer(message.pointer() + offset, message.size() - offset),
+                     strand->wrap(cb));
   }
   else
   {
@@ -326,8 +422,12 @@ void TCPClientImplementation::ReadBody(byte_array::ByteArray const &header) noex
 
 void TCPClientImplementation::SetHeader(byte_array::ByteArray &header, uint64_t bufSize)
 {
-  header.Resize(16);
+  header.Resize(HEADER_SIZE);
+  SetHeader(header.pointer(), bufSize);
+}
 
+void TCPClientImplementation::SetHeader(uint8_t *header, uint64_t bufSize)
+{
   for (std::size_t i = 0; i < 8; ++i)
   {
     header[i] = uint8_t((networkMagic_ >> i * 8) & 0xff);
@@ -356,8 +456,12 @@ void TCPClientImplementation::WriteNext(SharedSelfType const &selfLock)
     }
   }
 
-  MessageType buffer;
+  // drain as many of the queued messages as the batch limits allow
+  Messages messages{};
   {
+    std::size_t const max_messages = max_write_batch_messages_;
+    std::size_t const max_bytes    = max_write_batch_bytes_;
+
     FETCH_LOCK(queue_mutex_);
     if (write_queue_.empty())
     {
@@ -365,19 +469,40 @@ void TCPClientImplementation::WriteNext(SharedSelfType const &selfLock)
       can_write_ = true;
       return;
     }
-    buffer = write_queue_.front();
-    write_queue_.pop_front();
+
+    std::size_t batch_bytes{0};
+    while (!write_queue_.empty() && (messages.size() < max_messages))
+    {
+      std::size_t const message_size = write_queue_.front().size();
+      if (!messages.empty() && ((batch_bytes + message_size) > max_bytes))
+      {
+        break;
+      }
+
+      batch_bytes += message_size;
+      messages.emplace_back(std::move(write_queue_.front()));
+      write_queue_.pop_front();
+    }
   }
 
-  byte_array::ByteArray header;
-  SetHeader(header, buffer.size());
+  // all the headers of the batch are stored in a single buffer
+  byte_array::ByteArray headers;
+  headers.Resize(HEADER_SIZE * messages.size());
 
-  std::vector<asio::const_buffer> buffers{asio::buffer(header.pointer(), header.size()),
-                                          asio::buffer(buffer.pointer(), buffer.size())};
+  ConstBuffers buffers{};
+  buffers.reserve(2 * messages.size());
+  for (std::size_t i = 0; i < messages.size(); ++i)
+  {
+    uint8_t *header = headers.pointer() + (i * HEADER_SIZE);
+    SetHeader(header, messages[i].size());
+
+    buffers.emplace_back(asio::buffer(header, HEADER_SIZE));
+    buffers.emplace_back(asio::buffer(messages[i].pointer(), messages[i].size()));
+  }
 
   auto socket = socket_.lock();
 
-  auto cb = [this, selfLock, socket, buffer, header](std::error_code ec, std::size_t len) {
+  auto cb = [this, selfLock, socket, messages, headers](std::error_code ec, std::size_t len) {
     FETCH_UNUSED(len);
 
     {
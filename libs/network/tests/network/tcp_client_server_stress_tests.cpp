@@ -23,6 +23,7 @@
 #include "gtest/gtest.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <memory>
@@ -585,6 +586,73 @@ void TestCase7(std::string host, uint16_t port)
   }
 }
 
+template <std::size_t N = 1>
+void TestCase8(std::string host, uint16_t port)
+{
+  std::cerr << "\nTEST CASE 8. Threads: " << N << std::endl;
+  std::cerr << "Info: Compare small message throughput with and without write batching"
+            << std::endl;
+
+  static constexpr std::size_t NUM_MESSAGES = 20000;
+
+  NetworkManager nmanager{"NetMgr", N};
+  nmanager.Start();
+
+  std::unique_ptr<Server> server = std::make_unique<Server>(port, nmanager);
+  server->Start();
+
+  waitUntilConnected(host, port);
+
+  std::size_t const batched   = TCPClientImplementation::DEFAULT_MAX_WRITE_BATCH_MESSAGES;
+  std::size_t const max_bytes = TCPClientImplementation::DEFAULT_MAX_WRITE_BATCH_BYTES;
+
+  // the first run sends every message in its own write
+  for (std::size_t max_messages : {std::size_t{1}, batched})
+  {
+    {
+      FETCH_LOCK(messages_);
+      globalMessagesFromServer_.clear();
+    }
+
+    auto client = std::make_shared<Client>(host, port, nmanager);
+    if (!(client->WaitForAlive(1000)))
+    {
+      FETCH_LOG_ERROR(LOGGING_NAME, "Client never opened");
+      throw std::runtime_error("error");
+    }
+
+    client->SetWriteBatchLimits(max_messages, max_bytes);
+
+    auto const start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < NUM_MESSAGES; ++i)
+    {
+      client->Send("message " + std::to_string(i));
+    }
+
+    for (;;)
+    {
+      {
+        FETCH_LOCK(messages_);
+
+        if (globalMessagesFromServer_.size() == NUM_MESSAGES)
+        {
+          break;
+        }
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto const duration = std::chrono::duration_cast<std::chrono::duration<double>>(
+        std::chrono::steady_clock::now() - start);
+
+    std::cerr << "Batch limit: " << max_messages << " messages. Throughput: "
+              << (static_cast<double>(NUM_MESSAGES) / duration.count()) << " messages/s"
+              << std::endl;
+  }
+}
+
 class TCPClientServerTest : public testing::TestWithParam<std::size_t>
 {
 public:
@@ -611,6 +679,7 @@ TEST_P(TCPClientServerTest, DISABLED_basic_test)
     TestCase5<1>(host, port_number);
     TestCase6<1>(host, port_number);
     TestCase7<1>(host, port_number);
+    TestCase8<1>(host, port_number);
 
     TestCase0<10>(host, port_number);
     TestCase1<10>(host, port_number);
@@ -620,6 +689,7 @@ TEST_P(TCPClientServerTest, DISABLED_basic_test)
     TestCase5<10>(host, port_number);
     TestCase6<10>(host, port_number);
     TestCase7<10>(host, port_number);
+    TestCase8<10>(host, port_number);
   }
 }
 
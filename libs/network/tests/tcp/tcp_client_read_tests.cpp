@@ -0,0 +1,293 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "network/fetch_asio.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/tcp/client_implementation.hpp"
+#include "network/tcp/tcp_client.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::network::MessageType;
+using fetch::network::NetworkManager;
+using fetch::network::TCPClient;
+using fetch::network::TCPClientImplementation;
+
+using Bytes    = std::vector<uint8_t>;
+using Messages = std::vector<MessageType>;
+using Acceptor = asio::ip::tcp::acceptor;
+using Socket   = asio::ip::tcp::socket;
+
+constexpr uint64_t NETWORK_MAGIC = 0xFE7C80A1FE7C80A1;
+
+constexpr std::chrono::seconds TIMEOUT{5};
+
+void AppendWord(Bytes &bytes, uint64_t value)
+{
+  for (std::size_t i = 0; i < sizeof(value); ++i)
+  {
+    bytes.push_back(static_cast<uint8_t>((value >> (i * 8u)) & 0xffu));
+  }
+}
+
+Bytes Frame(ConstByteArray const &payload)
+{
+  Bytes frame{};
+  AppendWord(frame, NETWORK_MAGIC);
+  AppendWord(frame, payload.size());
+  frame.insert(frame.end(), payload.pointer(), payload.pointer() + payload.size());
+
+  return frame;
+}
+
+ConstByteArray Payload(std::size_t size, uint8_t seed)
+{
+  ByteArray payload;
+  payload.Resize(size);
+
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    payload[i] = static_cast<uint8_t>(seed + (i * 31u));
+  }
+
+  return {payload};
+}
+
+/**
+ * A client connected to a raw socket, the test controls exactly which bytes are written to the
+ * client and how they are split across the writes
+ */
+class TcpClientReadTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    network_manager_ = std::make_unique<NetworkManager>("NetMgr", 1);
+    network_manager_->Start();
+
+    acceptor_ = std::make_unique<Acceptor>(
+        io_service_, asio::ip::tcp::endpoint{asio::ip::address_v4::loopback(), 0});
+    peer_ = std::make_unique<Socket>(io_service_);
+
+    client_ = std::make_unique<TCPClient>(*network_manager_);
+    client_->OnMessage([this](MessageType const &message) {
+      {
+        std::lock_guard<std::mutex> lock(lock_);
+        messages_.push_back(message);
+      }
+
+      condition_.notify_all();
+    });
+
+    client_->Connect("127.0.0.1", acceptor_->local_endpoint().port());
+
+    acceptor_->accept(*peer_);
+    peer_->set_option(asio::ip::tcp::no_delay{true});
+
+    ASSERT_TRUE(client_->WaitForAlive(5000));
+  }
+
+  void TearDown() override
+  {
+    client_->Cleanup();
+    client_.reset();
+
+    peer_.reset();
+    acceptor_.reset();
+
+    network_manager_->Stop();
+    network_manager_.reset();
+  }
+
+  // writes the bytes in separate chunks, pausing so that the client reads each of them in turn
+  void Write(Bytes const &bytes, std::vector<std::size_t> const &splits = {})
+  {
+    std::size_t offset = 0;
+    for (auto const split : splits)
+    {
+      asio::write(*peer_, asio::buffer(bytes.data() + offset, split - offset));
+      offset = split;
+
+      std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    }
+
+    asio::write(*peer_, asio::buffer(bytes.data() + offset, bytes.size() - offset));
+  }
+
+  Messages WaitForMessages(std::size_t count)
+  {
+    std::unique_lock<std::mutex> lock(lock_);
+    condition_.wait_for(lock, TIMEOUT, [this, count]() { return messages_.size() >= count; });
+
+    return messages_;
+  }
+
+  // determines if the client closed the connection to the peer
+  bool WaitForClose()
+  {
+    peer_->non_blocking(true);
+
+    auto const deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+      uint8_t         buffer[16];
+      std::error_code ec{};
+      peer_->read_some(asio::buffer(buffer), ec);
+
+      if (ec && (ec != asio::error::would_block))
+      {
+        return true;
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    return false;
+  }
+
+  asio::io_service                io_service_{};
+  std::unique_ptr<NetworkManager> network_manager_;
+  std::unique_ptr<Acceptor>       acceptor_;
+  std::unique_ptr<Socket>         peer_;
+  std::unique_ptr<TCPClient>      client_;
+
+  std::mutex              lock_;
+  std::condition_variable condition_;
+  Messages                messages_{};
+};
+
+TEST_F(TcpClientReadTests, SeveralFramesInASingleRead)
+{
+  std::vector<ConstByteArray> const payloads{Payload(1, 1), Payload(100, 2), Payload(0, 3),
+                                             Payload(1000, 4)};
+
+  Bytes bytes{};
+  for (auto const &payload : payloads)
+  {
+    auto const frame = Frame(payload);
+    bytes.insert(bytes.end(), frame.begin(), frame.end());
+  }
+
+  Write(bytes);
+
+  auto const messages = WaitForMessages(payloads.size());
+  ASSERT_EQ(payloads.size(), messages.size());
+
+  for (std::size_t i = 0; i < payloads.size(); ++i)
+  {
+    EXPECT_EQ(payloads[i], messages[i]);
+  }
+}
+
+TEST_F(TcpClientReadTests, HeaderSplitAcrossReads)
+{
+  auto const payload = Payload(64, 5);
+  auto const frame   = Frame(payload);
+
+  // split inside the magic and then inside the size
+  Write(frame, {3, 11});
+
+  auto const messages = WaitForMessages(1);
+  ASSERT_EQ(1, messages.size());
+  EXPECT_EQ(payload, messages[0]);
+}
+
+TEST_F(TcpClientReadTests, BodySplitAcrossReads)
+{
+  auto const first  = Payload(500, 6);
+  auto const second = Payload(20, 7);
+
+  Bytes bytes = Frame(first);
+  auto  frame = Frame(second);
+  bytes.insert(bytes.end(), frame.begin(), frame.end());
+
+  // split inside the first body and inside the header of the second frame
+  Write(bytes, {100, 300, 520});
+
+  auto const messages = WaitForMessages(2);
+  ASSERT_EQ(2, messages.size());
+  EXPECT_EQ(first, messages[0]);
+  EXPECT_EQ(second, messages[1]);
+}
+
+TEST_F(TcpClientReadTests, FramesLargerThanTheReadBuffer)
+{
+  std::size_t const large_size = (3 * TCPClientImplementation::READ_BUFFER_SIZE) + 17;
+
+  auto const small = Payload(10, 8);
+  auto const large = Payload(large_size, 9);
+
+  // the large frame follows a small one, so part of its body is already in the read buffer
+  Bytes bytes = Frame(small);
+  auto  frame = Frame(large);
+  bytes.insert(bytes.end(), frame.begin(), frame.end());
+  frame = Frame(small);
+  bytes.insert(bytes.end(), frame.begin(), frame.end());
+
+  Write(bytes, {1000, TCPClientImplementation::READ_BUFFER_SIZE + 5});
+
+  auto const messages = WaitForMessages(3);
+  ASSERT_EQ(3, messages.size());
+  EXPECT_EQ(small, messages[0]);
+  EXPECT_EQ(large, messages[1]);
+  EXPECT_EQ(small, messages[2]);
+}
+
+TEST_F(TcpClientReadTests, HugeMessageSizeClosesTheConnection)
+{
+  // a size which overflows when the header size is added
+  Bytes bytes{};
+  AppendWord(bytes, NETWORK_MAGIC);
+  AppendWord(bytes, std::numeric_limits<uint64_t>::max() - 4u);
+  bytes.resize(TCPClientImplementation::READ_BUFFER_SIZE, 0);
+
+  Write(bytes);
+
+  EXPECT_TRUE(WaitForClose());
+  EXPECT_TRUE(WaitForMessages(0).empty());
+}
+
+TEST_F(TcpClientReadTests, MessageSizeAboveTheLimitClosesTheConnection)
+{
+  Bytes bytes{};
+  AppendWord(bytes, NETWORK_MAGIC);
+  AppendWord(bytes, TCPClientImplementation::MAX_MESSAGE_SIZE + 1u);
+
+  Write(bytes);
+
+  EXPECT_TRUE(WaitForClose());
+  EXPECT_TRUE(WaitForMessages(0).empty());
+}
+
+}  // namespace
@@ -0,0 +1,165 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/random/lfg.hpp"
+#include "storage/key_value_index.hpp"
+#include "storage/page_cached_random_access_stack.hpp"
+#include "storage/random_access_stack.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using fetch::random::LaggedFibonacciGenerator;
+using fetch::storage::KeyValuePair;
+using fetch::storage::PageCachedRandomAccessStack;
+using fetch::storage::RandomAccessStack;
+
+namespace {
+
+using Node = KeyValuePair<>;
+
+constexpr char const *STATE_FILE  = "page_cached_state_bench.db";
+constexpr std::size_t CHUNK_SIZE  = 4096;
+constexpr int64_t     TEN_MILLION = 10000000;
+
+/**
+ * Build the state file with the requested number of trie nodes. The file is reused between the
+ * benchmarks which share the same size.
+ */
+void PrepareStateFile(std::size_t num_nodes)
+{
+  static std::size_t prepared_nodes = 0;
+
+  if (prepared_nodes == num_nodes)
+  {
+    return;
+  }
+
+  LaggedFibonacciGenerator<> lfg;
+  RandomAccessStack<Node>    stack;
+  stack.New(STATE_FILE);
+
+  std::vector<Node> chunk(CHUNK_SIZE);
+  for (std::size_t i = 0; i < num_nodes; i += CHUNK_SIZE)
+  {
+    std::size_t const count = std::min(CHUNK_SIZE, num_nodes - i);
+
+    for (std::size_t j = 0; j < count; ++j)
+    {
+      chunk[j].parent = lfg() % num_nodes;
+      chunk[j].left   = lfg() % num_nodes;
+      chunk[j].right  = lfg() % num_nodes;
+    }
+
+    stack.LazySetBulk(i, count, chunk.data());
+  }
+
+  stack.Flush(true);
+  prepared_nodes = num_nodes;
+}
+
+/**
+ * Random trie node reads against a state of the given size
+ *
+ * Arguments: number of nodes, page cache size in MiB (zero for direct file access)
+ */
+void PageCachedStack_RandomReads(benchmark::State &state)
+{
+  auto const num_nodes    = static_cast<std::size_t>(state.range(0));
+  auto const memory_limit = static_cast<std::size_t>(state.range(1)) << 20u;
+
+  PrepareStateFile(num_nodes);
+
+  PageCachedRandomAccessStack<Node> stack;
+  stack.SetMemoryLimit(memory_limit);
+  stack.Load(STATE_FILE);
+
+  LaggedFibonacciGenerator<> lfg;
+  Node                       node;
+  for (auto _ : state)
+  {
+    stack.Get(lfg() % num_nodes, node);
+    benchmark::DoNotOptimize(node);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Reads along the path from a random node to the root of a tree laid out in breadth first order,
+ * mimicking the access pattern of a trie lookup which visits the same upper nodes repeatedly
+ *
+ * Arguments: number of nodes, page cache size in MiB (zero for direct file access)
+ */
+void PageCachedStack_TreeWalk(benchmark::State &state)
+{
+  auto const num_nodes    = static_cast<std::size_t>(state.range(0));
+  auto const memory_limit = static_cast<std::size_t>(state.range(1)) << 20u;
+
+  PrepareStateFile(num_nodes);
+
+  PageCachedRandomAccessStack<Node> stack;
+  stack.SetMemoryLimit(memory_limit);
+  stack.Load(STATE_FILE);
+
+  LaggedFibonacciGenerator<> lfg;
+  Node                       node;
+  int64_t                    reads = 0;
+  for (auto _ : state)
+  {
+    uint64_t index = lfg() % num_nodes;
+    for (;;)
+    {
+      stack.Get(index, node);
+      ++reads;
+
+      if (index == 0)
+      {
+        break;
+      }
+
+      index = (index - 1) / 2;
+    }
+
+    benchmark::DoNotOptimize(node);
+  }
+
+  state.SetItemsProcessed(reads);
+}
+
+}  // namespace
+
+BENCHMARK(PageCachedStack_RandomReads)
+    ->Args({1 << 20, 0})
+    ->Args({1 << 20, 16})
+    ->Args({1 << 20, 256})
+    ->Args({TEN_MILLION, 0})
+    ->Args({TEN_MILLION, 16})
+    ->Args({TEN_MILLION, 256});
+
+BENCHMARK(PageCachedStack_TreeWalk)
+    ->Args({1 << 20, 0})
+    ->Args({1 << 20, 16})
+    ->Args({1 << 20, 256})
+    ->Args({TEN_MILLION, 0})
+    ->Args({TEN_MILLION, 16})
+    ->Args({TEN_MILLION, 256});
@@ -334,6 +334,51 @@ public:
            file_object_.underlying_stack().HashExists(DefaultKey(hash));
   }
 
+  /**
+   * Configure the periodic snapshots of both of the underlying versioned stacks
+   *
+   * @param: interval The number of commits between snapshots, zero disables snapshots
+   * @param: max_snapshots The maximum number of snapshots to retain, zero for unlimited
+   */
+  void SetSnapshotPolicy(uint64_t interval, uint64_t max_snapshots)
+  {
+    FETCH_LOCK(mutex_);
+    key_index_.underlying_stack().SetSnapshotPolicy(interval, max_snapshots);
+    file_object_.underlying_stack().SetSnapshotPolicy(interval, max_snapshots);
+  }
+
+  /**
+   * Configure the memory limit of the page caches of both of the underlying stacks
+   *
+   * @param: max_bytes The memory limit of each of the stacks, zero for direct file access
+   */
+  void SetCacheSize(std::size_t max_bytes)
+  {
+    FETCH_LOCK(mutex_);
+    key_index_.underlying_stack().underlying_stack().SetMemoryLimit(max_bytes);
+    file_object_.underlying_stack().underlying_stack().SetMemoryLimit(max_bytes);
+  }
+
+  /**
+   * Select how the documents are hashed into the leaves of the key index. Since this determines
+   * the state root, it must be switched at the same point in the chain by every node, for example
+   * at a fork height. Only the documents written after the switch are affected. The version is
+   * recorded in the state, it is committed with it and restored by a revert or a load.
+   *
+   * @param: version The hash version of the documents
+   */
+  void SetHashVersion(FileObjectHashVersion version)
+  {
+    FETCH_LOCK(mutex_);
+    file_object_.SetHashVersion(version);
+  }
+
+  FileObjectHashVersion hash_version()
+  {
+    FETCH_LOCK(mutex_);
+    return file_object_.hash_version();
+  }
+
   HashType CurrentHash()
   {
     FETCH_LOCK(mutex_);
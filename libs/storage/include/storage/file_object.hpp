@@ -32,6 +32,7 @@
 //    └────────────────────┴───────────────────────────┘
 
 #include "core/byte_array/const_byte_array.hpp"
+#include "crypto/merkle_tree.hpp"
 #include "crypto/sha256.hpp"
 #include "storage/cached_random_access_stack.hpp"
 #include "storage/document.hpp"
@@ -39,12 +40,27 @@
 #include "storage/versioned_random_access_stack.hpp"
 #include "vectorise/platform.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <unordered_map>
 #include <vector>
 
 namespace fetch {
 namespace storage {
 
+/**
+ * The versions of the digest of a file object, which form the leaves of the state trie. Since
+ * changing the version changes the state root, it must only be changed at an agreed point in the
+ * chain. The version is stored in the stack itself, so that it is retained when the file is loaded
+ * again and is restored along with the rest of the state on a revert.
+ */
+enum class FileObjectHashVersion : uint8_t
+{
+  SHA256_CONTENTS = 1,  ///< SHA256 of the contents of the file
+  CHUNKED_MERKLE  = 2,  ///< SHA256 of the length and the Merkle root of the digests of the blocks
+};
+
 template <std::size_t BS = 128>
 struct FileBlockType
 {
@@ -153,6 +169,9 @@ public:
 
   void UpdateHash(HasherType &hasher);
 
+  void                  SetHashVersion(FileObjectHashVersion version);
+  FileObjectHashVersion hash_version() const;
+
   bool SeekFile(std::size_t position);
 
   void CreateNewFile(uint64_t size = 0);
@@ -170,9 +189,29 @@ public:
   {
     block_index_ = 0;
     id_          = 0;
+
+    // the blocks may have been changed underneath us
+    block_digests_.clear();
+    LoadHashVersion();
   }
 
 private:
+  /// The maximum number of block digests retained by the chunked hash, approximately 5MB
+  static constexpr std::size_t MAX_CACHED_BLOCK_DIGESTS = 1u << 16u;
+
+  /**
+   * The digest of the contents of a block, along with the link to the next block, which remains
+   * valid until the block is next written
+   */
+  struct BlockDigest
+  {
+    uint64_t bytes = BlockType::UNDEFINED;  // The number of bytes of the block hashed
+    uint64_t next  = BlockType::UNDEFINED;
+    uint8_t  digest[HasherType::size_in_bytes];
+  };
+
+  using BlockDigests = std::unordered_map<uint64_t, BlockDigest>;
+
   StackType stack_;
 
   std::vector<std::vector<std::tuple<uint64_t, uint64_t, uint64_t>>> linked_lists;
@@ -186,6 +225,9 @@ private:
   uint64_t length_            = 0;  // length in bytes of file.
                                     // can be found from Get(id) right - any point in keeping?
 
+  FileObjectHashVersion hash_version_{FileObjectHashVersion::SHA256_CONTENTS};
+  BlockDigests          block_digests_;  // Keyed by the location of the block on the stack
+
   // TODO(private 1067): BlockType -> BlockType etc.
   // TODO(private 1067): possibly some performance benefits by caching blocks like the free block
   // here
@@ -193,6 +235,8 @@ private:
 
   void Initalise();
 
+  void LoadHashVersion();
+
   enum class Action
   {
     READ,
@@ -207,6 +251,8 @@ private:
 
   void ReadWriteHelper(uint8_t const *bytes, uint64_t num, Action action);
 
+  byte_array::ConstByteArray ChunkedHash();
+
   void Get(uint64_t index, BlockType &block);
 
   void Set(uint64_t index, BlockType const &block);
@@ -369,6 +415,7 @@ void FileObject<S>::ReadWriteHelper(uint8_t const *bytes, uint64_t num, Action a
     // Get block, write data to it
     Get(block_index_being_written, block_being_written);
 
+    bool modified = false;
     switch (action)
     {
     case Action::READ:
@@ -377,13 +424,23 @@ void FileObject<S>::ReadWriteHelper(uint8_t const *bytes, uint64_t num, Action a
              bytes_to_write_in_block);
       break;
     case Action::WRITE:
-      memcpy(block_being_written.data + byte_index, bytes + bytes_offset, bytes_to_write_in_block);
+      // Blocks whose contents are unchanged are not rewritten, and therefore not rehashed
+      if (memcmp(block_being_written.data + byte_index, bytes + bytes_offset,
+                 bytes_to_write_in_block) != 0)
+      {
+        memcpy(block_being_written.data + byte_index, bytes + bytes_offset,
+               bytes_to_write_in_block);
+        modified = true;
+      }
       break;
     }
 
     // Write block back
     byte_index = 0;
-    Set(block_index_being_written, block_being_written);
+    if (modified)
+    {
+      Set(block_index_being_written, block_being_written);
+    }
     block_index_being_written = block_being_written.next;
 
     bytes_offset += bytes_to_write_in_block;
@@ -427,6 +484,11 @@ uint64_t FileObject<S>::FileObjectSize() const
 template <typename S>
 byte_array::ConstByteArray FileObject<S>::Hash()
 {
+  if (hash_version_ == FileObjectHashVersion::CHUNKED_MERKLE)
+  {
+    return ChunkedHash();
+  }
+
   HasherType hasher;
   hasher.Reset();
   UpdateHash(hasher);
@@ -448,6 +510,102 @@ void FileObject<S>::UpdateHash(HasherType &hasher)
   hasher.Update(arr.pointer(), length_);
 }
 
+/**
+ * Set the hash version of the file objects. The version is recorded in the free block, which makes
+ * it part of the (versioned) contents of the stack.
+ *
+ * @param: version The hash version
+ */
+template <typename S>
+void FileObject<S>::SetHashVersion(FileObjectHashVersion version)
+{
+  if (version == hash_version_)
+  {
+    return;
+  }
+
+  BlockType free_block;
+  Get(free_block_index_, free_block);
+  free_block.data[0] = static_cast<uint8_t>(version);
+  Set(free_block_index_, free_block);
+
+  hash_version_ = version;
+}
+
+template <typename S>
+FileObjectHashVersion FileObject<S>::hash_version() const
+{
+  return hash_version_;
+}
+
+/**
+ * Hash the file as the Merkle tree of the digests of its blocks, where only the blocks which have
+ * been written since they were last hashed need to be read and hashed again. The length of the
+ * file is included in the final digest since it determines the shape of the tree.
+ *
+ * @return: The digest of the file
+ */
+template <typename S>
+byte_array::ConstByteArray FileObject<S>::ChunkedHash()
+{
+  uint64_t const num_blocks = platform::DivideCeil<uint64_t>(length_, BlockType::CAPACITY);
+
+  crypto::MerkleTree tree{num_blocks};
+
+  BlockType block;
+  uint64_t  block_index = id_;
+  for (uint64_t i = 0; i < num_blocks; ++i)
+  {
+    uint64_t const remaining = length_ - (i * BlockType::CAPACITY);
+    uint64_t const bytes     = (remaining < BlockType::CAPACITY) ? remaining : BlockType::CAPACITY;
+
+    auto it = block_digests_.find(block_index);
+    if (it == block_digests_.end())
+    {
+      // bound the size of the cache by evicting an arbitrary entry
+      if (block_digests_.size() >= MAX_CACHED_BLOCK_DIGESTS)
+      {
+        block_digests_.erase(block_digests_.begin());
+      }
+
+      it = block_digests_.emplace(block_index, BlockDigest{}).first;
+    }
+
+    BlockDigest &cached = it->second;
+    if (cached.bytes != bytes)
+    {
+      Get(block_index, block);
+
+      HasherType hasher;
+      hasher.Reset();
+      hasher.Update(block.data, bytes);
+      hasher.Final(cached.digest);
+
+      cached.bytes = bytes;
+      cached.next  = block.next;
+    }
+
+    tree[i]     = byte_array::ConstByteArray{cached.digest, HasherType::size_in_bytes};
+    block_index = cached.next;
+  }
+
+  tree.CalculateRoot();
+
+  // the length is encoded explicitly so that the digest does not depend on the platform
+  uint8_t length[sizeof(uint64_t)];
+  for (std::size_t i = 0; i < sizeof(uint64_t); ++i)
+  {
+    length[i] = static_cast<uint8_t>(length_ >> (8u * i));
+  }
+
+  HasherType hasher;
+  hasher.Reset();
+  hasher.Update(length, sizeof(length));
+  hasher.Update(tree.root());
+
+  return hasher.Final();
+}
+
 template <typename S>
 bool FileObject<S>::SeekFile(std::size_t position)
 {
@@ -556,10 +714,36 @@ void FileObject<S>::Initalise()
   block_index_           = 0;
   id_                    = 0;
 
+  block_digests_.clear();
+
   if (stack_.size() == 0)
   {
     stack_.Push(free_block);
   }
+
+  LoadHashVersion();
+}
+
+/**
+ * Restore the hash version from the free block. Stacks created before the version was recorded
+ * use the original version.
+ */
+template <typename S>
+void FileObject<S>::LoadHashVersion()
+{
+  if (stack_.size() == 0)
+  {
+    hash_version_ = FileObjectHashVersion::SHA256_CONTENTS;
+    return;
+  }
+
+  BlockType free_block;
+  Get(free_block_index_, free_block);
+
+  hash_version_ =
+      (free_block.data[0] == static_cast<uint8_t>(FileObjectHashVersion::CHUNKED_MERKLE))
+          ? FileObjectHashVersion::CHUNKED_MERKLE
+          : FileObjectHashVersion::SHA256_CONTENTS;
 }
 
 /**
@@ -949,6 +1133,8 @@ void FileObject<S>::Set(uint64_t index, BlockType const &block)
     throw StorageException("Attempt to Set invalid location");
   }
 
+  block_digests_.erase(index);
+
   stack_.Set(index, block);
 }
 
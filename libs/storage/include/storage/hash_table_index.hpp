@@ -0,0 +1,368 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+
+//  ┌──────┬──────┬──────┬──────┬──────┬──────┬──────┬──────┐
+//  │      │      │      │      │      │      │      │      │
+//  │HEADER│ SLOT │EMPTY │ SLOT │ERASED│ SLOT │EMPTY │EMPTY │......
+//  │      │      │      │      │      │      │      │      │
+//  └──────┴──────┴──────┴──────┴──────┴──────┴──────┴──────┘
+//            ▲              │
+//            │   (probe)    │
+//            └──────────────┘
+
+#include "core/assert.hpp"
+#include "storage/key.hpp"
+#include "storage/random_access_stack.hpp"
+#include "storage/storage_exception.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace fetch {
+namespace storage {
+
+/**
+ * The HashTableIndex is a persistent, open addressed hash table which maps keys to fixed width
+ * values. The slots of the table are stored in a RandomAccessStack, so lookups, insertions and
+ * removals only touch the handful of slots visited by the linear probe.
+ *
+ * The keys are expected to be the output of a cryptographic hash function, therefore the first
+ * block of the key is used directly as the hash of the slot. Removed entries are marked as erased
+ * (tombstones) and the table is rebuilt at double the capacity when more than half of the slots are
+ * in use.
+ *
+ * Note that like the RandomAccessStack, values must be trivially copyable.
+ */
+template <typename V, typename K = Key<256>>
+class HashTableIndex
+{
+public:
+  using KeyType   = K;
+  using ValueType = V;
+
+  static_assert(std::is_trivially_copyable<V>::value, "Values must be trivially copyable");
+
+  static constexpr std::size_t INITIAL_CAPACITY = 1024;
+
+  void Load(std::string const &filename, bool const &create_if_not_exist = true)
+  {
+    filename_ = filename;
+    stack_.Load(filename_, create_if_not_exist);
+
+    if (stack_.empty())
+    {
+      Reset(INITIAL_CAPACITY);
+    }
+  }
+
+  void New(std::string const &filename)
+  {
+    filename_ = filename;
+    Reset(INITIAL_CAPACITY);
+  }
+
+  void Clear()
+  {
+    Reset(INITIAL_CAPACITY);
+  }
+
+  /**
+   * Lookup the value associated with a key
+   *
+   * @param: key The key to lookup
+   * @param: value The value to be populated if the key is present
+   *
+   * @return: true if the key is present, otherwise false
+   */
+  bool Get(KeyType const &key, ValueType &value) const
+  {
+    Slot       slot;
+    bool const found = Locate(key, slot) != NOT_FOUND;
+
+    if (found)
+    {
+      value = slot.value;
+    }
+
+    return found;
+  }
+
+  bool Has(KeyType const &key) const
+  {
+    Slot slot;
+    return Locate(key, slot) != NOT_FOUND;
+  }
+
+  /**
+   * Insert a key value pair into the table, updating the value if the key is already present
+   *
+   * @param: key The key to insert
+   * @param: value The value to associate with the key
+   */
+  void Set(KeyType const &key, ValueType const &value)
+  {
+    Slot slot;
+
+    // simple case, just update the existing entry
+    std::size_t const existing = Locate(key, slot);
+    if (existing != NOT_FOUND)
+    {
+      slot.value = value;
+      stack_.Set(existing, slot);
+      return;
+    }
+
+    // ensure there is room in the table for another entry
+    HeaderType header = stack_.header_extra();
+    if (((header.used + 1) << 1u) > capacity())
+    {
+      Rebuild(std::max(capacity(), (header.entries + 1) << 2u));
+      header = stack_.header_extra();
+    }
+
+    // find the first free slot along the probe sequence
+    std::size_t index = Start(key);
+    for (;;)
+    {
+      stack_.Get(index, slot);
+
+      if (slot.state != OCCUPIED)
+      {
+        break;
+      }
+
+      index = Next(index);
+    }
+
+    if (slot.state == EMPTY)
+    {
+      ++header.used;
+    }
+    ++header.entries;
+
+    stack_.Set(index, Slot{key, value});
+    stack_.SetExtraHeader(header);
+  }
+
+  /**
+   * Remove a key from the table
+   *
+   * @param: key The key to be removed
+   *
+   * @return: true if the key was present, otherwise false
+   */
+  bool Erase(KeyType const &key)
+  {
+    Slot              slot;
+    std::size_t const index = Locate(key, slot);
+
+    if (index == NOT_FOUND)
+    {
+      return false;
+    }
+
+    slot.state = ERASED;
+    stack_.Set(index, slot);
+
+    HeaderType header = stack_.header_extra();
+    --header.entries;
+    stack_.SetExtraHeader(header);
+
+    return true;
+  }
+
+  void Flush(bool const &lazy = true)
+  {
+    stack_.Flush(lazy);
+  }
+
+  std::size_t size() const
+  {
+    return stack_.header_extra().entries;
+  }
+
+  bool empty() const
+  {
+    return size() == 0;
+  }
+
+  std::size_t capacity() const
+  {
+    return stack_.size();
+  }
+
+  bool is_open() const
+  {
+    return stack_.is_open();
+  }
+
+private:
+  static constexpr std::size_t NOT_FOUND   = std::numeric_limits<std::size_t>::max();
+  static constexpr std::size_t BULK_LENGTH = 4096;
+
+  enum : uint64_t
+  {
+    EMPTY = 0,
+    OCCUPIED,
+    ERASED
+  };
+
+  struct Slot
+  {
+    Slot()
+    {
+      // Clear the whole structure (including padded regions) are zeroed
+      memset(this, 0, sizeof(decltype(*this)));
+    }
+
+    Slot(KeyType const &k, ValueType const &v)
+    {
+      // Clear the whole structure (including padded regions) are zeroed
+      memset(this, 0, sizeof(decltype(*this)));
+
+      state = OCCUPIED;
+      key   = k;
+      value = v;
+    }
+
+    uint64_t  state;
+    KeyType   key;
+    ValueType value;
+  };
+
+  struct HeaderType
+  {
+    uint64_t entries = 0;  ///< The number of keys present in the table
+    uint64_t used    = 0;  ///< The number of slots which are not empty (entries and tombstones)
+  };
+
+  using StackType = RandomAccessStack<Slot, HeaderType>;
+
+  std::size_t Start(KeyType const &key) const
+  {
+    return static_cast<std::size_t>(key.blocks()[0]) & (capacity() - 1);
+  }
+
+  std::size_t Next(std::size_t index) const
+  {
+    return (index + 1) & (capacity() - 1);
+  }
+
+  /**
+   * Find the slot containing the given key
+   *
+   * @param: key The key to search for
+   * @param: slot The slot to be populated with the contents of the located slot
+   *
+   * @return: The index of the slot, or NOT_FOUND if the key is not present
+   */
+  std::size_t Locate(KeyType const &key, Slot &slot) const
+  {
+    std::size_t index = Start(key);
+
+    // since the table is never more than half full this is guaranteed to terminate
+    for (;;)
+    {
+      stack_.Get(index, slot);
+
+      if (slot.state == EMPTY)
+      {
+        return NOT_FOUND;
+      }
+
+      if ((slot.state == OCCUPIED) && (slot.key == key))
+      {
+        return index;
+      }
+
+      index = Next(index);
+    }
+  }
+
+  /**
+   * Truncate the underlying file and fill it with empty slots
+   *
+   * @param: new_capacity The number of slots in the table, must be a power of two
+   */
+  void Reset(std::size_t new_capacity)
+  {
+    assert((new_capacity & (new_capacity - 1)) == 0);
+
+    stack_.New(filename_);
+
+    std::vector<Slot> const empty_slots((new_capacity < BULK_LENGTH) ? new_capacity : BULK_LENGTH);
+    for (std::size_t i = 0; i < new_capacity; i += empty_slots.size())
+    {
+      stack_.LazySetBulk(i, empty_slots.size(), empty_slots.data());
+    }
+
+    stack_.SetExtraHeader(HeaderType{});
+  }
+
+  /**
+   * Rebuild the table with a new capacity, dropping all the tombstones
+   *
+   * @param: min_capacity The minimum number of slots required
+   */
+  void Rebuild(std::size_t min_capacity)
+  {
+    std::size_t new_capacity = INITIAL_CAPACITY;
+    while (new_capacity < min_capacity)
+    {
+      new_capacity <<= 1u;
+    }
+
+    // extract all the live entries from the current table
+    std::vector<Slot> entries;
+    entries.reserve(size());
+
+    std::vector<Slot> buffer(BULK_LENGTH);
+    for (std::size_t i = 0, end = capacity(); i < end; i += BULK_LENGTH)
+    {
+      std::size_t const count = ((end - i) < BULK_LENGTH) ? (end - i) : BULK_LENGTH;
+      stack_.GetBulk(i, count, buffer.data());
+
+      std::copy_if(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(count),
+                   std::back_inserter(entries),
+                   [](Slot const &slot) { return slot.state == OCCUPIED; });
+    }
+
+    Reset(new_capacity);
+
+    // reinsert all the entries into the new table
+    for (auto const &entry : entries)
+    {
+      Set(entry.key, entry.value);
+    }
+
+    stack_.Flush(true);
+  }
+
+  std::string       filename_;
+  mutable StackType stack_;
+};
+
+}  // namespace storage
+}  // namespace fetch
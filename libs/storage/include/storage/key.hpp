@@ -166,6 +166,16 @@ struct Key
     return ret;
   }
 
+  /**
+   * Access the underlying blocks of the key
+   *
+   * @return: the array of key blocks
+   */
+  KeyArray const &blocks() const
+  {
+    return key_;
+  }
+
   /**
    * Return the number of bits the key represents
    *
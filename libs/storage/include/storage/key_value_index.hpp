@@ -56,6 +56,7 @@
 // Representation of a possible configuration of the key value trie. When the split is maximal
 // (256), this represents that the node is a leaf. The nodes can contain additional information
 
+#include "crypto/hash_pairs.hpp"
 #include "crypto/sha256.hpp"
 #include "storage/cached_random_access_stack.hpp"
 #include "storage/key.hpp"
@@ -64,10 +65,14 @@
 #include "storage/storage_exception.hpp"
 #include "storage/versioned_random_access_stack.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <cstring>
 #include <deque>
-#include <queue>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -88,6 +93,7 @@ struct KeyValuePair
 {
   using HashFunction = crypto::SHA256;
   static_assert(N == HashFunction::size_in_bytes, "Hash size must match the hash function");
+  static_assert(2 * N == crypto::HASH_PAIR_INPUT_SIZE, "Node hashes must be batchable");
 
   using KeyType   = Key<S>;
   using IndexType = uint64_t;
@@ -135,16 +141,24 @@ struct KeyValuePair
 
   bool UpdateNode(KeyValuePair const &left, KeyValuePair const &right)
   {
-    HashFunction hasher;
-    hasher.Reset();
+    uint8_t children[crypto::HASH_PAIR_INPUT_SIZE];
+    SetChildHashes(children, left, right);
 
-    hasher.Update(right.hash, N);
-    hasher.Update(left.hash, N);
-    hasher.Final(hash);
+    crypto::HashPairs(children, hash, 1);
 
     return true;
   }
 
+  /**
+   * Write the message hashed by UpdateNode into the buffer, so that nodes can be updated in batches
+   */
+  static void SetChildHashes(uint8_t *children, KeyValuePair const &left,
+                             KeyValuePair const &right)
+  {
+    memcpy(children, right.hash, N);
+    memcpy(children + N, left.hash, N);
+  }
+
   byte_array::ByteArray Hash() const
   {
     return {hash, N};
@@ -160,24 +174,6 @@ struct KeyValuePair
 template <typename KV = KeyValuePair<>, typename D = VersionedRandomAccessStack<KV>>
 class KeyValueIndex
 {
-  /**
-   * Used to keep track of the ordering of task priority, in this usage writing to the stack.
-   */
-  struct UpdateTask
-  {
-    uint64_t priority;
-    uint64_t element;
-
-    bool operator==(UpdateTask const &other) const
-    {
-      return (priority == other.priority) && (other.element == element);
-    }
-    bool operator<(UpdateTask const &other) const
-    {
-      return priority < other.priority;
-    }
-  };
-
 public:
   using SelfType       = KeyValueIndex<KV, D>;
   using StackType      = D;
@@ -219,70 +215,18 @@ public:
 
     stack_.SetExtraHeader(root_);
 
-    std::unordered_map<uint64_t, uint64_t> depths;
-    std::unordered_map<uint64_t, uint64_t> parents;
-    std::priority_queue<UpdateTask>        q;
-
-    for (auto &k : schedule_update_)
+    // every ancestor of a modified leaf must be rehashed. A parent always splits on an earlier bit
+    // than its children, so visiting the nodes in order of decreasing split ensures the children
+    // of a node are up to date before it is hashed, while the nodes sharing a split are
+    // independent of each other and are hashed as a single batch
+    for (auto const &update : schedule_update_)
     {
-      auto &         kv   = k.second;
-      uint64_t       last = k.first;
-      uint64_t       pid  = kv.parent;
-      key_value_pair parent;
-      uint64_t       depth = 1;
-
-      while (pid != uint64_t(-1))
-      {
-        if (parents.find(last) != parents.end())
-        {
-          depth += depths[last];
-          break;
-        }
-        parents[last] = pid;
-
-        stack_.Get(pid, parent);
-        last = pid;
-        pid  = parent.parent;
-        ++depth;
-      }
-
-      // Adding root
-      if (pid == uint64_t(-1))
-      {
-        parents[last] = pid;
-      }
-
-      last = k.first;
-      while (parents.find(last) != parents.end())
-      {
-        if (depths.find(last) != depths.end())
-        {
-          break;
-        }
-        depths[last] = depth;
-        q.push({depth, last});
-        --depth;
-        last = parents[last];
-      }
+      MarkDirty(update.second.parent);
     }
 
-    UpdateTask task{};
-    while (!q.empty())
+    for (std::size_t split = dirty_levels_.size(); split > 0; --split)
     {
-      task = q.top();
-      q.pop();
-
-      key_value_pair element, left, right;
-      stack_.Get(task.element, element);
-      if (element.is_leaf())
-      {
-        continue;
-      }
-
-      stack_.Get(element.left, left);
-      stack_.Get(element.right, right);
-      element.UpdateNode(left, right);
-      stack_.Set(task.element, element);
+      UpdateLevel(dirty_levels_[split - 1]);
     }
 
     schedule_update_.clear();
@@ -794,11 +738,98 @@ public:
   }
 
 private:
+  /**
+   * A node whose hash is recomputed at the next flush
+   */
+  struct DirtyNode
+  {
+    IndexType      index;
+    key_value_pair node;
+  };
+
+  using DirtyLevel = std::vector<DirtyNode>;
+
   StackType stack_;
 
   uint64_t                                     root_ = 0;
   std::unordered_map<uint64_t, key_value_pair> schedule_update_;
 
+  // the nodes to rehash indexed by their split, along with the buffers for hashing them. These are
+  // retained between flushes so that no memory is allocated once they have grown to size
+  std::array<DirtyLevel, key_type::BITS> dirty_levels_;
+  std::vector<uint8_t>                   child_hashes_;
+  std::vector<uint8_t>                   node_hashes_;
+
+  void MarkDirty(IndexType index)
+  {
+    if (index == key_value_pair::TREE_ROOT_VALUE)
+    {
+      return;
+    }
+
+    DirtyNode dirty{index, {}};
+    stack_.Get(index, dirty.node);
+
+    // only leaves split on the last bit, every ancestor of a leaf splits on an earlier one
+    if (dirty.node.split >= dirty_levels_.size())
+    {
+      throw StorageException("Split of node in key value index out of range: tree broken");
+    }
+
+    dirty_levels_[dirty.node.split].push_back(dirty);
+  }
+
+  /**
+   * Rehash the nodes of a level, whose children are all up to date, and mark their parents dirty
+   *
+   * @param: level The nodes sharing a split
+   */
+  void UpdateLevel(DirtyLevel &level)
+  {
+    if (level.empty())
+    {
+      return;
+    }
+
+    // a node is marked once for each of its modified children
+    std::sort(level.begin(), level.end(),
+              [](DirtyNode const &a, DirtyNode const &b) { return a.index < b.index; });
+    level.erase(std::unique(level.begin(), level.end(),
+                            [](DirtyNode const &a, DirtyNode const &b) {
+                              return a.index == b.index;
+                            }),
+                level.end());
+
+    child_hashes_.resize(level.size() * crypto::HASH_PAIR_INPUT_SIZE);
+    node_hashes_.resize(level.size() * crypto::HASH_PAIR_OUTPUT_SIZE);
+
+    key_value_pair left, right;
+    for (std::size_t i = 0; i < level.size(); ++i)
+    {
+      stack_.Get(level[i].node.left, left);
+      stack_.Get(level[i].node.right, right);
+
+      key_value_pair::SetChildHashes(child_hashes_.data() + (i * crypto::HASH_PAIR_INPUT_SIZE),
+                                     left, right);
+    }
+
+    crypto::HashPairsInParallel(child_hashes_.data(), node_hashes_.data(), level.size());
+
+    for (std::size_t i = 0; i < level.size(); ++i)
+    {
+      DirtyNode &dirty = level[i];
+
+      memcpy(dirty.node.hash, node_hashes_.data() + (i * crypto::HASH_PAIR_OUTPUT_SIZE),
+             crypto::HASH_PAIR_OUTPUT_SIZE);
+      stack_.Set(dirty.index, dirty.node);
+
+      // the parents split on an earlier bit, so are never added to this level
+      MarkDirty(dirty.node.parent);
+    }
+
+    level.clear();
+  }
+
   /**
    * Update the parents of a changed node, since this changes the merkle tree
    *
@@ -19,6 +19,7 @@
 
 #include "storage/document_store.hpp"
 #include "storage/new_versioned_random_access_stack.hpp"
+#include "storage/page_cached_random_access_stack.hpp"
 
 #include <cstddef>
 #include <string>
@@ -52,16 +53,22 @@ public:
   bool HashExists(Hash const &hash);
   Keys KeyDump();
   void Reset();
+  void SetSnapshotPolicy(uint64_t interval, uint64_t max_snapshots);
+  void SetCacheSize(std::size_t max_bytes);
+  void SetHashVersion(FileObjectHashVersion version);
 
-  std::size_t size() const;
+  FileObjectHashVersion hash_version();
+  std::size_t           size() const;
 
 private:
+  template <typename T>
+  using Stack = NewVersionedRandomAccessStack<T, PageCachedRandomAccessStack<T, NewBookmarkHeader>>;
+
   using Storage = storage::DocumentStore<
-      2048,                 // block size
-      FileBlockType<2048>,  // file block type
-      KeyValueIndex<KeyValuePair<>, NewVersionedRandomAccessStack<KeyValuePair<>>>,  // Key value
-                                                                                     // index
-      NewVersionedRandomAccessStack<FileBlockType<2048>>>;                           // File store
+      2048,                                                  // block size
+      FileBlockType<2048>,                                   // file block type
+      KeyValueIndex<KeyValuePair<>, Stack<KeyValuePair<>>>,  // Key value index
+      Stack<FileBlockType<2048>>>;                           // File store
 
   std::string state_path_;
   std::string state_history_path_;
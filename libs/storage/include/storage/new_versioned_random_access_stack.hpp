@@ -37,14 +37,20 @@
 //       └──────┴──────┴──────┴──────┴──────┘
 
 #include "storage/cached_random_access_stack.hpp"
+#include "storage/hash_table_index.hpp"
 #include "storage/key.hpp"
 #include "storage/random_access_stack.hpp"
 #include "storage/storage_exception.hpp"
 #include "storage/variant_stack.hpp"
 
 #include "core/byte_array/encoders.hpp"
+#include "core/filesystem/sync_file.hpp"
 
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -255,6 +261,41 @@ private:
     uint64_t data = 0;
   };
 
+  /**
+   * Stored in the hash index, locates the most recent bookmark for a key in the hash history
+   */
+  struct BookmarkLocation
+  {
+    uint64_t position = 0;  ///< The index of the most recent bookmark in the hash history
+    uint64_t count    = 0;  ///< The number of bookmarks in the hash history with this key
+  };
+
+  using HashIndex = HashTableIndex<BookmarkLocation, DefaultKey>;
+
+  /**
+   * Describes a full copy of the main stack taken immediately after a commit
+   */
+  struct SnapshotRecord
+  {
+    SnapshotRecord() = default;
+    SnapshotRecord(uint64_t position_, uint64_t bookmark_, VariantStack::Header const &history_)
+      : position{position_}
+      , bookmark{bookmark_}
+      , history{history_}
+    {}
+
+    uint64_t             position{0};  ///< The index of the snapshot bookmark in the hash history
+    uint64_t             bookmark{0};  ///< The internal bookmark index of the snapshot
+    VariantStack::Header history{};    ///< The marker of the history stack before the bookmark
+  };
+
+  // records are written to disk directly, so there must be no padding to leave uninitialised
+  static_assert(sizeof(SnapshotRecord) == (2 * sizeof(uint64_t)) + sizeof(VariantStack::Header),
+                "SnapshotRecord must be packed");
+
+  using SnapshotStack = RandomAccessStack<SnapshotRecord>;
+  using SnapshotFile  = RandomAccessStack<T, HeaderType>;
+
 public:
   using type             = T;
   using EventHandlerType = std::function<void()>;
@@ -268,6 +309,12 @@ public:
   ~NewVersionedRandomAccessStack()
   {
     stack_.ClearEventHandlers();
+
+    // make sure a caching stack does not write back its contents ahead of the history
+    if (stack_.is_open())
+    {
+      Flush(true);
+    }
   }
 
   void ClearEventHandlers()
@@ -315,26 +362,62 @@ public:
   void Load(std::string const &filename, std::string const &history,
             bool const &create_if_not_exist = true)
   {
+    filename_         = filename;
+    history_filename_ = history;
+
+    // roll forward a discard of the history which was interrupted after being journalled
+    bool const discarding = ReplaceTruncatedFiles();
+
     stack_.Load(filename, create_if_not_exist);
     history_.Load(history, create_if_not_exist);
 
-    hash_history_.Load("hash_history_" + history, create_if_not_exist);
+    hash_history_.Load(HashHistoryFilename(), create_if_not_exist);
+    hash_index_.Load("hash_index_" + history, create_if_not_exist);
+    snapshots_.Load(SnapshotsFilename(), create_if_not_exist);
     internal_bookmark_index_ = stack_.header_extra().bookmark;
+
+    if (discarding)
+    {
+      CompleteDiscard();
+    }
+    // the hash index can always be recovered from the hash history, for example when loading files
+    // created before the index existed or after an unclean shutdown
+    else if (!HashIndexConsistent())
+    {
+      FETCH_LOG_INFO(LOGGING_NAME, "Rebuilding hash index from history of ", hash_history_.size(),
+                     " bookmarks");
+      RebuildHashIndex();
+    }
   }
 
   void New(std::string const &filename, std::string const &history)
   {
+    RemoveSnapshots(0);
+
+    filename_         = filename;
+    history_filename_ = history;
+
+    // a new stack must not pick up an interrupted discard of a previous one
+    std::remove(DiscardJournalFilename().c_str());
+    ReplaceTruncatedFiles();
+
     stack_.New(filename);
     history_.New(history);
-    hash_history_.New("hash_history_" + history);
+    hash_history_.New(HashHistoryFilename());
+    hash_index_.New("hash_index_" + history);
+    snapshots_.New(SnapshotsFilename());
     internal_bookmark_index_ = stack_.header_extra().bookmark;
   }
 
   void Clear()
   {
+    RemoveSnapshots(0);
+
     stack_.Clear();
     history_.Clear();
     hash_history_.Clear();
+    hash_index_.Clear();
+    snapshots_.Clear();
 
     internal_bookmark_index_ = stack_.header_extra().bookmark;
   }
@@ -405,10 +488,18 @@ public:
     Flush(false);
 
     // Create a bookmark with our key, push it to the history stack
-    HistoryBookmark history_bookmark{internal_bookmark_index_, key};
+    HistoryBookmark            history_bookmark{internal_bookmark_index_, key};
+    VariantStack::Header const history_mark = history_.Mark();
 
     history_.Push(history_bookmark, HistoryBookmark::value);
-    hash_history_.Push(history_bookmark);
+    uint64_t const position = hash_history_floor() + hash_history_.Push(history_bookmark);
+
+    // update the index with the location of the latest bookmark for this key
+    BookmarkLocation location{};
+    hash_index_.Get(key, location);
+    location.position = position;
+    ++location.count;
+    hash_index_.Set(key, location);
 
     // Update our header with this information (the bookmark index)
     HeaderType h = stack_.header_extra();
@@ -420,44 +511,69 @@ public:
     // Optionally flush since this is a checkpoint
     Flush(false);
 
-    return internal_bookmark_index_ - 1;
-  }
-
-  bool HashExists(DefaultKey const &key) const
-  {
-    if (hash_history_.empty())
+    // periodically take a snapshot of the main stack
+    if ((snapshot_interval_ != 0) && (((position + 1) % snapshot_interval_) == 0))
     {
-      FETCH_LOG_DEBUG(LOGGING_NAME, "Attempted to find if hash exists, but history is empty!");
-      return false;
+      CreateSnapshot(position, history_mark);
     }
 
-    uint64_t        hash_history_size = hash_history_.size();
-    HistoryBookmark book;
+    return internal_bookmark_index_ - 1;
+  }
 
-    for (std::size_t i = 0; i < hash_history_size; ++i)
-    {
-      uint64_t reverse_index = hash_history_size - i - 1;
-      hash_history_.Get(reverse_index, book);
+  /**
+   * Configure the periodic snapshots of the main stack.
+   *
+   * When enabled, a full copy of the main stack is taken every `interval` commits. Reverting to a
+   * bookmark far back in the history then restores the closest later snapshot and only replays the
+   * history between that snapshot and the bookmark. Snapshots are only used when the history to be
+   * skipped is larger than the main stack itself.
+   *
+   * If `max_snapshots` is non zero, only that many snapshots are retained and the history below the
+   * oldest retained snapshot is discarded, bounding the disk usage of the history. The bookmarks
+   * below this point can no longer be reverted to.
+   *
+   * Each snapshot is a full synchronous copy of the main stack made inside Commit, so the commits
+   * which take one cost time proportional to the size of the stack. The interval should be chosen
+   * so that this is amortised over the commits in between.
+   *
+   * @param: interval The number of commits between snapshots, zero disables snapshots
+   * @param: max_snapshots The maximum number of snapshots to retain, zero for unlimited
+   */
+  void SetSnapshotPolicy(uint64_t interval, uint64_t max_snapshots)
+  {
+    snapshot_interval_ = interval;
+    max_snapshots_     = max_snapshots;
+  }
 
-      if (book.key == key)
-      {
-        return true;
-      }
-    }
+  std::size_t num_snapshots() const
+  {
+    return snapshots_.size();
+  }
 
-    return false;
+  bool HashExists(DefaultKey const &key) const
+  {
+    return hash_index_.Has(key);
   }
 
   /**
    * Revert the main stack to the point at bookmark b by continually popping off changes from the
-   * history, inspecting their type, and applying a revert with that change. Unsafe if the key
-   * doesn't exist!
+   * history, inspecting their type, and applying a revert with that change. The hash index is
+   * consulted first, so requesting an unknown key leaves the stack untouched.
    *
    * @param: b The bookmark to revert to
    *
    */
   void RevertToHash(DefaultKey const &key)
   {
+    BookmarkLocation location{};
+    if (!hash_index_.Get(key, location))
+    {
+      throw StorageException("Attempt to revert to key failed, key does not exist in history.");
+    }
+
+    // jump as close to the bookmark as possible before replaying the history
+    RestoreClosestSnapshot(location.position);
+
     bool bookmark_found = false;
 
     while (!bookmark_found)
@@ -495,14 +611,30 @@ public:
         throw StorageException("Undefined type found when reverting in versioned history");
       }
     }
+
+    // any snapshots taken after this bookmark no longer correspond to the history
+    RemoveSnapshots(hash_history_size());
   }
 
+  /**
+   * Flush the stack and its history to disk. The handlers are run first since they can still modify
+   * the stack. The history is then written ahead of the main stack, so that the changes which reach
+   * the stack file can always be reverted after a crash.
+   *
+   * @param: lazy Whether to skip the user defined callbacks
+   */
   void Flush(bool lazy = true)
   {
-    // Note that the variant stack (history) does not need flushing
-    stack_.Flush(lazy);
-    history_.Flush(lazy);
-    hash_history_.Flush(lazy);
+    if (!lazy)
+    {
+      SignalBeforeFlush();
+    }
+
+    history_.Flush(true);
+    hash_history_.Flush(true);
+    hash_index_.Flush(true);
+    snapshots_.Flush(true);
+    stack_.Flush(true);
   }
 
   std::size_t size() const
@@ -520,9 +652,20 @@ public:
     return stack_.is_open();
   }
 
+  StackType &underlying_stack()
+  {
+    return stack_;
+  }
+
 private:
   VariantStack                       history_;
   RandomAccessStack<HistoryBookmark> hash_history_;
+  HashIndex                          hash_index_;
+  SnapshotStack                      snapshots_;
+  std::string                        filename_;
+  std::string                        history_filename_;
+  uint64_t                           snapshot_interval_{0};
+  uint64_t                           max_snapshots_{0};
   uint64_t                           internal_bookmark_index_{0};
 
   EventHandlerType on_file_loaded_;
@@ -556,11 +699,95 @@ private:
       }
 
       hash_history_.Pop();
+      RemoveFromHashIndex(book.key);
     }
 
     return key_to_compare == book.key;
   }
 
+  /**
+   * Update the hash index after the top bookmark with the given key has been removed from the hash
+   * history
+   *
+   * @param: key The key of the removed bookmark
+   */
+  void RemoveFromHashIndex(DefaultKey const &key)
+  {
+    BookmarkLocation location{};
+    if (!hash_index_.Get(key, location))
+    {
+      FETCH_LOG_ERROR(LOGGING_NAME, "Hash index missing entry for bookmark being removed!");
+      return;
+    }
+
+    if (location.count <= 1)
+    {
+      hash_index_.Erase(key);
+      return;
+    }
+
+    // rare case, the same key has been committed multiple times. Search back through the history
+    // for the previous bookmark with this key
+    --location.count;
+
+    HistoryBookmark book;
+    uint64_t const floor = hash_history_floor();
+    for (uint64_t i = std::min<uint64_t>(location.position, hash_history_size()); i > floor; --i)
+    {
+      GetBookmark(i - 1, book);
+
+      if (book.key == key)
+      {
+        location.position = i - 1;
+        break;
+      }
+    }
+
+    hash_index_.Set(key, location);
+  }
+
+  /**
+   * Determine if the hash index reflects the contents of the hash history
+   *
+   * @return: true if consistent, otherwise false
+   */
+  bool HashIndexConsistent() const
+  {
+    if (hash_history_.empty())
+    {
+      return hash_index_.empty();
+    }
+
+    if (hash_index_.size() > hash_history_.size())
+    {
+      return false;
+    }
+
+    // the most recent bookmark must always be the one indexed for its key
+    BookmarkLocation location{};
+    return hash_index_.Get(hash_history_.Top().key, location) &&
+           (location.position == (hash_history_size() - 1));
+  }
+
+  void RebuildHashIndex()
+  {
+    hash_index_.Clear();
+
+    HistoryBookmark book;
+    for (uint64_t i = 0, end = hash_history_.size(); i < end; ++i)
+    {
+      hash_history_.Get(i, book);
+
+      BookmarkLocation location{};
+      hash_index_.Get(book.key, location);
+      location.position = hash_history_floor() + i;
+      ++location.count;
+      hash_index_.Set(book.key, location);
+    }
+
+    hash_index_.Flush(false);
+  }
+
   void RevertSwap()
   {
     HistorySwap swap;
@@ -605,6 +832,383 @@ private:
     assert(this->header_extra() == h.header);
     history_.Pop();
   }
+
+  /**
+   * The position of the oldest bookmark in the hash history which can still be reverted to. The
+   * bookmarks below this have been discarded along with their history, so the positions of the
+   * remaining bookmarks are offset by this amount in the hash history file.
+   */
+  uint64_t hash_history_floor() const
+  {
+    return hash_history_.header_extra();
+  }
+
+  /**
+   * The total number of bookmarks committed, including those which have been discarded
+   */
+  uint64_t hash_history_size() const
+  {
+    return hash_history_floor() + hash_history_.size();
+  }
+
+  /**
+   * Get a bookmark from the hash history by its position, which must not be below the floor
+   */
+  void GetBookmark(uint64_t position, HistoryBookmark &book) const
+  {
+    assert(position >= hash_history_floor());
+    hash_history_.Get(position - hash_history_floor(), book);
+  }
+
+  std::string HashHistoryFilename() const
+  {
+    return "hash_history_" + history_filename_;
+  }
+
+  std::string SnapshotsFilename() const
+  {
+    return "snapshots_" + history_filename_;
+  }
+
+  std::string SnapshotFilename(uint64_t position) const
+  {
+    return filename_ + ".snapshot." + std::to_string(position);
+  }
+
+  std::string DiscardJournalFilename() const
+  {
+    return history_filename_ + ".discard";
+  }
+
+  static std::string TruncatedFilename(std::string const &filename)
+  {
+    return filename + ".truncate";
+  }
+
+  /**
+   * The files which are rewritten when discarding the history
+   */
+  std::vector<std::string> TruncatedFiles() const
+  {
+    return {history_filename_, HashHistoryFilename(), SnapshotsFilename()};
+  }
+
+  /**
+   * Write a full copy of the main stack to disk and record it. The copy is made synchronously and
+   * synced to disk before it is recorded, so a crash never leaves a record of a partial snapshot.
+   *
+   * @param: position The index of the bookmark in the hash history just committed
+   * @param: history_mark The marker of the history stack before the bookmark was pushed
+   */
+  void CreateSnapshot(uint64_t position, VariantStack::Header const &history_mark)
+  {
+    static constexpr std::size_t BULK_LENGTH = 1024;
+
+    std::string const snapshot_filename = SnapshotFilename(position);
+
+    SnapshotFile snapshot;
+    snapshot.New(snapshot_filename);
+
+    std::vector<type> buffer;
+    buffer.reserve(BULK_LENGTH);
+
+    for (std::size_t i = 0, end = stack_.size(); i < end; ++i)
+    {
+      buffer.emplace_back();
+      stack_.Get(i, buffer.back());
+
+      if ((buffer.size() == BULK_LENGTH) || ((i + 1) == end))
+      {
+        snapshot.LazySetBulk(i + 1 - buffer.size(), buffer.size(), buffer.data());
+        buffer.clear();
+      }
+    }
+
+    snapshot.SetExtraHeader(stack_.header_extra());
+    snapshot.Close();
+
+    if (!core::SyncFile(snapshot_filename.c_str()))
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to sync snapshot at bookmark position: ", position);
+      std::remove(snapshot_filename.c_str());
+      return;
+    }
+
+    snapshots_.Push(SnapshotRecord{position, internal_bookmark_index_ - 1, history_mark});
+    snapshots_.Flush(false);
+
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Created snapshot at bookmark position: ", position);
+
+    if ((max_snapshots_ != 0) && (snapshots_.size() > max_snapshots_))
+    {
+      DiscardHistoryBelow(snapshots_.size() - max_snapshots_);
+    }
+  }
+
+  /**
+   * Remove the oldest snapshots and all of the history below the oldest remaining one.
+   *
+   * The history, hash history and snapshot records are rewritten to temporary files which are
+   * synced to disk, after which a journal listing the snapshots to be removed is written. The
+   * journal is the commit point: a crash before it is written leaves the original files in place,
+   * and a crash after it is rolled forward by the next Load().
+   *
+   * @param: count The number of snapshots to remove
+   */
+  void DiscardHistoryBelow(uint64_t count)
+  {
+    std::vector<SnapshotRecord> records(snapshots_.size());
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+      snapshots_.Get(i, records[i]);
+    }
+
+    SnapshotRecord const oldest    = records[count];
+    uint64_t const       new_floor = oldest.position;
+
+    // discard the history itself (keeping the snapshot bookmark)
+    history_.WriteTruncated(oldest.history, TruncatedFilename(history_filename_));
+
+    // keep the bookmarks from the oldest snapshot onwards
+    {
+      RandomAccessStack<HistoryBookmark> hash_history;
+      hash_history.New(TruncatedFilename(HashHistoryFilename()));
+
+      HistoryBookmark book;
+      for (uint64_t i = new_floor, end = hash_history_size(); i < end; ++i)
+      {
+        GetBookmark(i, book);
+        hash_history.Push(book);
+      }
+
+      hash_history.SetExtraHeader(new_floor);
+      hash_history.Close();
+    }
+
+    // rewrite the remaining snapshot records with markers into the truncated history
+    {
+      SnapshotStack snapshots;
+      snapshots.New(TruncatedFilename(SnapshotsFilename()));
+
+      for (std::size_t i = count; i < records.size(); ++i)
+      {
+        records[i].history = VariantStack::Rebase(records[i].history, oldest.history);
+        snapshots.Push(records[i]);
+      }
+
+      snapshots.Close();
+    }
+
+    for (auto const &file : TruncatedFiles())
+    {
+      std::string const truncated = TruncatedFilename(file);
+      if (!core::SyncFile(truncated.c_str()) || !core::SyncParentDirectory(truncated.c_str()))
+      {
+        throw StorageException("Unable to sync truncated history files");
+      }
+    }
+
+    // write the journal, committing to the discard
+    std::string const journal_filename = DiscardJournalFilename();
+    {
+      std::ofstream journal(journal_filename, std::ios::trunc);
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        journal << records[i].position << '\n';
+      }
+
+      if (!journal.flush())
+      {
+        throw StorageException("Unable to write history discard journal");
+      }
+    }
+
+    if (!core::SyncFile(journal_filename.c_str()) ||
+        !core::SyncParentDirectory(journal_filename.c_str()))
+    {
+      throw StorageException("Unable to sync history discard journal");
+    }
+
+    history_.Close();
+    hash_history_.Close();
+    snapshots_.Close();
+
+    ReplaceTruncatedFiles();
+
+    history_.Load(history_filename_, false);
+    hash_history_.Load(HashHistoryFilename(), false);
+    snapshots_.Load(SnapshotsFilename(), false);
+
+    CompleteDiscard();
+
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Discarded history below bookmark position: ", new_floor);
+  }
+
+  /**
+   * Move the truncated files written by DiscardHistoryBelow() over the originals if the discard has
+   * been journalled, otherwise remove any left behind by an interrupted discard. The files must not
+   * be open.
+   *
+   * @return: true if a journalled discard is in progress, otherwise false
+   */
+  bool ReplaceTruncatedFiles()
+  {
+    bool const journalled = std::ifstream(DiscardJournalFilename()).good();
+
+    for (auto const &file : TruncatedFiles())
+    {
+      std::string const truncated = TruncatedFilename(file);
+      if (!std::ifstream(truncated).good())
+      {
+        // either already moved into place or never written
+        continue;
+      }
+
+      if (!journalled)
+      {
+        std::remove(truncated.c_str());
+      }
+      else if ((std::rename(truncated.c_str(), file.c_str()) != 0) ||
+               !core::SyncParentDirectory(file.c_str()))
+      {
+        throw StorageException("Unable to replace history file with truncated version");
+      }
+    }
+
+    return journalled;
+  }
+
+  /**
+   * Complete a journalled discard once the truncated files have been loaded, by rebuilding the hash
+   * index and removing the discarded snapshots. The journal is removed last so that this can be
+   * repeated after a crash.
+   */
+  void CompleteDiscard()
+  {
+    RebuildHashIndex();
+
+    std::string const journal_filename = DiscardJournalFilename();
+    {
+      std::ifstream journal(journal_filename);
+
+      uint64_t position{0};
+      while (journal >> position)
+      {
+        std::remove(SnapshotFilename(position).c_str());
+      }
+    }
+
+    std::remove(journal_filename.c_str());
+  }
+
+  /**
+   * Remove all the snapshots taken at or after a given bookmark position
+   *
+   * @param: position The position in the hash history
+   */
+  void RemoveSnapshots(uint64_t position)
+  {
+    if (!snapshots_.is_open())
+    {
+      return;
+    }
+
+    SnapshotRecord record;
+    while (!snapshots_.empty())
+    {
+      record = snapshots_.Top();
+
+      if (record.position < position)
+      {
+        break;
+      }
+
+      std::remove(SnapshotFilename(record.position).c_str());
+      snapshots_.Pop();
+    }
+  }
+
+  /**
+   * Restore the oldest snapshot taken at or after the target bookmark, if doing so avoids replaying
+   * more history than the cost of restoring the snapshot
+   *
+   * @param: target The position of the target bookmark in the hash history
+   */
+  void RestoreClosestSnapshot(uint64_t target)
+  {
+    // locate the oldest snapshot at or after the target which is not the current head
+    bool           found{false};
+    SnapshotRecord record;
+    for (std::size_t i = 0, end = snapshots_.size(); i < end; ++i)
+    {
+      snapshots_.Get(i, record);
+
+      if ((record.position >= target) && ((record.position + 1) < hash_history_size()))
+      {
+        found = true;
+        break;
+      }
+    }
+
+    if (!found)
+    {
+      return;
+    }
+
+    // only worthwhile if the history skipped outweighs copying the stack
+    auto const skipped   = static_cast<uint64_t>(history_.Mark().end - record.history.end);
+    auto const restoring = static_cast<uint64_t>(stack_.size() * sizeof(type));
+    if (skipped <= restoring)
+    {
+      return;
+    }
+
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Restoring snapshot at bookmark position: ", record.position);
+
+    SnapshotFile snapshot;
+    snapshot.Load(SnapshotFilename(record.position), false);
+
+    // copy the contents of the snapshot into the main stack
+    type object;
+    while (stack_.size() > snapshot.size())
+    {
+      stack_.Pop();
+    }
+
+    for (std::size_t i = 0, end = snapshot.size(); i < end; ++i)
+    {
+      snapshot.Get(i, object);
+
+      if (i < stack_.size())
+      {
+        stack_.Set(i, object);
+      }
+      else
+      {
+        stack_.Push(object);
+      }
+    }
+
+    stack_.SetExtraHeader(snapshot.header_extra());
+
+    // discard the bookmarks made after the snapshot
+    HistoryBookmark book;
+    while (hash_history_size() > (record.position + 1))
+    {
+      book = hash_history_.Top();
+      hash_history_.Pop();
+      RemoveFromHashIndex(book.key);
+    }
+
+    // rewind the history to before the snapshot bookmark and then restore the bookmark itself
+    book = hash_history_.Top();
+    history_.RevertTo(record.history);
+    history_.Push(book, HistoryBookmark::value);
+
+    internal_bookmark_index_ = record.bookmark + 1;
+
+    RemoveSnapshots(record.position + 1);
+  }
 };
 
 }  // namespace storage
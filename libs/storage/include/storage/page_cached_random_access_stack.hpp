@@ -0,0 +1,497 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+//  ┌──────┬───────────┬───────────┬───────────┬───────────┐
+//  │      │           │           │           │           │
+//  │HEADER│  OBJECT   │  OBJECT   │  OBJECT   │  OBJECT   │
+//  │      │           │           │           │           │......
+//  │      │           │           │           │           │
+//  └──────┴───────────┴───────────┴───────────┴───────────┘
+//         │                       │                       │
+//         │◄──────── PAGE ───────►│◄──────── PAGE ───────►│
+
+#include "core/assert.hpp"
+#include "storage/random_access_stack.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace storage {
+
+/**
+ * The PageCachedRandomAccessStack owns a stack of type T (RandomAccessStack) and keeps a bounded
+ * resident set of fixed size pages of it in memory.
+ *
+ * Clean pages are evicted in least recently used order once the memory limit is reached. Modified
+ * pages are pinned in memory and are only written back to the file when the stack is flushed, in
+ * ascending order followed by the header. This means that the owner of the stack (for example the
+ * versioned stack) can make its own history durable before any of the changes that it describes
+ * reach the file.
+ *
+ * Setting a memory limit of zero bypasses the cache and accesses the file directly.
+ */
+template <typename T, typename D = uint64_t>
+class PageCachedRandomAccessStack
+{
+public:
+  using StackType        = RandomAccessStack<T, D>;
+  using HeaderExtraType  = D;
+  using type             = T;
+  using EventHandlerType = std::function<void()>;
+
+  static constexpr std::size_t PAGE_SIZE_BYTES = 1ull << 12;
+  static constexpr std::size_t ELEMENTS_PER_PAGE =
+      (sizeof(T) < PAGE_SIZE_BYTES) ? (PAGE_SIZE_BYTES / sizeof(T)) : 1;
+  static constexpr std::size_t DEFAULT_MEMORY_LIMIT = 1ull << 24;
+
+  PageCachedRandomAccessStack()
+  {
+    stack_.OnFileLoaded([this]() {
+      objects_       = stack_.size();
+      header_extra_  = stack_.header_extra();
+      header_stored_ = true;
+      SignalFileLoaded();
+    });
+    stack_.OnBeforeFlush([this]() { SignalBeforeFlush(); });
+  }
+
+  PageCachedRandomAccessStack(PageCachedRandomAccessStack const &) = delete;
+  PageCachedRandomAccessStack(PageCachedRandomAccessStack &&)      = delete;
+
+  ~PageCachedRandomAccessStack()
+  {
+    stack_.ClearEventHandlers();
+
+    // unlike the direct stack the pending writes only exist in memory
+    if (stack_.is_open())
+    {
+      Flush(true);
+    }
+  }
+
+  void ClearEventHandlers()
+  {
+    on_file_loaded_  = nullptr;
+    on_before_flush_ = nullptr;
+  }
+
+  void OnFileLoaded(EventHandlerType const &f)
+  {
+    on_file_loaded_ = f;
+  }
+
+  void OnBeforeFlush(EventHandlerType const &f)
+  {
+    on_before_flush_ = f;
+  }
+
+  void SignalFileLoaded()
+  {
+    if (on_file_loaded_)
+    {
+      on_file_loaded_();
+    }
+  }
+
+  void SignalBeforeFlush()
+  {
+    if (on_before_flush_)
+    {
+      on_before_flush_();
+    }
+  }
+
+  /**
+   * Indicate whether the stack is writing directly to disk or caching writes. Reads always observe
+   * previous writes, so from the point of view of the user the stack behaves like a direct one.
+   *
+   * @return: Whether the stack is written straight to disk.
+   */
+  static constexpr bool DirectWrite()
+  {
+    return true;
+  }
+
+  /**
+   * Set the maximum amount of memory used for clean pages. Pages which have been modified since the
+   * last flush are retained regardless, therefore the resident set can temporarily exceed this.
+   *
+   * @param: max_bytes The memory limit in bytes, zero to access the file directly
+   */
+  void SetMemoryLimit(std::size_t max_bytes)
+  {
+    max_pages_ = max_bytes / (ELEMENTS_PER_PAGE * sizeof(type));
+    EvictPages(max_pages_);
+  }
+
+  std::size_t memory_limit() const
+  {
+    return max_pages_ * ELEMENTS_PER_PAGE * sizeof(type);
+  }
+
+  std::size_t resident_pages() const
+  {
+    return pages_.size();
+  }
+
+  void Load(std::string const &filename, bool const &create_if_not_exist = false)
+  {
+    DropPages();
+    stack_.Load(filename, create_if_not_exist);
+  }
+
+  void New(std::string const &filename)
+  {
+    DropPages();
+    stack_.New(filename);
+  }
+
+  void Close(bool const &lazy = false)
+  {
+    Flush(lazy);
+    DropPages();
+    stack_.Close(true);
+  }
+
+  void Get(std::size_t i, type &object) const
+  {
+    assert(i < objects_);
+
+    uint64_t const page_number = i / ELEMENTS_PER_PAGE;
+
+    Page *page = LookupPage(page_number);
+    if (page != nullptr)
+    {
+      object = page->elements[i % ELEMENTS_PER_PAGE];
+    }
+    else if (Bypass())
+    {
+      stack_.Get(i, object);
+    }
+    else
+    {
+      object = LoadPage(page_number).elements[i % ELEMENTS_PER_PAGE];
+    }
+  }
+
+  void Set(std::size_t i, type const &object)
+  {
+    assert(i < objects_);
+
+    Write(i, object);
+  }
+
+  void SetExtraHeader(HeaderExtraType const &he)
+  {
+    header_extra_  = he;
+    header_stored_ = false;
+  }
+
+  HeaderExtraType const &header_extra() const
+  {
+    return header_extra_;
+  }
+
+  uint64_t Push(type const &object)
+  {
+    uint64_t const index = objects_++;
+    Write(index, object);
+
+    return index;
+  }
+
+  /**
+   * Remove the top element of the stack. The file is only truncated on the next flush
+   */
+  void Pop()
+  {
+    assert(objects_ > 0);
+    --objects_;
+  }
+
+  type Top() const
+  {
+    assert(objects_ > 0);
+
+    type object;
+    Get(objects_ - 1, object);
+
+    return object;
+  }
+
+  void Swap(std::size_t i, std::size_t j)
+  {
+    if (i == j)
+    {
+      return;
+    }
+
+    type a, b;
+    Get(i, a);
+    Get(j, b);
+
+    Write(i, b);
+    Write(j, a);
+  }
+
+  std::size_t size() const
+  {
+    return objects_;
+  }
+
+  std::size_t empty() const
+  {
+    return objects_ == 0;
+  }
+
+  void Clear()
+  {
+    DropPages();
+    stack_.Clear();
+
+    objects_       = 0;
+    header_extra_  = HeaderExtraType{};
+    header_stored_ = true;
+  }
+
+  /**
+   * Write all the modified pages and the header back to the file. Afterwards the clean pages are
+   * trimmed back to the memory limit.
+   *
+   * @param: lazy Whether to skip the user defined callbacks
+   */
+  void Flush(bool const &lazy = false)
+  {
+    if (!lazy)
+    {
+      SignalBeforeFlush();
+    }
+
+    WriteBackPages();
+
+    // elements which have been popped since the last flush
+    while (stack_.size() > objects_)
+    {
+      stack_.Pop();
+    }
+
+    if (!header_stored_)
+    {
+      stack_.SetExtraHeader(header_extra_);
+      header_stored_ = true;
+    }
+
+    stack_.Flush(true);
+
+    EvictPages(max_pages_);
+  }
+
+  bool is_open() const
+  {
+    return stack_.is_open();
+  }
+
+  StackType &underlying_stack()
+  {
+    return stack_;
+  }
+
+private:
+  using PageNumber = uint64_t;
+  using LruList    = std::list<PageNumber>;
+
+  struct Page
+  {
+    std::vector<type> elements;
+    std::size_t       dirty_begin{ELEMENTS_PER_PAGE};  ///< First modified element in the page
+    std::size_t       dirty_end{0};                    ///< One past the last modified element
+    LruList::iterator lru_position{};                  ///< Only valid for clean pages
+
+    bool dirty() const
+    {
+      return dirty_begin < dirty_end;
+    }
+  };
+
+  using PageMap = std::unordered_map<PageNumber, Page>;
+
+  EventHandlerType on_file_loaded_;
+  EventHandlerType on_before_flush_;
+
+  // reads will populate the resident set
+  mutable StackType       stack_;
+  mutable PageMap         pages_;
+  mutable LruList         lru_;  ///< Clean pages, most recently used first
+  std::vector<PageNumber> dirty_pages_;
+  std::size_t             max_pages_{DEFAULT_MEMORY_LIMIT / (ELEMENTS_PER_PAGE * sizeof(T))};
+  uint64_t                objects_{0};
+  HeaderExtraType         header_extra_{};
+  bool                    header_stored_{true};
+
+  /**
+   * Whether the file should be accessed directly. This is only safe once all the modified pages
+   * have been written back, since until then the file might be shorter than the stack
+   */
+  bool Bypass() const
+  {
+    return (max_pages_ == 0) && pages_.empty();
+  }
+
+  Page *LookupPage(PageNumber page_number) const
+  {
+    auto it = pages_.find(page_number);
+    if (it == pages_.end())
+    {
+      return nullptr;
+    }
+
+    Page &page = it->second;
+    if (!page.dirty())
+    {
+      lru_.splice(lru_.begin(), lru_, page.lru_position);
+    }
+
+    return &page;
+  }
+
+  Page &LoadPage(PageNumber page_number) const
+  {
+    // make room for the page which is about to be loaded
+    if (max_pages_ > 0)
+    {
+      EvictPages(max_pages_ - 1);
+    }
+
+    Page &page = pages_[page_number];
+    page.elements.resize(ELEMENTS_PER_PAGE);
+
+    // only the elements which are already present in the file are read
+    stack_.GetBulk(page_number * ELEMENTS_PER_PAGE, ELEMENTS_PER_PAGE, page.elements.data());
+
+    page.lru_position = lru_.insert(lru_.begin(), page_number);
+
+    return page;
+  }
+
+  void Write(std::size_t i, type const &object)
+  {
+    uint64_t const    page_number = i / ELEMENTS_PER_PAGE;
+    std::size_t const offset      = i % ELEMENTS_PER_PAGE;
+
+    Page *page = LookupPage(page_number);
+    if (page == nullptr)
+    {
+      if (Bypass())
+      {
+        // the file is never shorter than the stack when all the pages have been written back
+        if (i < stack_.size())
+        {
+          stack_.Set(i, object);
+        }
+        else
+        {
+          assert(i == stack_.size());
+          stack_.LazyPush(object);
+        }
+
+        return;
+      }
+
+      page = &LoadPage(page_number);
+    }
+
+    page->elements[offset] = object;
+
+    // pin the page in memory until the next flush
+    if (!page->dirty())
+    {
+      lru_.erase(page->lru_position);
+      dirty_pages_.push_back(page_number);
+    }
+
+    page->dirty_begin = std::min(page->dirty_begin, offset);
+    page->dirty_end   = std::max(page->dirty_end, offset + 1);
+  }
+
+  void WriteBackPages()
+  {
+    // writing in ascending order means the file only ever grows contiguously
+    std::sort(dirty_pages_.begin(), dirty_pages_.end());
+
+    for (PageNumber page_number : dirty_pages_)
+    {
+      auto it = pages_.find(page_number);
+      assert(it != pages_.end());
+
+      Page &         page  = it->second;
+      uint64_t const start = page_number * ELEMENTS_PER_PAGE;
+
+      // the page has been entirely popped from the stack
+      if (start >= objects_)
+      {
+        pages_.erase(it);
+        continue;
+      }
+
+      uint64_t const    remaining = objects_ - start;
+      std::size_t const valid =
+          (remaining < ELEMENTS_PER_PAGE) ? static_cast<std::size_t>(remaining) : ELEMENTS_PER_PAGE;
+      std::size_t const end = std::min(page.dirty_end, valid);
+
+      if (page.dirty_begin < end)
+      {
+        stack_.LazySetBulk(start + page.dirty_begin, end - page.dirty_begin,
+                           page.elements.data() + page.dirty_begin);
+      }
+
+      page.dirty_begin  = ELEMENTS_PER_PAGE;
+      page.dirty_end    = 0;
+      page.lru_position = lru_.insert(lru_.begin(), page_number);
+    }
+
+    dirty_pages_.clear();
+  }
+
+  void EvictPages(std::size_t max_pages) const
+  {
+    while ((pages_.size() > max_pages) && !lru_.empty())
+    {
+      pages_.erase(lru_.back());
+      lru_.pop_back();
+    }
+  }
+
+  void DropPages()
+  {
+    pages_.clear();
+    lru_.clear();
+    dirty_pages_.clear();
+  }
+};
+
+}  // namespace storage
+}  // namespace fetch
@@ -34,13 +34,17 @@
 //                                  └─────────────────────┴─────────────────────┘
 
 #include "core/assert.hpp"
+#include "core/filesystem/sync_file.hpp"
 #include "core/macros.hpp"
 #include "storage/storage_exception.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <string>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -240,6 +244,154 @@ public:
     return separator.type;
   }
 
+  /**
+   * Obtain a marker for the current top of the stack. This can later be used to discard all the
+   * objects pushed after this point (RevertTo) or before it (TruncateBelow).
+   *
+   * @return: The marker for the current top of the stack
+   */
+  Header Mark() const
+  {
+    return header_;
+  }
+
+  /**
+   * Discard all the objects pushed onto the stack after the marker was taken
+   *
+   * @param: mark The marker previously obtained from Mark()
+   */
+  void RevertTo(Header const &mark)
+  {
+    assert(mark.end <= header_.end);
+    assert(mark.object_count <= header_.object_count);
+
+    header_ = mark;
+    WriteHeader();
+  }
+
+  /**
+   * Discard all the objects pushed onto the stack before the marker was taken. This requires the
+   * remaining objects to be rewritten at the start of the file, therefore all previously taken
+   * markers are invalidated. Equivalent markers can be calculated with Rebase().
+   *
+   * The truncated stack is written to a temporary file and synced to disk before it replaces the
+   * current file, so that a crash leaves either the original or the truncated stack.
+   *
+   * @param: mark The marker previously obtained from Mark()
+   */
+  void TruncateBelow(Header const &mark)
+  {
+    // nothing to discard
+    if (mark.end == int64_t{sizeof(Header) + sizeof(Separator)})
+    {
+      return;
+    }
+
+    std::string const temp_filename = filename_ + ".truncate";
+
+    WriteTruncated(mark, temp_filename);
+
+    // replace the current file with the truncated one
+    file_handle_.close();
+    if (std::rename(temp_filename.c_str(), filename_.c_str()) != 0)
+    {
+      throw StorageException("Unable to replace variant stack file after truncation");
+    }
+
+    core::SyncParentDirectory(filename_.c_str());
+
+    Load(filename_, false);
+  }
+
+  /**
+   * Write a copy of the stack without the objects pushed before the marker was taken to another
+   * file, which is synced to disk. The stack itself is unchanged.
+   *
+   * @param: mark The marker previously obtained from Mark()
+   * @param: filename The file to be written
+   */
+  void WriteTruncated(Header const &mark, std::string const &filename)
+  {
+    assert(mark.end <= header_.end);
+    assert(mark.object_count <= header_.object_count);
+
+    static constexpr std::size_t BUFFER_LENGTH = 1u << 20u;
+
+    int64_t const base   = int64_t{sizeof(Header) + sizeof(Separator)};
+    int64_t const offset = mark.end - base;
+
+    WriteHeader();
+    file_handle_.flush();
+
+    std::fstream output(filename, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+
+    // start the new file with the same initial separator as an empty stack
+    Separator const initial = {HEADER_OBJECT, 0, UNDEFINED_POSITION};
+    output.seekp(int64_t{sizeof(Header)}, std::fstream::beg);
+    output.write(reinterpret_cast<char const *>(&initial), sizeof(Separator));
+
+    // copy all the objects (and their separators) above the marker into the new file
+    std::vector<char> buffer(BUFFER_LENGTH);
+    file_handle_.seekg(mark.end, std::fstream::beg);
+
+    for (int64_t remaining = header_.end - mark.end; remaining > 0;)
+    {
+      auto const chunk = static_cast<std::streamsize>(
+          std::min<int64_t>(remaining, static_cast<int64_t>(buffer.size())));
+
+      file_handle_.read(buffer.data(), chunk);
+      output.write(buffer.data(), chunk);
+      remaining -= chunk;
+    }
+
+    // walk back through the copied separators updating their offsets
+    Header const updated = Rebase(header_, mark);
+
+    int64_t position = updated.end;
+    for (uint64_t i = 0; i < updated.object_count; ++i)
+    {
+      Separator separator;
+
+      output.seekg(position - int64_t(sizeof(Separator)), std::fstream::beg);
+      output.read(reinterpret_cast<char *>(&separator), sizeof(Separator));
+
+      separator.previous -= offset;
+
+      output.seekp(position - int64_t(sizeof(Separator)), std::fstream::beg);
+      output.write(reinterpret_cast<char const *>(&separator), sizeof(Separator));
+
+      position = separator.previous;
+    }
+
+    assert(position == base);
+
+    output.seekp(0, std::fstream::beg);
+    output.write(reinterpret_cast<char const *>(&updated), sizeof(Header));
+    output.close();
+
+    if (!output || !core::SyncFile(filename.c_str()))
+    {
+      throw StorageException("Unable to write truncated variant stack file");
+    }
+  }
+
+  /**
+   * Calculate the equivalent of a marker after the stack has been truncated
+   *
+   * @param: mark The marker to be translated
+   * @param: truncation The marker that was passed to TruncateBelow
+   *
+   * @return: The translated marker
+   */
+  static Header Rebase(Header const &mark, Header const &truncation)
+  {
+    assert(mark.end >= truncation.end);
+
+    int64_t const base = int64_t{sizeof(Header) + sizeof(Separator)};
+
+    return Header{mark.object_count - truncation.object_count, mark.end - truncation.end + base};
+  }
+
   /**
    * Reset the state of the file handle to starting conditions. This consists of a header and a
    * separator (it is convenient to have a starting invalid separator).
@@ -277,6 +429,7 @@ public:
     FETCH_UNUSED(lazy);
 
     WriteHeader();
+    file_handle_.flush();
   }
 
 protected:
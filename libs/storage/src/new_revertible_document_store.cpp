@@ -168,5 +168,25 @@ void NewRevertibleDocumentStore::Reset()
   storage_.New(state_path_, state_history_path_, index_path_, index_history_path_);
 }
 
+void NewRevertibleDocumentStore::SetSnapshotPolicy(uint64_t interval, uint64_t max_snapshots)
+{
+  storage_.SetSnapshotPolicy(interval, max_snapshots);
+}
+
+void NewRevertibleDocumentStore::SetCacheSize(std::size_t max_bytes)
+{
+  storage_.SetCacheSize(max_bytes);
+}
+
+void NewRevertibleDocumentStore::SetHashVersion(FileObjectHashVersion version)
+{
+  storage_.SetHashVersion(version);
+}
+
+FileObjectHashVersion NewRevertibleDocumentStore::hash_version()
+{
+  return storage_.hash_version();
+}
+
 }  // namespace storage
 }  // namespace fetch
@@ -18,6 +18,7 @@
 
 #include "core/random/lcg.hpp"
 #include "crypto/hash.hpp"
+#include "crypto/merkle_tree.hpp"
 #include "crypto/sha256.hpp"
 #include "mock_file_object.hpp"
 #include "storage/storage_exception.hpp"
@@ -302,3 +303,106 @@ TEST_F(FileObjectTests, HashFiles)
 
   ASSERT_EQ(file_object_->Hash(), crypto::Hash<crypto::SHA256>(new_string));
 }
+
+namespace {
+
+ConstByteArray ChunkedHashReference(std::string const &contents)
+{
+  using BlockType = FileBlockType<>;
+
+  std::size_t const num_blocks = (contents.size() + BlockType::CAPACITY - 1) / BlockType::CAPACITY;
+
+  crypto::MerkleTree tree{num_blocks};
+  for (std::size_t i = 0; i < num_blocks; ++i)
+  {
+    tree[i] = crypto::Hash<crypto::SHA256>(contents.substr(i * BlockType::CAPACITY,
+                                                           std::size_t{BlockType::CAPACITY}));
+  }
+  tree.CalculateRoot();
+
+  ByteArray length;
+  length.Resize(sizeof(uint64_t));
+  for (std::size_t i = 0; i < sizeof(uint64_t); ++i)
+  {
+    length[i] = static_cast<uint8_t>(uint64_t{contents.size()} >> (8u * i));
+  }
+
+  return crypto::Hash<crypto::SHA256>(length + tree.root());
+}
+
+}  // namespace
+
+TEST_F(FileObjectTests, ChunkedHashFiles)
+{
+  using BlockType = FileBlockType<>;
+
+  file_object_->New("test");
+  file_object_->SetHashVersion(FileObjectHashVersion::CHUNKED_MERKLE);
+
+  std::vector<std::string> strings_to_set{"", "1", std::string(BlockType::CAPACITY, 'a'),
+                                          std::string(BlockType::CAPACITY + 1, 'b')};
+  for (std::size_t i = 0; i < 20; ++i)
+  {
+    strings_to_set.push_back(GetStringForTesting());
+  }
+
+  for (auto const &string_to_set : strings_to_set)
+  {
+    file_object_->CreateNewFile(string_to_set.size());
+    file_object_->Write(string_to_set);
+
+    ASSERT_EQ(file_object_->Hash(), ChunkedHashReference(string_to_set));
+  }
+}
+
+TEST_F(FileObjectTests, ChunkedHashFilesAfterRewrites)
+{
+  file_object_->New("test");
+  file_object_->SetHashVersion(FileObjectHashVersion::CHUNKED_MERKLE);
+
+  std::vector<std::pair<uint64_t, std::string>> files;
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    files.emplace_back(0, GetStringForTesting());
+
+    file_object_->CreateNewFile(files.back().second.size());
+    file_object_->Write(files.back().second);
+    files.back().first = file_object_->id();
+
+    ASSERT_EQ(file_object_->Hash(), ChunkedHashReference(files.back().second));
+  }
+
+  for (std::size_t round = 0; round < 50; ++round)
+  {
+    auto &file = files[rng_() % files.size()];
+
+    // either modify a few bytes in place, as is typical of a state update, or change the size
+    if ((round % 3) == 0)
+    {
+      file.second = GetStringForTesting();
+    }
+    else
+    {
+      for (std::size_t i = 0; i < 3; ++i)
+      {
+        file.second[rng_() % file.second.size()] = NewChar();
+      }
+    }
+
+    file_object_->SeekFile(file.first);
+    file_object_->Resize(file.second.size());
+    file_object_->Write(file.second);
+
+    ASSERT_EQ(file_object_->Hash(), ChunkedHashReference(file.second));
+    ASSERT_EQ(std::string{file_object_->AsDocument().document}, file.second);
+  }
+
+  // rehashing every file from scratch gives the same result as the cached block digests
+  for (auto const &file : files)
+  {
+    file_object_->UpdateVariables();
+    file_object_->SeekFile(file.first);
+
+    ASSERT_EQ(file_object_->Hash(), ChunkedHashReference(file.second));
+  }
+}
@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "storage/hash_table_index.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace fetch::storage;
+
+using Index = HashTableIndex<uint64_t>;
+using Keys  = std::vector<Index::KeyType>;
+
+Keys GenerateKeys(std::size_t count)
+{
+  Keys keys;
+  keys.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    keys.emplace_back(fetch::crypto::Hash<fetch::crypto::SHA256>(std::to_string(i)));
+  }
+
+  return keys;
+}
+
+TEST(HashTableIndexTests, SetGetAndErase)
+{
+  Index index;
+  index.New("hash_table_index_test.db");
+
+  auto const keys = GenerateKeys(100);
+
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    index.Set(keys[i], i);
+  }
+
+  EXPECT_EQ(index.size(), keys.size());
+
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    uint64_t value{0};
+    ASSERT_TRUE(index.Get(keys[i], value));
+    EXPECT_EQ(value, i);
+  }
+
+  // updating an existing key should not create a new entry
+  index.Set(keys[0], 1000);
+
+  uint64_t value{0};
+  ASSERT_TRUE(index.Get(keys[0], value));
+  EXPECT_EQ(value, 1000);
+  EXPECT_EQ(index.size(), keys.size());
+
+  // remove every other key
+  for (std::size_t i = 0; i < keys.size(); i += 2)
+  {
+    EXPECT_TRUE(index.Erase(keys[i]));
+  }
+
+  EXPECT_FALSE(index.Erase(keys[0]));
+  EXPECT_EQ(index.size(), keys.size() / 2);
+
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    EXPECT_EQ(index.Has(keys[i]), (i % 2) == 1);
+  }
+}
+
+TEST(HashTableIndexTests, GrowsBeyondInitialCapacity)
+{
+  Index index;
+  index.New("hash_table_index_test.db");
+
+  auto const keys = GenerateKeys(Index::INITIAL_CAPACITY * 2);
+
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    index.Set(keys[i], i);
+  }
+
+  EXPECT_EQ(index.size(), keys.size());
+  EXPECT_GE(index.capacity(), keys.size() * 2);
+
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    uint64_t value{0};
+    ASSERT_TRUE(index.Get(keys[i], value));
+    EXPECT_EQ(value, i);
+  }
+}
+
+TEST(HashTableIndexTests, PersistsAcrossLoads)
+{
+  auto const keys = GenerateKeys(50);
+
+  {
+    Index index;
+    index.New("hash_table_index_test.db");
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+      index.Set(keys[i], i);
+    }
+
+    index.Erase(keys[10]);
+    index.Flush(false);
+  }
+
+  Index index;
+  index.Load("hash_table_index_test.db");
+
+  EXPECT_EQ(index.size(), keys.size() - 1);
+  EXPECT_FALSE(index.Has(keys[10]));
+
+  uint64_t value{0};
+  ASSERT_TRUE(index.Get(keys[42], value));
+  EXPECT_EQ(value, 42);
+}
+
+}  // namespace
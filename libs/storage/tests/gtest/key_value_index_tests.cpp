@@ -336,6 +336,57 @@ TEST_F(KeyValueIndexTests, double_insertion_hash_consistency)
   ASSERT_TRUE(size1 == size2);
 }
 
+TEST_F(KeyValueIndexTests, deferred_vs_direct_update_hash_consistency)
+{
+  std::vector<TestData> values;
+  for (std::size_t i = 0; i < 20000; ++i)
+  {
+    byte_array::ByteArray key;
+    key.Resize(256 / 8);
+    for (std::size_t j = 0; j < key.size(); ++j)
+    {
+      key[j] = uint8_t(rng() >> 9u);
+    }
+
+    if (reference.find(key) != reference.end())
+    {
+      continue;
+    }
+
+    reference[key] = rng();
+    values.push_back({key, reference[key]});
+  }
+
+  // the cached index updates the parents in batches when flushing, while the uncached index
+  // updates them as each key is set
+  cached_kv_index.New("test1.db");
+  kv_index.New("test2.db");
+
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    auto const &val = values[i];
+    cached_kv_index.Set(val.key, val.value, val.key);
+    kv_index.Set(val.key, val.value, val.key);
+
+    if ((i % 7919) == 0)
+    {
+      ASSERT_EQ(kv_index.Hash(), cached_kv_index.Hash());
+    }
+  }
+
+  ASSERT_EQ(kv_index.Hash(), cached_kv_index.Hash());
+
+  // overwrite a subset of the leaves, which only modifies existing nodes
+  for (std::size_t i = 0; i < values.size(); i += 3)
+  {
+    auto const &val = values[i];
+    cached_kv_index.Set(val.key, val.value + 1, values[(i + 1) % values.size()].key);
+    kv_index.Set(val.key, val.value + 1, values[(i + 1) % values.size()].key);
+  }
+
+  ASSERT_EQ(kv_index.Hash(), cached_kv_index.Hash());
+}
+
 TEST_F(KeyValueIndexTests, batched_vs_bulk_load_save_consistency)
 {
   std::vector<TestData> values;
@@ -0,0 +1,213 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/random/lfg.hpp"
+#include "storage/page_cached_random_access_stack.hpp"
+#include "storage/random_access_stack.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace fetch::storage;
+
+struct TestClass
+{
+  uint64_t value1 = 0;
+  uint8_t  value2 = 0;
+
+  bool operator==(TestClass const &rhs) const
+  {
+    return value1 == rhs.value1 && value2 == rhs.value2;
+  }
+};
+
+using Stack     = PageCachedRandomAccessStack<TestClass>;
+using Reference = std::vector<TestClass>;
+
+constexpr std::size_t PAGE_BYTES = Stack::ELEMENTS_PER_PAGE * sizeof(TestClass);
+
+TestClass Random(fetch::random::LaggedFibonacciGenerator<> &lfg)
+{
+  uint64_t const random = lfg();
+
+  TestClass value;
+  value.value1 = random;
+  value.value2 = static_cast<uint8_t>(random & 0xFF);
+
+  return value;
+}
+
+void ExpectMatches(Stack const &stack, Reference const &reference)
+{
+  ASSERT_EQ(reference.size(), stack.size());
+
+  for (std::size_t i = 0; i < reference.size(); ++i)
+  {
+    TestClass value;
+    stack.Get(i, value);
+    ASSERT_EQ(reference[i], value) << "Mismatch at index " << i;
+  }
+}
+
+class PageCachedRandomAccessStackTests : public ::testing::TestWithParam<std::size_t>
+{
+protected:
+  fetch::random::LaggedFibonacciGenerator<> lfg_;
+};
+
+TEST_P(PageCachedRandomAccessStackTests, CheckRandomOperationsMatchReference)
+{
+  constexpr std::size_t NUM_ELEMENTS = 20000;
+
+  Reference reference;
+
+  {
+    Stack stack;
+    stack.SetMemoryLimit(GetParam());
+    stack.New("page_cached_stack_test.db");
+    stack.SetExtraHeader(0x00deadbeefcafe00);
+
+    for (std::size_t i = 0; i < NUM_ELEMENTS; ++i)
+    {
+      reference.push_back(Random(lfg_));
+      EXPECT_EQ(i, stack.Push(reference.back()));
+    }
+
+    ExpectMatches(stack, reference);
+
+    for (std::size_t round = 0; round < 4; ++round)
+    {
+      for (std::size_t i = 0; i < 1000; ++i)
+      {
+        std::size_t const index = lfg_() % reference.size();
+        reference[index]        = Random(lfg_);
+        stack.Set(index, reference[index]);
+      }
+
+      for (std::size_t i = 0; i < 100; ++i)
+      {
+        std::size_t const a = lfg_() % reference.size();
+        std::size_t const b = lfg_() % reference.size();
+        std::swap(reference[a], reference[b]);
+        stack.Swap(a, b);
+      }
+
+      // shrink and partially regrow the stack across a number of pages
+      for (std::size_t i = 0; i < 3000; ++i)
+      {
+        ASSERT_EQ(reference.back(), stack.Top());
+        reference.pop_back();
+        stack.Pop();
+      }
+
+      for (std::size_t i = 0; i < 1000; ++i)
+      {
+        reference.push_back(Random(lfg_));
+        stack.Push(reference.back());
+      }
+
+      ExpectMatches(stack, reference);
+
+      stack.Flush();
+      ExpectMatches(stack, reference);
+    }
+  }
+
+  // the contents are written back when the stack is destroyed
+  Stack stack;
+  stack.SetMemoryLimit(GetParam());
+  stack.Load("page_cached_stack_test.db");
+
+  EXPECT_EQ(0x00deadbeefcafe00, stack.header_extra());
+  ExpectMatches(stack, reference);
+}
+
+INSTANTIATE_TEST_CASE_P(MemoryLimits, PageCachedRandomAccessStackTests,
+                        ::testing::Values<std::size_t>(0, PAGE_BYTES, 4 * PAGE_BYTES,
+                                                       1024 * PAGE_BYTES), );
+
+TEST(PageCachedRandomAccessStackTest, CheckResidentSetIsBounded)
+{
+  constexpr std::size_t MAX_PAGES = 4;
+
+  fetch::random::LaggedFibonacciGenerator<> lfg;
+
+  Stack stack;
+  stack.SetMemoryLimit(MAX_PAGES * PAGE_BYTES);
+  stack.New("page_cached_stack_test.db");
+
+  // the modified pages are retained until the next flush
+  for (std::size_t i = 0; i < 10 * Stack::ELEMENTS_PER_PAGE; ++i)
+  {
+    stack.Push(Random(lfg));
+  }
+
+  EXPECT_EQ(10, stack.resident_pages());
+
+  stack.Flush();
+  EXPECT_EQ(MAX_PAGES, stack.resident_pages());
+
+  // reading never grows the resident set past the limit
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    TestClass value;
+    stack.Get(lfg() % stack.size(), value);
+
+    EXPECT_GE(MAX_PAGES, stack.resident_pages());
+  }
+}
+
+TEST(PageCachedRandomAccessStackTest, CheckFileIsOnlyUpdatedOnFlush)
+{
+  fetch::random::LaggedFibonacciGenerator<> lfg;
+
+  Stack stack;
+  stack.New("page_cached_stack_test.db");
+
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    stack.Push(Random(lfg));
+  }
+  stack.SetExtraHeader(42);
+
+  {
+    RandomAccessStack<TestClass> file;
+    file.Load("page_cached_stack_test.db");
+
+    EXPECT_EQ(0, file.size());
+    EXPECT_EQ(0, file.header_extra());
+  }
+
+  stack.Flush();
+
+  {
+    RandomAccessStack<TestClass> file;
+    file.Load("page_cached_stack_test.db");
+
+    EXPECT_EQ(100, file.size());
+    EXPECT_EQ(42, file.header_extra());
+  }
+}
+
+}  // namespace
@@ -307,3 +307,81 @@ TEST(variant_stack, file_writing_and_recovery)
     }
   }
 }
+
+TEST(variant_stack, revert_and_truncate_to_marks)
+{
+  constexpr uint64_t testSize = 300;
+
+  VariantStack stack;
+  stack.New("VS_test_3.db");
+
+  VariantStack::Header lower_mark{};
+  VariantStack::Header upper_mark{};
+
+  for (uint64_t i = 0; i < testSize; ++i)
+  {
+    if (i == 100)
+    {
+      lower_mark = stack.Mark();
+    }
+
+    if (i == 200)
+    {
+      upper_mark = stack.Mark();
+    }
+
+    if ((i % 2) == 0)
+    {
+      stack.Push(i, 0);
+    }
+    else
+    {
+      stack.Push(uint8_t(i & 0xFF), 1);
+    }
+  }
+
+  // discard everything above the upper mark
+  stack.RevertTo(upper_mark);
+  ASSERT_EQ(stack.size(), 200);
+
+  // discard everything below the lower mark, rebasing the remaining marker
+  stack.TruncateBelow(lower_mark);
+  ASSERT_EQ(stack.size(), 100);
+
+  VariantStack::Header const middle = VariantStack::Rebase(upper_mark, lower_mark);
+  EXPECT_EQ(middle.object_count, stack.Mark().object_count);
+  EXPECT_EQ(middle.end, stack.Mark().end);
+
+  auto const check_contents = [](VariantStack &s) {
+    for (uint64_t i = 199; i >= 100; --i)
+    {
+      ASSERT_EQ(s.Type(), i % 2);
+
+      if ((i % 2) == 0)
+      {
+        uint64_t value = 0;
+        s.Top(value);
+        ASSERT_EQ(value, i);
+      }
+      else
+      {
+        uint8_t value = 0;
+        s.Top(value);
+        ASSERT_EQ(value, uint8_t(i & 0xFF));
+      }
+
+      s.Pop();
+    }
+
+    ASSERT_TRUE(s.empty());
+  };
+
+  // the truncated file must be valid when reloaded
+  stack.Close();
+
+  VariantStack reloaded;
+  reloaded.Load("VS_test_3.db");
+  ASSERT_EQ(reloaded.size(), 100);
+
+  check_contents(reloaded);
+}
@@ -388,6 +388,91 @@ TEST(new_revertible_store_test, commit_and_erase)
 }
 
 // note: disabled because the storage does not hash the same way as the merkle tree
+TEST(new_revertible_store_test, chunked_hashes_are_consistent_after_revert)
+{
+  LinearCongruentialGenerator rng;
+
+  NewRevertibleDocumentStore store;
+  store.New("a_16.db", "b_16.db", "c_16.db", "d_16.db", true);
+  store.SetHashVersion(FileObjectHashVersion::CHUNKED_MERKLE);
+
+  // documents spanning several blocks
+  std::map<std::string, std::string> documents;
+  for (std::size_t i = 0; i < 20; ++i)
+  {
+    std::string contents;
+    for (std::size_t j = 0; j < 10; ++j)
+    {
+      contents += GetStringForTesting(rng);
+    }
+
+    documents[std::to_string(i)] = contents;
+    store.Set(storage::ResourceAddress(std::to_string(i)), contents);
+  }
+
+  auto const committed_hash = store.Commit();
+  auto const committed      = documents;
+
+  // small modifications which only touch a single block of each document
+  auto const modify = [&rng, &store](std::map<std::string, std::string> &state) {
+    for (auto &document : state)
+    {
+      if (!document.second.empty())
+      {
+        document.second[rng() % document.second.size()] = NewChar(rng);
+        store.Set(storage::ResourceAddress(document.first), document.second);
+      }
+    }
+  };
+
+  modify(documents);
+  EXPECT_NE(committed_hash, store.CurrentHash());
+
+  ASSERT_TRUE(store.RevertToHash(committed_hash));
+  EXPECT_EQ(committed_hash, store.CurrentHash());
+
+  // modifying other blocks after the revert must not reuse the digests of the reverted blocks
+  documents = committed;
+  modify(documents);
+
+  // a store built from scratch agrees on the final state
+  NewRevertibleDocumentStore reference;
+  reference.New("a_17.db", "b_17.db", "c_17.db", "d_17.db", true);
+  reference.SetHashVersion(FileObjectHashVersion::CHUNKED_MERKLE);
+
+  for (auto const &document : documents)
+  {
+    reference.Set(storage::ResourceAddress(document.first), document.second);
+  }
+
+  EXPECT_EQ(reference.CurrentHash(), store.CurrentHash());
+}
+
+TEST(new_revertible_store_test, hash_version_is_restored_by_load_and_revert)
+{
+  ByteArray before_switch;
+
+  {
+    NewRevertibleDocumentStore store;
+    store.New("a_18.db", "b_18.db", "c_18.db", "d_18.db", true);
+    EXPECT_EQ(store.hash_version(), FileObjectHashVersion::SHA256_CONTENTS);
+
+    store.Set(storage::ResourceAddress("before"), "before");
+    before_switch = store.Commit();
+
+    store.SetHashVersion(FileObjectHashVersion::CHUNKED_MERKLE);
+    store.Set(storage::ResourceAddress("after"), "after");
+    store.Commit();
+  }
+
+  NewRevertibleDocumentStore store;
+  store.Load("a_18.db", "b_18.db", "c_18.db", "d_18.db", false);
+  EXPECT_EQ(store.hash_version(), FileObjectHashVersion::CHUNKED_MERKLE);
+
+  ASSERT_TRUE(store.RevertToHash(before_switch));
+  EXPECT_EQ(store.hash_version(), FileObjectHashVersion::SHA256_CONTENTS);
+}
+
 TEST(new_revertible_store_test, DISABLED_hashing_correct_basic)
 {
   NewRevertibleDocumentStore store;
@@ -26,6 +26,8 @@
 #include "gtest/gtest.h"
 
 #include <cstddef>
+#include <cstdio>
+#include <fstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -39,6 +41,24 @@ using namespace fetch::testing;
 
 using ByteArray = fetch::byte_array::ByteArray;
 
+bool FileExists(std::string const &filename)
+{
+  return std::ifstream(filename).good();
+}
+
+std::size_t FileSize(std::string const &filename)
+{
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  return static_cast<std::size_t>(file.tellg());
+}
+
+void CopyFile(std::string const &from, std::string const &to)
+{
+  std::ifstream input(from, std::ios::binary);
+  std::ofstream output(to, std::ios::binary | std::ios::trunc);
+  output << input.rdbuf();
+}
+
 TEST(versioned_random_access_stack_gtest, basic_example_of_commit_revert2)
 {
   NewVersionedRandomAccessStack<StringProxy> stack;
@@ -139,6 +159,193 @@ TEST(versioned_random_access_stack_gtest, try_to_revert_to_bad_hash)
 
   // Revert to bad hash
   ASSERT_THROW(stack.RevertToHash(DefaultKey(hashes[1])), StorageException);
+
+  // The failed revert should have left the stack untouched
+  for (std::size_t i = 0; i < 17; ++i)
+  {
+    EXPECT_EQ(stack.Get(i), StringProxy(std::to_string(i)));
+  }
+  EXPECT_TRUE(stack.HashExists(DefaultKey(hashes[0])));
+}
+
+TEST(versioned_random_access_stack_gtest, hash_index_tracks_reverts_and_reloads)
+{
+  std::vector<ByteArray> hashes;
+
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    hashes.push_back(Hash<crypto::SHA256>(std::to_string(i)));
+  }
+
+  {
+    NewVersionedRandomAccessStack<StringProxy> stack;
+    stack.New("d_main.db", "d_history.db");
+
+    for (std::size_t i = 0; i < hashes.size(); ++i)
+    {
+      stack.Push(StringProxy(std::to_string(i)));
+      stack.Commit(DefaultKey(hashes[i]));
+    }
+
+    // commit a duplicate of an earlier hash, reverting past it must not lose the original
+    stack.Commit(DefaultKey(hashes[2]));
+
+    stack.RevertToHash(DefaultKey(hashes[5]));
+
+    EXPECT_EQ(stack.size(), 6);
+    for (std::size_t i = 0; i < hashes.size(); ++i)
+    {
+      EXPECT_EQ(stack.HashExists(DefaultKey(hashes[i])), i <= 5);
+    }
+
+    stack.Flush(false);
+  }
+
+  // the index should be available after reloading the files
+  {
+    NewVersionedRandomAccessStack<StringProxy> stack;
+    stack.Load("d_main.db", "d_history.db");
+
+    for (std::size_t i = 0; i < hashes.size(); ++i)
+    {
+      EXPECT_EQ(stack.HashExists(DefaultKey(hashes[i])), i <= 5);
+    }
+  }
+
+  // and it should be rebuilt from the history if it is missing
+  std::remove("hash_index_d_history.db");
+
+  {
+    NewVersionedRandomAccessStack<StringProxy> stack;
+    stack.Load("d_main.db", "d_history.db");
+
+    for (std::size_t i = 0; i < hashes.size(); ++i)
+    {
+      EXPECT_EQ(stack.HashExists(DefaultKey(hashes[i])), i <= 5);
+    }
+
+    stack.RevertToHash(DefaultKey(hashes[1]));
+    EXPECT_EQ(stack.size(), 2);
+  }
+}
+
+TEST(versioned_random_access_stack_gtest, snapshots_restore_and_bound_history)
+{
+  constexpr std::size_t NUM_COMMITS  = 40;
+  constexpr std::size_t NUM_ELEMENTS = 4;
+
+  std::vector<ByteArray>                hashes;
+  std::vector<std::vector<StringProxy>> states;
+
+  for (std::size_t i = 0; i < NUM_COMMITS; ++i)
+  {
+    hashes.push_back(Hash<crypto::SHA256>("snapshot" + std::to_string(i)));
+  }
+
+  auto const check_state = [&](NewVersionedRandomAccessStack<StringProxy> &stack,
+                               std::size_t                                 index) {
+    ASSERT_EQ(stack.size(), NUM_ELEMENTS);
+
+    for (std::size_t j = 0; j < NUM_ELEMENTS; ++j)
+    {
+      EXPECT_EQ(stack.Get(j), states[index][j]);
+    }
+  };
+
+  {
+    NewVersionedRandomAccessStack<StringProxy> stack;
+    stack.New("s_main.db", "s_history.db");
+    stack.SetSnapshotPolicy(5, 3);
+
+    for (std::size_t j = 0; j < NUM_ELEMENTS; ++j)
+    {
+      stack.Push(StringProxy{});
+    }
+
+    // make plenty of changes per commit so that the history outgrows the stack
+    for (std::size_t i = 0; i < NUM_COMMITS; ++i)
+    {
+      for (std::size_t k = 0; k < 20; ++k)
+      {
+        stack.Set(k % NUM_ELEMENTS, StringProxy(std::to_string(i) + ":" + std::to_string(k)));
+      }
+
+      stack.Commit(DefaultKey(hashes[i]));
+
+      states.emplace_back();
+      for (std::size_t j = 0; j < NUM_ELEMENTS; ++j)
+      {
+        states.back().push_back(stack.Get(j));
+      }
+    }
+
+    // snapshots were taken after commits 4, 9, ..., 39 but only the last three retained
+    EXPECT_EQ(stack.num_snapshots(), 3);
+
+    for (std::size_t i = 0; i < NUM_COMMITS; ++i)
+    {
+      EXPECT_EQ(stack.HashExists(DefaultKey(hashes[i])), i >= 29);
+    }
+
+    EXPECT_THROW(stack.RevertToHash(DefaultKey(hashes[28])), StorageException);
+    check_state(stack, 39);
+
+    // the discarded bookmarks have been removed from the hash history file
+    EXPECT_LT(FileSize("hash_history_s_history.db"), (NUM_COMMITS / 2) * sizeof(DefaultKey));
+
+    // reverting past the snapshot at 34 uses it, and discards the later snapshot
+    stack.RevertToHash(DefaultKey(hashes[31]));
+    check_state(stack, 31);
+    EXPECT_EQ(stack.num_snapshots(), 1);
+
+    for (std::size_t i = 0; i < NUM_COMMITS; ++i)
+    {
+      EXPECT_EQ(stack.HashExists(DefaultKey(hashes[i])), (i >= 29) && (i <= 31));
+    }
+
+    stack.Flush(false);
+  }
+
+  {
+    NewVersionedRandomAccessStack<StringProxy> stack;
+    stack.Load("s_main.db", "s_history.db");
+
+    check_state(stack, 31);
+
+    // the oldest retained bookmark can still be reverted to
+    stack.RevertToHash(DefaultKey(hashes[29]));
+    check_state(stack, 29);
+  }
+
+  // a discard interrupted before its journal was written is rolled back
+  CopyFile("s_history.db", "s_history.db.truncate");
+  std::ofstream("hash_history_s_history.db.truncate") << "partial";
+
+  {
+    NewVersionedRandomAccessStack<StringProxy> stack;
+    stack.Load("s_main.db", "s_history.db");
+
+    EXPECT_FALSE(FileExists("s_history.db.truncate"));
+    EXPECT_FALSE(FileExists("hash_history_s_history.db.truncate"));
+    check_state(stack, 29);
+    EXPECT_TRUE(stack.HashExists(DefaultKey(hashes[29])));
+  }
+
+  // a journalled discard is rolled forward, removing the discarded snapshots
+  CopyFile("s_history.db", "s_history.db.truncate");
+  std::ofstream("s_main.db.snapshot.4") << "discarded";
+  std::ofstream("s_history.db.discard") << "4\n";
+
+  {
+    NewVersionedRandomAccessStack<StringProxy> stack;
+    stack.Load("s_main.db", "s_history.db");
+
+    EXPECT_FALSE(FileExists("s_history.db.truncate"));
+    EXPECT_FALSE(FileExists("s_history.db.discard"));
+    EXPECT_FALSE(FileExists("s_main.db.snapshot.4"));
+    check_state(stack, 29);
+    EXPECT_TRUE(stack.HashExists(DefaultKey(hashes[29])));
+  }
 }
 
 TEST(versioned_random_access_stack_gtest, loading_file)
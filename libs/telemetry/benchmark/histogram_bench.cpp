@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "telemetry/histogram.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <mutex>
+
+using fetch::telemetry::Histogram;
+
+namespace {
+
+constexpr int NUM_THREADS = 32;
+
+std::initializer_list<double> const BUCKETS = {0.000001, 0.00001, 0.0001, 0.001, 0.01,
+                                               0.1,      1,       10.,    100.};
+
+/**
+ * The previous (mutex and bucket map) histogram implementation, used as the baseline
+ */
+class LockedHistogram
+{
+public:
+  explicit LockedHistogram(std::initializer_list<double> const &buckets)
+  {
+    for (auto const &bucket : buckets)
+    {
+      buckets_.emplace(bucket, 0u);
+    }
+  }
+
+  void Add(double const &value)
+  {
+    FETCH_LOCK(lock_);
+
+    for (auto it = buckets_.lower_bound(value), end = buckets_.end(); it != end; ++it)
+    {
+      ++(it->second);
+    }
+
+    ++count_;
+    sum_ += value;
+  }
+
+private:
+  std::mutex                 lock_;
+  std::map<double, uint64_t> buckets_;
+  uint64_t                   count_{0};
+  double                     sum_{0.0};
+};
+
+/**
+ * Record values into a single histogram shared between all the benchmark threads
+ */
+template <typename HistogramType>
+void Histogram_Add(benchmark::State &state, HistogramType &histogram)
+{
+  double value = 0.00000123 * static_cast<double>(state.thread_index + 1);
+
+  for (auto _ : state)
+  {
+    histogram.Add(value);
+
+    // walk the values through the buckets
+    value *= 2.0;
+    if (value > 1000.0)
+    {
+      value = 0.00000123;
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+void Histogram_Add_Locked(benchmark::State &state)
+{
+  static LockedHistogram histogram{BUCKETS};
+  Histogram_Add(state, histogram);
+}
+
+void Histogram_Add_Striped(benchmark::State &state)
+{
+  static Histogram histogram{BUCKETS, "benchmark_histogram", "Benchmark histogram"};
+  Histogram_Add(state, histogram);
+}
+
+}  // namespace
+
+BENCHMARK(Histogram_Add_Locked)->Threads(1)->Threads(NUM_THREADS)->UseRealTime();
+BENCHMARK(Histogram_Add_Striped)->Threads(1)->Threads(NUM_THREADS)->UseRealTime();
@@ -19,16 +19,27 @@
 
 #include "telemetry/measurement.hpp"
 
-#include <functional>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <initializer_list>
-#include <map>
-#include <mutex>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace fetch {
 namespace telemetry {
 
+/**
+ * Histogram of observed values.
+ *
+ * Recording a value is lock free. The counters are striped across a fixed number of stripes, and
+ * each thread is assigned its own stripe, so that concurrent recording threads do not contend on
+ * the same counters. Every stripe starts on a cache line of its own and is padded to a whole number
+ * of cache lines, so that threads recording to different stripes never share a line. Each value
+ * is counted only in the (single) bucket which contains it, the cumulative bucket counts are
+ * computed when the histogram is streamed.
+ */
 class Histogram : public Measurement
 {
 public:
@@ -56,17 +67,30 @@ public:
   Histogram &operator=(Histogram &&) = delete;
 
 private:
-  using Mutex     = std::mutex;
-  using BucketMap = std::map<double, uint64_t>;
+  using Bounds  = std::vector<double>;
+  using Counter = std::atomic<uint64_t>;
+  using Sum     = std::atomic<double>;
+  using Storage = std::unique_ptr<uint8_t[]>;
+
+  static constexpr std::size_t NUM_STRIPES     = 16;
+  static constexpr std::size_t CACHE_LINE_SIZE = 64;
 
   template <typename Iterator>
   Histogram(Iterator const &begin, Iterator const &end, std::string const &name,
             std::string const &description, Labels const &labels = Labels{});
 
-  mutable Mutex lock_;
-  BucketMap     buckets_;
-  uint64_t      count_{0};
-  double        sum_{0.0};
+  static std::size_t StripeIndex();
+
+  /// @name Stripe Access
+  /// @{
+  Sum &    StripeSum(std::size_t stripe) const;
+  Counter *StripeBuckets(std::size_t stripe) const;
+  /// @}
+
+  Bounds      bounds_;            ///< The (sorted) upper bounds of the buckets
+  std::size_t stripe_size_{0};    ///< The size in bytes of a stripe, a multiple of the cache line
+  Storage     storage_;           ///< The memory backing the stripes
+  uint8_t *   stripes_{nullptr};  ///< The first stripe, aligned to a cache line
 };
 
 }  // namespace telemetry
@@ -16,9 +16,10 @@
 //
 //------------------------------------------------------------------------------
 
-#include "core/mutex.hpp"
 #include "telemetry/histogram.hpp"
 
+#include <algorithm>
+#include <new>
 #include <ostream>
 
 namespace fetch {
@@ -64,13 +65,37 @@ template <typename Iterator>
 Histogram::Histogram(Iterator const &begin, Iterator const &end, std::string const &name,
                      std::string const &description, Labels const &labels)
   : Measurement{name, description, labels}
+  , bounds_(begin, end)
 {
-  FETCH_LOCK(lock_);
+  // build up the bucket bounds
+  std::sort(bounds_.begin(), bounds_.end());
+  bounds_.erase(std::unique(bounds_.begin(), bounds_.end()), bounds_.end());
 
-  // build up the initial bucket values
-  for (auto it = begin; it != end; ++it)
+  static_assert(alignof(Counter) <= alignof(Sum), "Counters must follow the sum in a stripe");
+
+  // each stripe holds the sum followed by the counters, with an additional bucket for the values
+  // over the last bound, rounded up to a whole number of cache lines
+  std::size_t const num_buckets  = bounds_.size() + 1;
+  std::size_t const stripe_bytes = sizeof(Sum) + (num_buckets * sizeof(Counter));
+  stripe_size_ = ((stripe_bytes + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE) * CACHE_LINE_SIZE;
+
+  // the allocation is not aligned to a cache line so the first stripe is moved to the next one
+  std::size_t const total_size = NUM_STRIPES * stripe_size_;
+  std::size_t       space      = total_size + CACHE_LINE_SIZE;
+  storage_                     = std::make_unique<uint8_t[]>(space);
+
+  void *base = storage_.get();
+  stripes_   = static_cast<uint8_t *>(std::align(CACHE_LINE_SIZE, total_size, base, space));
+
+  for (std::size_t i = 0; i < NUM_STRIPES; ++i)
   {
-    buckets_.emplace(*it, 0u);
+    new (&StripeSum(i)) Sum{0.0};
+
+    Counter *buckets = StripeBuckets(i);
+    for (std::size_t j = 0; j < num_buckets; ++j)
+    {
+      new (buckets + j) Counter{0};
+    }
   }
 }
 
@@ -81,17 +106,19 @@ Histogram::Histogram(Iterator const &begin, Iterator const &end, std::string con
  */
 void Histogram::Add(double const &value)
 {
-  FETCH_LOCK(lock_);
+  std::size_t const stripe = StripeIndex();
+
+  // update the bucket containing the value
+  auto const bucket = static_cast<std::size_t>(
+      std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin());
+  StripeBuckets(stripe)[bucket].fetch_add(1, std::memory_order_relaxed);
 
-  // update all of the buckets
-  for (auto it = buckets_.lower_bound(value), end = buckets_.end(); it != end; ++it)
+  // update the aggregate, contention here is only between threads sharing the stripe
+  auto & stripe_sum = StripeSum(stripe);
+  double sum        = stripe_sum.load(std::memory_order_relaxed);
+  while (!stripe_sum.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed))
   {
-    ++(it->second);
   }
-
-  // update the aggregates
-  ++count_;
-  sum_ += value;
 }
 
 /**
@@ -102,18 +129,71 @@ void Histogram::Add(double const &value)
  */
 void Histogram::ToStream(OutputStream &stream) const
 {
-  FETCH_LOCK(lock_);
+  // combine the stripes
+  std::vector<uint64_t> counts(bounds_.size() + 1, 0);
+  double                sum{0.0};
+  for (std::size_t stripe = 0; stripe < NUM_STRIPES; ++stripe)
+  {
+    Counter const *buckets = StripeBuckets(stripe);
+    for (std::size_t i = 0; i < counts.size(); ++i)
+    {
+      counts[i] += buckets[i].load(std::memory_order_relaxed);
+    }
+
+    sum += StripeSum(stripe).load(std::memory_order_relaxed);
+  }
 
   WriteHeader(stream, "histogram");
-  for (auto const &element : buckets_)
+
+  uint64_t count{0};
+  for (std::size_t i = 0; i < bounds_.size(); ++i)
   {
-    WriteValuePrefix(stream, "bucket", {{"le", std::to_string(element.first)}})
-        << element.second << '\n';
+    count += counts[i];
+
+    WriteValuePrefix(stream, "bucket", {{"le", std::to_string(bounds_[i])}}) << count << '\n';
   }
-  WriteValuePrefix(stream, "bucket", {{"le", "+Inf"}}) << count_ << '\n';
+  count += counts.back();
+
+  WriteValuePrefix(stream, "bucket", {{"le", "+Inf"}}) << count << '\n';
+
+  WriteValuePrefix(stream, "sum") << sum << '\n';
+  WriteValuePrefix(stream, "count") << count << '\n';
+}
+
+/**
+ * Internal: Determine the stripe used by the calling thread. Threads are assigned to the stripes
+ * in a round robin fashion the first time they record a value.
+ *
+ * @return The index of the stripe
+ */
+std::size_t Histogram::StripeIndex()
+{
+  static std::atomic<std::size_t> next_stripe{0};
+  thread_local std::size_t const  stripe = next_stripe.fetch_add(1) % NUM_STRIPES;
+
+  return stripe;
+}
+
+/**
+ * Internal: Get the sum of the values recorded in a stripe
+ *
+ * @param stripe The index of the stripe
+ * @return The sum, at the start of the stripe
+ */
+Histogram::Sum &Histogram::StripeSum(std::size_t stripe) const
+{
+  return *reinterpret_cast<Sum *>(stripes_ + (stripe * stripe_size_));
+}
 
-  WriteValuePrefix(stream, "sum") << sum_ << '\n';
-  WriteValuePrefix(stream, "count") << count_ << '\n';
+/**
+ * Internal: Get the bucket counters of a stripe
+ *
+ * @param stripe The index of the stripe
+ * @return The first of the counters, which follow the sum
+ */
+Histogram::Counter *Histogram::StripeBuckets(std::size_t stripe) const
+{
+  return reinterpret_cast<Counter *>(stripes_ + (stripe * stripe_size_) + sizeof(Sum));
 }
 
 }  // namespace telemetry
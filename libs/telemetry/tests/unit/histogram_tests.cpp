@@ -20,8 +20,11 @@
 
 #include "gtest/gtest.h"
 
+#include <cstddef>
 #include <memory>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 namespace {
 
@@ -75,4 +78,44 @@ request_time_count 7
   EXPECT_EQ(oss.str(), std::string{EXPECTED_TEXT});
 }
 
+TEST_F(HistogramTests, ConcurrentCheck)
+{
+  static constexpr std::size_t NUM_THREADS = 8;
+  static constexpr std::size_t NUM_VALUES  = 1000;
+
+  // each of the threads adds values into the first and last buckets
+  std::vector<std::thread> threads{};
+  for (std::size_t i = 0; i < NUM_THREADS; ++i)
+  {
+    threads.emplace_back([this]() {
+      for (std::size_t j = 0; j < NUM_VALUES; ++j)
+      {
+        histogram_->Add(0.125);
+        histogram_->Add(1.0);
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  std::ostringstream oss;
+  OutputStream       stream{oss};
+  histogram_->ToStream(stream);
+
+  static char const *EXPECTED_TEXT = R"(# HELP request_time Test Metric
+# TYPE request_time histogram
+request_time_bucket{le="0.200000"} 8000
+request_time_bucket{le="0.400000"} 8000
+request_time_bucket{le="0.600000"} 8000
+request_time_bucket{le="0.800000"} 8000
+request_time_bucket{le="+Inf"} 16000
+request_time_sum 9000
+request_time_count 16000
+)";
+  EXPECT_EQ(oss.str(), std::string{EXPECTED_TEXT});
+}
+
 }  // namespace
@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/compiler.hpp"
+#include "vm/ir.hpp"
+#include "vm/module.hpp"
+#include "vm/vm.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using fetch::vm::Compiler;
+using fetch::vm::Executable;
+using fetch::vm::IR;
+using fetch::vm::Module;
+using fetch::vm::SourceFiles;
+using fetch::vm::Variant;
+using fetch::vm::VM;
+
+namespace {
+
+char const *LOOP_SOURCE = R"(
+  function main() : Int32
+    var total = 0;
+    for (i in 0:10000)
+      if (i % 3 == 0)
+        continue;
+      endif
+      total += 1;
+    endfor
+    return total;
+  endfunction
+)";
+
+char const *ARITHMETIC_SOURCE = R"(
+  function main() : Int64
+    var a = 1i64;
+    var b = 2i64;
+    var c = 3i64;
+    for (i in 0:10000)
+      a = (a * 3i64 + b) % 1000003i64;
+      b = (b + c * a - 7i64) % 1000033i64;
+      c = (c + a) - (b % 255i64) - (a / 3i64);
+    endfor
+    return a + b + c;
+  endfunction
+)";
+
+char const *CALL_SOURCE = R"(
+  function fib(n : Int32) : Int32
+    if (n < 2)
+      return n;
+    endif
+    return fib(n - 1) + fib(n - 2);
+  endfunction
+
+  function main() : Int32
+    return fib(18);
+  endfunction
+)";
+
+/**
+ * Run the `main` function of the specified source with an optional charge limit
+ *
+ * Arguments: charge limit (0 for unlimited)
+ */
+void RunProgram(benchmark::State &state, char const *source)
+{
+  auto module = std::make_shared<Module>();
+
+  Compiler                 compiler{module.get()};
+  IR                       ir{};
+  std::vector<std::string> errors{};
+  if (!compiler.Compile(SourceFiles{{"bench.etch", source}}, "default_ir", ir, errors))
+  {
+    state.SkipWithError("Unable to compile benchmark source");
+    return;
+  }
+
+  VM         vm{module.get()};
+  Executable executable{};
+  if (!vm.GenerateExecutable(ir, "default_exe", executable, errors))
+  {
+    state.SkipWithError("Unable to generate benchmark executable");
+    return;
+  }
+
+  auto const charge_limit = static_cast<fetch::vm::ChargeAmount>(state.range(0));
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    vm.Reset();
+    vm.SetChargeLimit(charge_limit);
+    state.ResumeTiming();
+
+    std::string error{};
+    Variant     output{};
+    if (!vm.Execute(executable, "main", error, output))
+    {
+      state.SkipWithError(error.c_str());
+      break;
+    }
+  }
+}
+
+void VM_LoopHeavy(benchmark::State &state)
+{
+  RunProgram(state, LOOP_SOURCE);
+}
+
+void VM_ArithmeticHeavy(benchmark::State &state)
+{
+  RunProgram(state, ARITHMETIC_SOURCE);
+}
+
+void VM_CallHeavy(benchmark::State &state)
+{
+  RunProgram(state, CALL_SOURCE);
+}
+
+}  // namespace
+
+BENCHMARK(VM_LoopHeavy)->Arg(0)->Arg(100000000);
+BENCHMARK(VM_ArithmeticHeavy)->Arg(0)->Arg(100000000);
+BENCHMARK(VM_CallHeavy)->Arg(0)->Arg(100000000);
@@ -20,6 +20,7 @@
 #include "vm/ir.hpp"
 #include "vm/variant.hpp"
 
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <string>
@@ -185,6 +186,7 @@ struct Executable
   using FunctionArray = std::vector<Function>;
 
   std::string              name;
+  uint64_t                 id{GenerateId()};  ///< Unique for each generated executable
   std::vector<std::string> strings;
   std::vector<Variant>     constants;
   TypeInfoArray            types;
@@ -215,6 +217,12 @@ struct Executable
     }
     return nullptr;
   }
+
+  static uint64_t GenerateId()
+  {
+    static std::atomic<uint64_t> next_id{1};
+    return next_id++;
+  }
 };
 
 class Generator
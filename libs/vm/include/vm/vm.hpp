@@ -245,6 +245,12 @@ public:
   bool GenerateExecutable(IR const &ir, std::string const &name, Executable &executable,
                           std::vector<std::string> &errors);
 
+  /**
+   * Reset the per execution state (observer, devices, charges) so that the instance can be reused
+   * for a new execution. The prepared constants of the last executable are retained.
+   */
+  void Reset();
+
   template <typename... Ts>
   bool Execute(Executable const &executable, std::string const &name, std::string &error,
                Variant &output, Ts const &... parameters)
@@ -480,19 +486,24 @@ public:
     return constructor(this, type_id);
   }
 
+  using DirectHandler = void (*)(VM *);
+
   struct OpcodeInfo
   {
     OpcodeInfo() = default;
 
-    OpcodeInfo(std::string name__, Handler handler__, ChargeAmount charge)
+    OpcodeInfo(std::string name__, Handler handler__, ChargeAmount charge,
+               DirectHandler direct_handler__ = nullptr)
       : name(std::move(name__))
       , handler(std::move(handler__))
       , static_charge{charge}
+      , direct_handler{direct_handler__}
     {}
 
-    std::string  name;
-    Handler      handler;
-    ChargeAmount static_charge{};
+    std::string   name;
+    Handler       handler;
+    ChargeAmount  static_charge{};
+    DirectHandler direct_handler{nullptr};  ///< Set when the handler is a plain function
   };
 
   ChargeAmount GetChargeTotal() const;
@@ -511,6 +522,24 @@ private:
   using OpcodeInfoArray = std::vector<OpcodeInfo>;
   using OpcodeMap       = std::unordered_map<std::string, uint16_t>;
 
+  /**
+   * An instruction of a function which has been pre-decoded for execution. The instructions are
+   * grouped into basic blocks, which end at any instruction that can transfer control or which can
+   * apply dynamic charges.
+   */
+  struct DecodedInstruction
+  {
+    DirectHandler  direct_handler{nullptr};
+    Handler const *handler{nullptr};
+    ChargeAmount   static_charge{0};
+    ChargeAmount   block_charge{0};  ///< Static charge from here to the end of the block
+    bool           block_end{false};
+    bool           unknown{false};
+  };
+
+  using DecodedInstructionArray = std::vector<DecodedInstruction>;
+  using DecodedFunctionArray    = std::vector<DecodedInstructionArray>;
+
   struct Frame
   {
     Executable::Function const *function;
@@ -555,6 +584,9 @@ private:
   Executable const *             executable_{};
   Executable::Function const *   function_{};
   std::vector<Ptr<String>>       strings_;
+  uint64_t                       prepared_executable_id_{};
+  std::size_t                    num_prepared_types_{};
+  DecodedFunctionArray           decoded_functions_;
   Frame                          frame_stack_[FRAME_STACK_SIZE]{};
   int                            frame_sp_{};
   int                            bsp_{};
@@ -574,7 +606,6 @@ private:
   OutputDeviceMap                output_devices_;
   InputDeviceMap                 input_devices_;
   DeserializeConstructorMap      deserialization_constructors_;
-  OpcodeInfo *                   current_op_{nullptr};
 
   /// @name Charges
   /// @{
@@ -582,13 +613,37 @@ private:
   ChargeAmount charge_total_{0};
   /// @}
 
-  void AddOpcodeInfo(uint16_t opcode, std::string name, Handler handler,
+  template <typename H>
+  void AddOpcodeInfo(uint16_t opcode, std::string name, H &&handler,
                      ChargeAmount static_charge = 1)
   {
-    opcode_info_array_[opcode] = OpcodeInfo(std::move(name), std::move(handler), static_charge);
+    // capture-less handlers can additionally be invoked directly, avoiding the indirection of the
+    // std::function
+    DirectHandler const direct_handler =
+        ToDirectHandler(handler, std::is_convertible<std::decay_t<H>, DirectHandler>{});
+
+    opcode_info_array_[opcode] =
+        OpcodeInfo(std::move(name), std::forward<H>(handler), static_charge, direct_handler);
+  }
+
+  template <typename H>
+  static DirectHandler ToDirectHandler(H const &handler, std::true_type /*convertible*/)
+  {
+    return handler;
+  }
+
+  template <typename H>
+  static DirectHandler ToDirectHandler(H const & /*handler*/, std::false_type /*convertible*/)
+  {
+    return nullptr;
   }
 
   bool Execute(std::string &error, Variant &output);
+  void ExecuteBlock(DecodedInstruction const *code);
+  void ExecuteMeteredBlock(DecodedInstruction const *code);
+  void PrepareExecutable();
+  void ReleaseExecutable();
+  void DecodeFunction(Executable::Function const &function, DecodedInstructionArray &code) const;
   void Destruct(uint16_t scope_number);
 
   TypeId FindType(std::string const &name) const
@@ -23,6 +23,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 namespace fetch {
 namespace vm {
@@ -186,25 +187,14 @@ VM::VM(Module *module)
 bool VM::GenerateExecutable(IR const &ir, std::string const &name, Executable &executable,
                             std::vector<std::string> &errors)
 {
+  ReleaseExecutable();
+
   return generator_.GenerateExecutable(ir, name, executable, errors);
 }
 
 bool VM::Execute(std::string &error, Variant &output)
 {
-  std::size_t const num_strings = executable_->strings.size();
-  strings_                      = std::vector<Ptr<String>>(num_strings);
-  for (std::size_t i = 0; i < num_strings; ++i)
-  {
-    std::string const &str = executable_->strings[i];
-    strings_[i]            = Ptr<String>(new String(this, str, true));
-  }
-
-  std::size_t const num_local_types = executable_->types.size();
-  for (std::size_t i = 0; i < num_local_types; ++i)
-  {
-    TypeInfo const &type_info = executable_->types[i];
-    type_info_array_.push_back(type_info);
-  }
+  PrepareExecutable();
 
   frame_sp_       = -1;
   bsp_            = 0;
@@ -220,47 +210,26 @@ bool VM::Execute(std::string &error, Variant &output)
 
   do
   {
-    instruction_pc_ = pc_;
-    instruction_    = &function_->instructions[pc_++];
-
-    current_op_ = &opcode_info_array_[instruction_->opcode];
-
-    assert(instruction_->opcode < opcode_info_array_.size());
-
-    if (!current_op_->handler)
+    auto const function_index = static_cast<std::size_t>(function_ - &executable_->functions[0]);
+    DecodedInstruction const *code = decoded_functions_[function_index].data();
+
+    // when the static charge of the entire block fits within the charge limit, the limit does not
+    // need to be checked for each of the instructions
+    ChargeAmount const block_charge = code[pc_].block_charge;
+    if ((charge_limit_ == 0u) ||
+        ((charge_total_ < charge_limit_) && (block_charge < (charge_limit_ - charge_total_))))
     {
-      RuntimeError("unknown opcode");
-      break;
+      ExecuteBlock(code);
     }
-
-    assert(static_cast<bool>(current_op_->handler));
-
-    // update the charge total
-    charge_total_ += current_op_->static_charge;
-
-    // check for charge limit being reached
-    if ((charge_limit_ != 0u) && (charge_total_ >= charge_limit_))
+    else
     {
-      RuntimeError("Charge limit exceeded");
-      break;
+      ExecuteMeteredBlock(code);
     }
 
-    // execute the handler for the op code
-    current_op_->handler(this);
-
   } while (!stop_);
 
   bool const ok = !HasError();
 
-  // Remove the executable's strings
-  strings_.clear();
-
-  // Remove the executable's local types
-  for (std::size_t i = 0; i < num_local_types; ++i)
-  {
-    type_info_array_.pop_back();
-  }
-
   if (ok)
   {
     if (sp_ == 0)
@@ -283,6 +252,255 @@ bool VM::Execute(std::string &error, Variant &output)
   return false;
 }
 
+void VM::Reset()
+{
+  io_observer_ = nullptr;
+  output_devices_.clear();
+  input_devices_.clear();
+  output_buffer_.str(std::string{});
+  output_buffer_.clear();
+  error_.clear();
+  charge_limit_ = std::numeric_limits<ChargeAmount>::max();
+  charge_total_ = 0;
+}
+
+/**
+ * Ensure the string constants, local types and decoded functions of the current executable are
+ * loaded. These are retained between executions, so that repeated calls into the same executable
+ * do not need to recreate them.
+ */
+void VM::PrepareExecutable()
+{
+  if (executable_->id != prepared_executable_id_)
+  {
+    ReleaseExecutable();
+
+    strings_.reserve(executable_->strings.size());
+    for (std::string const &str : executable_->strings)
+    {
+      strings_.emplace_back(new String(this, str, true));
+    }
+
+    for (TypeInfo const &type_info : executable_->types)
+    {
+      type_info_array_.push_back(type_info);
+    }
+
+    decoded_functions_.resize(executable_->functions.size());
+    for (std::size_t i = 0; i < executable_->functions.size(); ++i)
+    {
+      DecodeFunction(executable_->functions[i], decoded_functions_[i]);
+    }
+
+    prepared_executable_id_ = executable_->id;
+    num_prepared_types_     = executable_->types.size();
+
+    return;
+  }
+
+  // string objects are mutable, so any constant which has been modified or which is still
+  // referenced from a previous execution must be recreated
+  for (std::size_t i = 0; i < strings_.size(); ++i)
+  {
+    Ptr<String> &      constant = strings_[i];
+    std::string const &str      = executable_->strings[i];
+
+    if ((constant.RefCount() != 1) || (constant->str != str))
+    {
+      constant = Ptr<String>(new String(this, str, true));
+    }
+  }
+}
+
+/**
+ * Remove the string constants, local types and decoded functions of the previously prepared
+ * executable
+ */
+void VM::ReleaseExecutable()
+{
+  strings_.clear();
+  decoded_functions_.clear();
+
+  for (std::size_t i = 0; i < num_prepared_types_; ++i)
+  {
+    type_info_array_.pop_back();
+  }
+
+  prepared_executable_id_ = 0;
+  num_prepared_types_     = 0;
+}
+
+/**
+ * Decode the instructions of a function for execution, resolving the handler and static charge of
+ * each instruction and dividing the instructions into basic blocks
+ *
+ * @param function The function to be decoded
+ * @param code The decoded instructions to be populated
+ */
+void VM::DecodeFunction(Executable::Function const &function, DecodedInstructionArray &code) const
+{
+  std::size_t const num_instructions = function.instructions.size();
+
+  code.assign(num_instructions, DecodedInstruction{});
+
+  // the targets of jumps must always begin a block
+  std::vector<bool> block_starts(num_instructions + 1, false);
+
+  for (std::size_t i = 0; i < num_instructions; ++i)
+  {
+    Executable::Instruction const &instruction = function.instructions[i];
+    DecodedInstruction &           decoded     = code[i];
+
+    if ((instruction.opcode < opcode_info_array_.size()) &&
+        opcode_info_array_[instruction.opcode].handler)
+    {
+      OpcodeInfo const &info = opcode_info_array_[instruction.opcode];
+
+      decoded.direct_handler = info.direct_handler;
+      decoded.handler        = &info.handler;
+      decoded.static_charge  = info.static_charge;
+    }
+    else
+    {
+      decoded.direct_handler = [](VM *vm) { vm->RuntimeError("unknown opcode"); };
+      decoded.unknown        = true;
+    }
+
+    switch (instruction.opcode)
+    {
+    case Opcodes::Break:
+    case Opcodes::Continue:
+    case Opcodes::Jump:
+    case Opcodes::JumpIfFalse:
+    case Opcodes::JumpIfTrue:
+    case Opcodes::JumpIfFalseOrPop:
+    case Opcodes::JumpIfTrueOrPop:
+    case Opcodes::ForRangeIterate:
+      block_starts[std::min<std::size_t>(instruction.index, num_instructions)] = true;
+      decoded.block_end = true;
+      break;
+    case Opcodes::Return:
+    case Opcodes::ReturnValue:
+    case Opcodes::InvokeUserDefinedFreeFunction:
+      decoded.block_end = true;
+      break;
+    default:
+      // module functions can apply dynamic charges, which must be observed before the following
+      // instruction is charged
+      decoded.block_end = decoded.unknown || (instruction.opcode >= Opcodes::NumReserved);
+      break;
+    }
+  }
+
+  // accumulate the static charges of each block from its end
+  ChargeAmount block_charge{0};
+  for (std::size_t i = num_instructions; i > 0; --i)
+  {
+    DecodedInstruction &decoded = code[i - 1];
+
+    if (block_starts[i])
+    {
+      decoded.block_end = true;
+    }
+
+    if (decoded.block_end)
+    {
+      block_charge = 0;
+    }
+
+    block_charge += decoded.static_charge;
+    decoded.block_charge = block_charge;
+  }
+}
+
+/**
+ * Execute a block of instructions whose static charge is known to be within the charge limit. The
+ * static charge of the block is applied up front, any part of it which is not executed because of
+ * an error is refunded so that the charge total remains exact.
+ *
+ * @param code The decoded instructions of the current function
+ */
+void VM::ExecuteBlock(DecodedInstruction const *code)
+{
+  charge_total_ += code[pc_].block_charge;
+
+  for (;;)
+  {
+    instruction_pc_ = pc_;
+    instruction_    = &function_->instructions[pc_];
+
+    DecodedInstruction const &decoded = code[pc_++];
+
+    // execute the handler for the op code
+    if (decoded.direct_handler != nullptr)
+    {
+      decoded.direct_handler(this);
+    }
+    else
+    {
+      (*decoded.handler)(this);
+    }
+
+    if (stop_)
+    {
+      charge_total_ -= decoded.block_charge - decoded.static_charge;
+      break;
+    }
+
+    if (decoded.block_end)
+    {
+      break;
+    }
+  }
+}
+
+/**
+ * Execute a block of instructions checking the charge limit before each instruction
+ *
+ * @param code The decoded instructions of the current function
+ */
+void VM::ExecuteMeteredBlock(DecodedInstruction const *code)
+{
+  for (;;)
+  {
+    instruction_pc_ = pc_;
+    instruction_    = &function_->instructions[pc_];
+
+    DecodedInstruction const &decoded = code[pc_++];
+
+    if (decoded.unknown)
+    {
+      RuntimeError("unknown opcode");
+      break;
+    }
+
+    // update the charge total
+    charge_total_ += decoded.static_charge;
+
+    // check for charge limit being reached
+    if ((charge_limit_ != 0u) && (charge_total_ >= charge_limit_))
+    {
+      RuntimeError("Charge limit exceeded");
+      break;
+    }
+
+    // execute the handler for the op code
+    if (decoded.direct_handler != nullptr)
+    {
+      decoded.direct_handler(this);
+    }
+    else
+    {
+      (*decoded.handler)(this);
+    }
+
+    if (stop_ || decoded.block_end)
+    {
+      break;
+    }
+  }
+}
+
 void VM::RuntimeError(std::string const &message)
 {
   uint16_t const    line = function_->FindLineNumber(instruction_pc_);
@@ -343,6 +561,9 @@ void VM::UpdateCharges(std::unordered_map<std::string, ChargeAmount> const &opco
       opcode_to_update->static_charge = entry.second;
     }
   }
+
+  // the decoded instructions contain the previous static charges
+  ReleaseExecutable();
 }
 
 }  // namespace vm
@@ -499,4 +499,48 @@ TEST_F(VmChargeTests,
   ASSERT_TRUE(toolkit.Run(nullptr, high_charge_limit));
 }
 
+TEST_F(VmChargeTests, charge_limit_is_enforced_at_every_point_across_basic_blocks)
+{
+  static char const *TEXT = R"(
+    function add(a : Int32, b : Int32) : Int32
+      return a + b;
+    endfunction
+
+    function main()
+      var total = 0i32;
+      for (i in 0i32:8i32)
+        if (i % 2i32 == 0i32)
+          total = add(total, i);
+        else
+          total = total - 1i32;
+        endif
+      endfor
+    endfunction
+  )";
+
+  // establish the total static charge of the program without a limit
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+  ASSERT_TRUE(toolkit.Run());
+  ChargeAmount const total_charge = toolkit.charge_total();
+  ASSERT_GT(total_charge, 0u);
+
+  // the limit falls in every possible position within the blocks of the program, execution must
+  // only succeed when the whole charge fits and must then be charged exactly the same amount
+  for (ChargeAmount limit = 1; limit <= total_charge + 1; ++limit)
+  {
+    ASSERT_TRUE(toolkit.Compile(TEXT));
+
+    if (limit > total_charge)
+    {
+      EXPECT_TRUE(toolkit.Run(nullptr, limit)) << "limit: " << limit;
+      EXPECT_EQ(total_charge, toolkit.charge_total());
+    }
+    else
+    {
+      EXPECT_FALSE(toolkit.Run(nullptr, limit)) << "limit: " << limit;
+      EXPECT_LE(limit, toolkit.charge_total());
+    }
+  }
+}
+
 }  // namespace
@@ -141,6 +141,11 @@ public:
     return *observer_;
   }
 
+  ChargeAmount charge_total() const
+  {
+    return vm_->GetChargeTotal();
+  }
+
 private:
   std::ostream *stdout_ = &std::cout;
   ObserverPtr   observer_;